@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/arena.hpp"
+#include "../src/feedback.hpp"
+
+namespace {
+    constexpr size_t TABLE_BYTES = wordle::config::NUM_WORDS * wordle::feedback::FLAT_STRIDE;  // As large as the matrix
+    constexpr size_t GATHERS = 1 << 16;
+
+    // Random row offsets, as filter() and baseEntropy() read one column across many rows
+    const std::vector<uint32_t>& gatherOffsets() {
+        static const std::vector<uint32_t> offsets = [] {
+            std::mt19937 rng{42};
+            std::uniform_int_distribution<size_t> row(0, wordle::config::NUM_WORDS - 1);
+            std::vector<uint32_t> result(GATHERS);
+            for (auto& offset : result) offset = static_cast<uint32_t>(row(rng) * wordle::feedback::FLAT_STRIDE + 17);
+            return result;
+        }();
+        return offsets;
+    }
+}
+
+// Random single-byte reads across a matrix-sized table, by page policy (0 off, 1 transparent, 2 hugetlbfs)
+static void BM_ArenaGather(benchmark::State& state) {
+    wordle::util::arena::setPolicy(static_cast<wordle::util::arena::Policy>(state.range(0)));
+    wordle::feedback::FlatFeedbackMap table(TABLE_BYTES, 1);
+    wordle::util::arena::setPolicy(wordle::util::arena::Policy::TRANSPARENT);
+    const auto& offsets = gatherOffsets();
+
+    uint64_t sum = 0;
+    for (auto _ : state) {
+        for (uint32_t offset : offsets) sum += table[offset];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * GATHERS);
+    state.SetLabel(wordle::util::arena::toString(wordle::util::arena::backingOf(table.data())));
+    state.counters["huge_mb"] = static_cast<double>(wordle::util::arena::hugePageBytes(table.data(), table.size())) / (1024.0 * 1024.0);
+}
+
+BENCHMARK(BM_ArenaGather)->DenseRange(0, 2);
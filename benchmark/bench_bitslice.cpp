@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "../src/bitSlice.hpp"
+#include "../src/engineContext.hpp"
+
+namespace {
+    // Random sorted subset of targets, like an alive set late in a game
+    std::vector<wordle::histogram::WordIndex> aliveSubset(size_t size) {
+        std::vector<wordle::histogram::WordIndex> targets(wordle::config::NUM_TARGETS);
+        std::iota(targets.begin(), targets.end(), 0);
+        std::shuffle(targets.begin(), targets.end(), std::mt19937{42});
+        targets.resize(size);
+        std::sort(targets.begin(), targets.end());
+        return targets;
+    }
+}
+
+// Histogram of every guess over state.range(0) alive targets, one gather per target
+static void BM_CountGather(benchmark::State& state) {
+    const auto context = wordle::engine::Context::shared();
+    const auto& fMap = context->view();
+    const auto targets = aliveSubset(state.range(0));
+    wordle::entropy::SparseHistogram histogram;
+
+    for (auto _ : state) {
+        for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+            const auto* nextRow = guessIndex + 1 < wordle::config::NUM_WORDS ? fMap.row(guessIndex + 1) : nullptr;
+            histogram.count(fMap.row(guessIndex), targets.cbegin(), targets.cend(), nextRow);
+            benchmark::DoNotOptimize(histogram.touchedBins());
+        }
+    }
+}
+
+// Same histograms by splitting the alive bitset against each guess's planes
+static void BM_CountBitSliced(benchmark::State& state) {
+    const auto context = wordle::engine::Context::shared();
+    const auto& fMap = context->view();
+    const auto& planes = context->planes();
+    const auto targets = aliveSubset(state.range(0));
+    wordle::bitslice::AliveSet alive;
+    alive.assign(targets.cbegin(), targets.cend());
+    wordle::entropy::SparseHistogram histogram;
+
+    for (auto _ : state) {
+        for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+            wordle::bitslice::countBins(planes, guessIndex, fMap.row(guessIndex), alive, histogram);
+            benchmark::DoNotOptimize(histogram.touchedBins());
+        }
+    }
+}
+
+BENCHMARK(BM_CountGather)->Arg(2315)->Arg(512)->Arg(128)->Arg(32)->Arg(8)->Arg(3)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CountBitSliced)->Arg(2315)->Arg(512)->Arg(128)->Arg(32)->Arg(8)->Arg(3)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <set>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/easyBot.hpp"
+#include "../src/hardBot.hpp"
+
+/*
+Per-request costs of the bots (suggest, filter, tryFilter) on fixed game states, by phase of the game.
+
+The states are recorded once per bot type: the bot plays NUM_GAMES games (solutions spread over the targets) and each
+phase replays the guesses that led to it. Every run borrows the process-wide engine context, so only the bot's own
+state is built per run. Iterations cycle through the games of a phase, with the replay excluded from the timing.
+
+Export and compare (see tools/compareBenchmarks.py):
+    benchmarks --benchmark_filter=BotGame --benchmark_out=bots.json --benchmark_out_format=json
+*/
+namespace {
+    using History = std::vector<std::pair<size_t, wordle::feedback::Encoding>>;  // Guesses and the feedbacks they got
+
+    enum Phase : int64_t { OPENING = 0, TURN_2, TURN_3, ENDGAME };  // ENDGAME is the state before the winning guess
+    constexpr std::array<std::string_view, 4> PHASE_NAMES{"opening", "turn2", "turn3", "endgame"};
+    constexpr size_t NUM_GAMES = 8;
+    constexpr size_t MAX_GUESSES = 20;
+
+    // Full games of Bot with the standard width, every entry filtered except the last (winning) guess
+    template <typename Bot>
+    const std::vector<History>& recordedGames() {
+        static const std::vector<History> games = [] {
+            Bot bot{wordle::engine::Context::shared()};
+            bot.useSuggestionCache(std::make_shared<wordle::cache::SuggestionCache>());  // Openings are searched once
+
+            std::vector<History> result;
+            for (size_t game = 0; game < NUM_GAMES; ++game) {
+                const size_t solutionIndex = game * wordle::config::NUM_TARGETS / NUM_GAMES;
+                History history;
+                bot.reset();
+                while (history.size() < MAX_GUESSES) {
+                    const auto suggestion = bot.suggest();
+                    const auto fbEncoding = bot.getFMap()[solutionIndex][suggestion.guessIndex];
+                    history.emplace_back(suggestion.guessIndex, fbEncoding);
+                    if (suggestion.guessIndex == solutionIndex) break;
+                    bot.filter(suggestion.guessIndex, fbEncoding);
+                }
+                result.push_back(std::move(history));
+            }
+            return result;
+        }();
+        return games;
+    }
+
+    // Number of guesses each recorded game has filtered when it reaches phase (games won earlier are left out)
+    template <typename Bot>
+    std::vector<std::pair<const History*, size_t>> statesAt(Phase phase) {
+        std::vector<std::pair<const History*, size_t>> states;
+        for (const auto& game : recordedGames<Bot>()) {
+            const size_t numFiltered = phase == ENDGAME ? game.size() - 1 : static_cast<size_t>(phase);
+            if (numFiltered < game.size()) states.emplace_back(&game, numFiltered);
+        }
+        return states;
+    }
+
+    // Bot with state.range(1) threads and state.range(2) beam candidates
+    template <typename Bot>
+    class BotGame : public benchmark::Fixture {
+    protected:
+        std::unique_ptr<Bot> bot;
+        std::vector<std::pair<const History*, size_t>> states;
+        size_t next = 0;
+
+        // Puts the bot in the next state of the phase, returning its game and number of guesses filtered
+        const std::pair<const History*, size_t>& replayNext() {
+            const auto& state = states[next++ % states.size()];
+            bot->reset();
+            for (size_t i = 0; i < state.second; ++i) bot->filter((*state.first)[i].first, (*state.first)[i].second);
+            return state;
+        }
+
+    public:
+        void SetUp(const benchmark::State& state) override {
+            const auto phase = static_cast<Phase>(state.range(0));
+            const auto threads = static_cast<size_t>(state.range(1));
+            const auto beam = static_cast<size_t>(state.range(2));
+            states = statesAt<Bot>(phase);
+            bot = std::make_unique<Bot>(wordle::engine::Context::shared(), threads, beam);
+            next = 0;
+        }
+
+        void TearDown(const benchmark::State&) override {
+            bot.reset();
+        }
+
+        void suggest(benchmark::State& state) {
+            double aliveTargets = 0;
+            for (auto _ : state) {
+                state.PauseTiming();
+                replayNext();
+                aliveTargets += static_cast<double>(bot->getAliveTargets().size());
+                state.ResumeTiming();
+
+                benchmark::DoNotOptimize(bot->suggest());
+            }
+            finish(state, aliveTargets);
+        }
+
+        // Times the guess played in each state, as filter() or as tryFilter() from its strings
+        template <bool FromStrings>
+        void filter(benchmark::State& state) {
+            double aliveTargets = 0;
+            for (auto _ : state) {
+                state.PauseTiming();
+                const auto& [game, numFiltered] = replayNext();
+                const auto [guessIndex, fbEncoding] = (*game)[numFiltered];
+                aliveTargets += static_cast<double>(bot->getAliveTargets().size());
+                state.ResumeTiming();
+
+                if constexpr (FromStrings) {
+                    const auto fbString = wordle::feedback::decodeFeedbackString(fbEncoding);
+                    benchmark::DoNotOptimize(bot->tryFilter(bot->getVocab()[guessIndex], fbString));
+                } else {
+                    bot->filter(guessIndex, fbEncoding);
+                }
+            }
+            finish(state, aliveTargets);
+        }
+
+        void finish(benchmark::State& state, double aliveTargets) const {
+            state.SetLabel(std::string{PHASE_NAMES[state.range(0)]});
+            state.counters["alive"] = aliveTargets / static_cast<double>(std::max<benchmark::IterationCount>(1, state.iterations()));
+            state.counters["states"] = static_cast<double>(states.size());
+        }
+    };
+
+    // Every phase with each thread count and beam width (deduplicated), or a beam as wide as the threads when none given
+    void phaseArgs(benchmark::internal::Benchmark* b, const std::set<int64_t>& threads, const std::set<int64_t>& beams = {}) {
+        b->ArgNames({"phase", "threads", "beam"});
+        for (int64_t phase = OPENING; phase <= ENDGAME; ++phase) {
+            for (int64_t numThreads : threads) {
+                if (beams.empty()) b->Args({phase, numThreads, numThreads});
+                for (int64_t beam : beams) b->Args({phase, numThreads, beam});
+            }
+        }
+    }
+
+    constexpr auto HC = static_cast<int64_t>(wordle::config::HARDWARE_CONCURRENCY);
+
+    void hardSuggestArgs(benchmark::internal::Benchmark* b) { phaseArgs(b, {1, HC}, {1, 4, HC}); }
+
+    void easySuggestArgs(benchmark::internal::Benchmark* b) { phaseArgs(b, {1, 4, HC}, {4, HC}); }
+
+    void filterArgs(benchmark::internal::Benchmark* b) { phaseArgs(b, {1, HC}); }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BotGame, HardSuggest, wordle::bot::HardBot)(benchmark::State& state) { suggest(state); }
+BENCHMARK_TEMPLATE_DEFINE_F(BotGame, HardFilter, wordle::bot::HardBot)(benchmark::State& state) { filter<false>(state); }
+BENCHMARK_TEMPLATE_DEFINE_F(BotGame, HardTryFilter, wordle::bot::HardBot)(benchmark::State& state) { filter<true>(state); }
+BENCHMARK_TEMPLATE_DEFINE_F(BotGame, EasySuggest, wordle::bot::EasyBot)(benchmark::State& state) { suggest(state); }
+BENCHMARK_TEMPLATE_DEFINE_F(BotGame, EasyFilter, wordle::bot::EasyBot)(benchmark::State& state) { filter<false>(state); }
+BENCHMARK_TEMPLATE_DEFINE_F(BotGame, EasyTryFilter, wordle::bot::EasyBot)(benchmark::State& state) { filter<true>(state); }
+
+BENCHMARK_REGISTER_F(BotGame, HardSuggest)->Apply(hardSuggestArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_REGISTER_F(BotGame, HardFilter)->Apply(filterArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_REGISTER_F(BotGame, HardTryFilter)->Apply(filterArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_REGISTER_F(BotGame, EasySuggest)->Apply(easySuggestArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_REGISTER_F(BotGame, EasyFilter)->Apply(filterArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_REGISTER_F(BotGame, EasyTryFilter)->Apply(filterArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
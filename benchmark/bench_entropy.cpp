@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include "../src/entropy.hpp"
+#include "../src/feedbackCache.hpp"
+
+namespace {
+    const wordle::feedback::FeedbackMatrix& benchMatrix() {
+        static const auto vocab = wordle::vocab::constructVocab();
+        static wordle::parallel::TaskQueue queue{wordle::config::HARDWARE_CONCURRENCY};
+        static const auto matrix = wordle::feedback::cache::loadFeedbackMatrix(vocab, queue);
+        return matrix;
+    }
+
+    // Sorted random subset of targets, like one bin of the second pass
+    std::vector<wordle::histogram::WordIndex> binSubset(size_t size) {
+        std::vector<wordle::histogram::WordIndex> targets(wordle::config::NUM_TARGETS);
+        std::iota(targets.begin(), targets.end(), 0);
+        std::shuffle(targets.begin(), targets.end(), std::mt19937{42});
+        targets.resize(size);
+        std::sort(targets.begin(), targets.end());
+        return targets;
+    }
+}
+
+// Best entropy of any guess over state.range(0) targets with the per-bin log2 loop
+static void BM_BinEntropyLog2(benchmark::State& state) {
+    const auto fMap = benchMatrix().view();
+    const auto targets = binSubset(state.range(0));
+    wordle::histogram::BinCounts binCounts{};
+
+    for (auto _ : state) {
+        double best = std::numeric_limits<double>::min();
+        for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+            wordle::histogram::countBins(fMap.row(guessIndex), targets.data(), targets.size(), binCounts);
+            double entropy = 0;
+            for (double count : binCounts) {
+                if (!count) continue;
+                double prob = count / targets.size();
+                entropy -= prob * std::log2(prob);
+            }
+            best = std::max(best, entropy);
+        }
+        benchmark::DoNotOptimize(best);
+    }
+}
+
+// Same maximum through SparseHistogram and the fixed-point EntropyMaximizer
+static void BM_BinEntropyTable(benchmark::State& state) {
+    const auto fMap = benchMatrix().view();
+    const auto targets = binSubset(state.range(0));
+    wordle::entropy::SparseHistogram histogram;
+
+    for (auto _ : state) {
+        wordle::entropy::EntropyMaximizer best{targets.size()};
+        for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+            histogram.count(fMap.row(guessIndex), targets.cbegin(), targets.cend());
+            best.consider(histogram);
+        }
+        benchmark::DoNotOptimize(best.value());
+    }
+}
+
+BENCHMARK(BM_BinEntropyLog2)->Arg(8)->Arg(32)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BinEntropyTable)->Arg(8)->Arg(32)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
@@ -1,9 +1,44 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdio>
+
 #include "../src/feedback.hpp"
+#include "../src/feedbackCache.hpp"
 
 static inline const auto vocab{wordle::vocab::constructVocab()};
 
+// One row (a guess against every word): pair by pair as before, then a block of solutions at a time
+static void testEncodeRowScalar(benchmark::State& state) {
+    std::vector<wordle::feedback::Encoding> row(wordle::config::NUM_WORDS);
+    wordle::feedback::Encoder encoder{};
+    size_t guessIndex = 0;
+    for (auto _ : state) {
+        std::string_view guess = vocab[guessIndex];
+        for (size_t solutionIndex = 0; solutionIndex < wordle::config::NUM_WORDS; ++solutionIndex) {
+            row[solutionIndex] = encoder(guess, vocab[solutionIndex]);
+        }
+        benchmark::DoNotOptimize(row.data());
+        guessIndex = (guessIndex + 1) % wordle::config::NUM_WORDS;
+    }
+    state.SetItemsProcessed(state.iterations() * wordle::config::NUM_WORDS);
+}
+
+BENCHMARK(testEncodeRowScalar);
+
+static void testEncodeRowBatch(benchmark::State& state) {
+    std::vector<wordle::feedback::Encoding> row(wordle::config::NUM_WORDS);
+    const wordle::feedback::BatchEncoder encoder{vocab};
+    size_t guessIndex = 0;
+    for (auto _ : state) {
+        encoder(vocab[guessIndex], row.data());
+        benchmark::DoNotOptimize(row.data());
+        guessIndex = (guessIndex + 1) % wordle::config::NUM_WORDS;
+    }
+    state.SetItemsProcessed(state.iterations() * wordle::config::NUM_WORDS);
+}
+
+BENCHMARK(testEncodeRowBatch);
+
 static void testConstructFeedbackEncodingBasic(benchmark::State& state) {
     for (auto _ : state) {
         auto fMap{wordle::feedback::constructFeedbackMapBasic(vocab)};
@@ -47,4 +82,20 @@ BENCHMARK(testConstructFlatFeedbackEncoding)
     ->Arg(6ul)
     ->Arg(8ul)
     ->Arg(10ul)
-    ->Arg(12ul);
\ No newline at end of file
+    ->Arg(12ul);
+
+static void testLoadCachedFeedbackMatrix(benchmark::State& state) {
+    wordle::parallel::TaskQueue queue{wordle::config::HARDWARE_CONCURRENCY};
+    constexpr auto path = "bench_feedback_cache.bin";
+    {
+        auto warmup{wordle::feedback::cache::loadFeedbackMatrix(vocab, queue, wordle::config::HARDWARE_CONCURRENCY, path)};
+        benchmark::DoNotOptimize(warmup);
+    }
+    for (auto _ : state) {
+        auto fMap{wordle::feedback::cache::loadFeedbackMatrix(vocab, queue, wordle::config::HARDWARE_CONCURRENCY, path)};
+        benchmark::DoNotOptimize(fMap);
+    }
+    std::remove(path);
+}
+
+BENCHMARK(testLoadCachedFeedbackMatrix);
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "../src/feedbackCache.hpp"
+#include "../src/histogram.hpp"
+
+namespace {
+    const wordle::feedback::FeedbackMatrix& benchMatrix() {
+        static const auto vocab = wordle::vocab::constructVocab();
+        static wordle::parallel::TaskQueue queue{wordle::config::HARDWARE_CONCURRENCY};
+        static const auto matrix = wordle::feedback::cache::loadFeedbackMatrix(vocab, queue);
+        return matrix;
+    }
+
+    // Sorted random subset of targets, like an alive set after a few filters
+    std::vector<wordle::histogram::WordIndex> aliveSubset(size_t size) {
+        std::vector<wordle::histogram::WordIndex> targets(wordle::config::NUM_TARGETS);
+        std::iota(targets.begin(), targets.end(), 0);
+        std::shuffle(targets.begin(), targets.end(), std::mt19937{42});
+        targets.resize(size);
+        std::sort(targets.begin(), targets.end());
+        return targets;
+    }
+
+    // Histograms every guess row against state.range(0) alive targets, like one first pass
+    void firstPass(benchmark::State& state, wordle::histogram::Kernel kernel) {
+        if (!wordle::histogram::isSupported(kernel)) {
+            state.SkipWithError("kernel not supported on this CPU");
+            return;
+        }
+        const auto& matrix = benchMatrix();
+        const auto alive = aliveSubset(state.range(0));
+        wordle::histogram::BinCounts binCounts{};
+
+        for (auto _ : state) {
+            for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+                const auto* nextRow = guessIndex + 1 < wordle::config::NUM_WORDS ? matrix.view().row(guessIndex + 1) : nullptr;
+                wordle::histogram::countBinsWith(kernel, matrix.view().row(guessIndex), alive.data(), alive.size(), binCounts, nextRow);
+                benchmark::DoNotOptimize(binCounts);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * wordle::config::NUM_WORDS * alive.size());
+    }
+}
+
+static void BM_HistogramScalar(benchmark::State& state) {
+    firstPass(state, wordle::histogram::Kernel::SCALAR);
+}
+
+static void BM_HistogramAvx2(benchmark::State& state) {
+    firstPass(state, wordle::histogram::Kernel::AVX2);
+}
+
+static void BM_HistogramAvx512(benchmark::State& state) {
+    firstPass(state, wordle::histogram::Kernel::AVX512);
+}
+
+BENCHMARK(BM_HistogramScalar)->Arg(2315)->Arg(1024)->Arg(512)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HistogramAvx2)->Arg(2315)->Arg(1024)->Arg(512)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HistogramAvx512)->Arg(2315)->Arg(1024)->Arg(512)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
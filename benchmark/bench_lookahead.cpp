@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "../src/hardBot.hpp"
+#include "../src/simulation.hpp"
+
+namespace {
+    constexpr size_t BEAM = 8;
+    constexpr size_t OPENING = 0;  // Fixed first guess, so every depth is timed on the same second-guess states
+
+    // A bot searching state.range(0) guesses ahead
+    std::unique_ptr<wordle::bot::HardBot> lookaheadBot(benchmark::State& state) {
+        auto bot = std::make_unique<wordle::bot::HardBot>(wordle::config::HARDWARE_CONCURRENCY, BEAM);
+        bot->setLookahead(wordle::lookahead::Plan::ofDepth(state.range(0), BEAM));
+        return bot;
+    }
+}
+
+// Latency of one suggest() after the fixed opening, cycling through solutions
+static void BM_LookaheadSuggest(benchmark::State& state) {
+    auto bot = lookaheadBot(state);
+    size_t solutionIndex = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        bot->reset();
+        bot->filter(OPENING, bot->getFMap()[solutionIndex][OPENING]);
+        solutionIndex = (solutionIndex + 97) % wordle::config::NUM_TARGETS;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(bot->suggest());
+    }
+}
+
+// Quality: mean guesses over every target, with a shared cache as in `simulate hard`
+static void BM_LookaheadSimulate(benchmark::State& state) {
+    const auto plan = wordle::lookahead::Plan::ofDepth(state.range(0), BEAM);
+    wordle::simulation::Report report;
+
+    for (auto _ : state) {
+        auto cache = std::make_shared<wordle::cache::SuggestionCache>();
+        report = wordle::simulation::simulate<wordle::bot::HardBot>(
+            wordle::simulation::ThreadPlan::forThreads(), nullptr, cache, BEAM, plan
+        );
+    }
+    state.counters["mean_guesses"] = report.meanGuesses();
+    state.counters["games_lost"] = static_cast<double>(report.guesses.size() - report.gamesWon());
+}
+
+BENCHMARK(BM_LookaheadSuggest)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LookaheadSimulate)->DenseRange(1, 3)->Iterations(1)->Unit(benchmark::kMillisecond);
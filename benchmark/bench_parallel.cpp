@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/parallelTaskQueue.hpp"
+
+namespace {
+    // The original thread-per-task queue, kept here as the dispatch baseline
+    struct ThreadPerTaskQueue {
+        std::vector<std::thread> threadPool;
+
+        ThreadPerTaskQueue(std::size_t initialCapacity) {
+            threadPool.reserve(initialCapacity);
+        }
+        ~ThreadPerTaskQueue() { wait(); }
+
+        template <typename Func, typename... Args>
+        void push(Func&& func, Args&&... args) {
+            threadPool.emplace_back(std::forward<Func>(func), std::forward<Args>(args)...);
+        }
+
+        void wait() {
+            while (!threadPool.empty()) {
+                auto thread = std::move(threadPool.back());
+                threadPool.pop_back();
+                thread.join();
+            }
+        }
+    };
+
+    // Forks state.range(0) empty tasks and joins them
+    template <typename Queue>
+    void dispatch(benchmark::State& state) {
+        const size_t numTasks = state.range(0);
+        Queue queue{wordle::config::HARDWARE_CONCURRENCY};
+        std::atomic<size_t> counter = 0;
+        for (auto _ : state) {
+            for (size_t i = 0; i < numTasks; ++i) {
+                queue.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+            queue.wait();
+        }
+        benchmark::DoNotOptimize(counter.load());
+        state.SetItemsProcessed(state.iterations() * numTasks);
+    }
+}
+
+static void BM_ThreadPerTaskDispatch(benchmark::State& state) {
+    dispatch<ThreadPerTaskQueue>(state);
+}
+
+BENCHMARK(BM_ThreadPerTaskDispatch)
+    ->Arg(1ul)
+    ->Arg(2ul)
+    ->Arg(8ul)
+    ->Arg(64ul)
+    ->UseRealTime();
+
+static void BM_TaskQueueDispatch(benchmark::State& state) {
+    dispatch<wordle::parallel::TaskQueue>(state);
+}
+
+BENCHMARK(BM_TaskQueueDispatch)
+    ->Arg(1ul)
+    ->Arg(2ul)
+    ->Arg(8ul)
+    ->Arg(64ul)
+    ->UseRealTime();
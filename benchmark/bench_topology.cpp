@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "../src/hardBot.hpp"
+#include "../src/simulation.hpp"
+#include "../src/topology.hpp"
+
+namespace {
+    // Game workers from 1 to every allowed CPU (doubling), each with and without node placement
+    void scalingArgs(benchmark::internal::Benchmark* bench) {
+        const auto maxWorkers = static_cast<int64_t>(wordle::topology::hardwareConcurrency());
+        for (int64_t placed = 0; placed <= 1; ++placed) {
+            for (int64_t workers = 1; workers < maxWorkers; workers *= 2) bench->Args({workers, placed});
+            bench->Args({maxWorkers, placed});
+        }
+    }
+}
+
+// Throughput of a whole hard-mode simulation by game workers; placement only differs on machines with several nodes
+static void BM_SimulateScaling(benchmark::State& state) {
+    wordle::simulation::ThreadPlan plan = wordle::simulation::ThreadPlan::forThreads(state.range(0));
+    plan.placeOnNodes = state.range(1) != 0;
+    wordle::simulation::Report report;
+
+    for (auto _ : state) {
+        auto cache = std::make_shared<wordle::cache::SuggestionCache>();
+        report = wordle::simulation::simulate<wordle::bot::HardBot>(plan, nullptr, cache);
+    }
+    state.counters["games_per_s"] = report.gamesPerSecond();
+    state.counters["nodes"] = static_cast<double>(wordle::topology::Topology::system().numNodes());
+    state.SetLabel(plan.placeOnNodes ? "placed" : "unplaced");
+}
+
+// Reading the matrix through a node-local replica (plain view() on single-node machines)
+static void BM_ReplicaRowScan(benchmark::State& state) {
+    const auto context = wordle::engine::Context::shared();
+    const auto& view = context->view(state.range(0));
+    uint64_t sum = 0;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < wordle::config::NUM_WORDS; i += 7) sum += view[i][i % wordle::config::NUM_TARGETS];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["replicas"] = static_cast<double>(context->numReplicas());
+}
+
+BENCHMARK(BM_SimulateScaling)->Apply(scalingArgs)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReplicaRowScan)->DenseRange(0, static_cast<int>(wordle::topology::Topology::system().numNodes()) - 1);
@@ -1,7 +1,45 @@
 #include <benchmark/benchmark.h>
 
+#include <fstream>
+#include <string>
+
 #include "../src/vocab.hpp"
 
+namespace {
+    using LegacyVocab = std::vector<std::string>;
+
+    // The previous loader, kept as a baseline: getline, substr and one heap string per word
+    LegacyVocab legacyProcessFile(const std::string& fileName, size_t numWords) {
+        std::ifstream file{fileName};
+        LegacyVocab words;
+        words.reserve(numWords);
+
+        std::string buff;
+        while (std::getline(file, buff)) {
+            auto first = buff.find_first_not_of(" \t\r\n");
+            auto last = buff.find_last_not_of(" \t\r\n");
+            if (first == std::string::npos || last == std::string::npos) continue;
+            buff = buff.substr(first, last - first + 1);
+            for (char& c : buff) {
+                if ('A' <= c && c <= 'Z') c += ('a' - 'A');
+            }
+            words.push_back(std::move(buff));
+        }
+        return words;
+    }
+
+    // Reads every letter once through vocab[i], as the encoders do
+    template <typename Words>
+    size_t sumLetters(const Words& vocab) {
+        size_t sum = 0;
+        for (size_t i = 0; i < vocab.size(); ++i) {
+            std::string_view word = vocab[i];
+            for (size_t j = 0; j < wordle::config::WORD_LENGTH; ++j) sum += static_cast<unsigned char>(word[j]);
+        }
+        return sum;
+    }
+}
+
 static void BM_processTargetFile(benchmark::State& state) {
     for (auto _ : state) {
         auto x = wordle::vocab::__impl::processFile(wordle::config::TARGET_FILE, wordle::config::NUM_TARGETS);
@@ -10,6 +48,14 @@ static void BM_processTargetFile(benchmark::State& state) {
 }
 BENCHMARK(BM_processTargetFile);
 
+static void BM_legacyProcessTargetFile(benchmark::State& state) {
+    for (auto _ : state) {
+        auto x = legacyProcessFile(wordle::config::TARGET_FILE, wordle::config::NUM_TARGETS);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK(BM_legacyProcessTargetFile);
+
 static void BM_processFillerFile(benchmark::State& state) {
     for (auto _ : state) {
         auto x = wordle::vocab::__impl::processFile(wordle::config::FILLER_FILE, wordle::config::NUM_FILLERS);
@@ -18,6 +64,14 @@ static void BM_processFillerFile(benchmark::State& state) {
 }
 BENCHMARK(BM_processFillerFile);
 
+static void BM_legacyProcessFillerFile(benchmark::State& state) {
+    for (auto _ : state) {
+        auto x = legacyProcessFile(wordle::config::FILLER_FILE, wordle::config::NUM_FILLERS);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK(BM_legacyProcessFillerFile);
+
 static void BM_constructVocab(benchmark::State& state) {
     for (auto _ : state) {
         auto x = wordle::vocab::constructVocab();
@@ -26,4 +80,24 @@ static void BM_constructVocab(benchmark::State& state) {
 }
 BENCHMARK(BM_constructVocab);
 
-BENCHMARK_MAIN();
\ No newline at end of file
+static void BM_scanVocab(benchmark::State& state) {
+    const auto vocab = wordle::vocab::constructVocab();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sumLetters(vocab));
+    }
+    state.SetItemsProcessed(state.iterations() * vocab.size());
+}
+BENCHMARK(BM_scanVocab);
+
+static void BM_scanLegacyVocab(benchmark::State& state) {
+    auto vocab = legacyProcessFile(wordle::config::TARGET_FILE, wordle::config::NUM_TARGETS);
+    const auto fillers = legacyProcessFile(wordle::config::FILLER_FILE, wordle::config::NUM_FILLERS);
+    vocab.insert(vocab.end(), fillers.begin(), fillers.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sumLetters(vocab));
+    }
+    state.SetItemsProcessed(state.iterations() * vocab.size());
+}
+BENCHMARK(BM_scanLegacyVocab);
+
+BENCHMARK_MAIN();
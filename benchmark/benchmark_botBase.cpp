@@ -1,13 +1,20 @@
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <memory>
+
 #include "../src/botBase.hpp"
+#include "../src/easyBot.hpp"
+#include "../src/hardBot.hpp"
 
 struct Dummy : wordle::bot::BotBase {
     Dummy() noexcept = default;
     ~Dummy() noexcept = default;
 };
 
+// Bots borrow the process-wide context, so this measures only their own state
 static void BM_BotBaseConstructor(benchmark::State& state) {
+    const auto context = wordle::engine::Context::shared();
     for (auto _ : state) {
         Dummy base{};
         benchmark::DoNotOptimize(base);
@@ -16,3 +23,61 @@ static void BM_BotBaseConstructor(benchmark::State& state) {
 
 BENCHMARK(BM_BotBaseConstructor);
 
+// Building a private context: vocab plus a mapped (or rebuilt) feedback matrix
+static void BM_EngineContextCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        auto context = wordle::engine::Context::create();
+        benchmark::DoNotOptimize(context);
+    }
+}
+
+BENCHMARK(BM_EngineContextCreate)->Unit(benchmark::kMillisecond);
+
+namespace {
+    constexpr std::string_view OPENING_GUESS = "slate";
+    constexpr size_t SOLUTION_INDEX = 1000;
+
+    // One bot per layout, built on first use and left in the state after OPENING_GUESS
+    template <typename Bot>
+    Bot& openedBot(wordle::feedback::Layout layout) {
+        static std::unique_ptr<Bot> bots[2];
+        auto& bot = bots[static_cast<size_t>(layout)];
+        if (!bot) bot = std::make_unique<Bot>(wordle::config::HARDWARE_CONCURRENCY, wordle::config::HARDWARE_CONCURRENCY, layout);
+
+        const auto& vocab = bot->getVocab();
+        const size_t guessIndex = std::distance(vocab.begin(), std::find(vocab.begin(), vocab.end(), OPENING_GUESS));
+        bot->reset();
+        bot->filter(guessIndex, bot->getFMap()[SOLUTION_INDEX][guessIndex]);
+        return *bot;
+    }
+
+    template <typename Bot>
+    void suggestAfterOpening(benchmark::State& state) {
+        auto& bot = openedBot<Bot>(static_cast<wordle::feedback::Layout>(state.range(0)));
+        for (auto _ : state) {
+            auto suggestion = bot.suggest();
+            benchmark::DoNotOptimize(suggestion);
+        }
+    }
+}
+
+// Arg: 0 = Layout::FLAT, 1 = Layout::NESTED
+static void BM_EasyBotSuggestLayout(benchmark::State& state) {
+    suggestAfterOpening<wordle::bot::EasyBot>(state);
+}
+
+BENCHMARK(BM_EasyBotSuggestLayout)
+    ->Arg(static_cast<int64_t>(wordle::feedback::Layout::FLAT))
+    ->Arg(static_cast<int64_t>(wordle::feedback::Layout::NESTED))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_HardBotSuggestLayout(benchmark::State& state) {
+    suggestAfterOpening<wordle::bot::HardBot>(state);
+}
+
+BENCHMARK(BM_HardBotSuggestLayout)
+    ->Arg(static_cast<int64_t>(wordle::feedback::Layout::FLAT))
+    ->Arg(static_cast<int64_t>(wordle::feedback::Layout::NESTED))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -1,14 +1,64 @@
 #include <chrono>
 #include <cstring>
 #include <cctype>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <optional>
+
+#include <unistd.h>
 
 #include "src/easyBot.hpp"
 #include "src/hardBot.hpp"
+#include "src/profile.hpp"
+#include "src/server.hpp"
+#include "src/simulation.hpp"
+#include "src/solver.hpp"
+
+template <bool HardMode>
+constexpr const char* bookFile() {
+    return HardMode ? wordle::config::HARD_BOOK_FILE : wordle::config::EASY_BOOK_FILE;
+}
 
 template <bool HardMode>
-void statsImpl() {
+constexpr const char* solverFile() {
+    return HardMode ? wordle::config::HARD_SOLVER_FILE : wordle::config::EASY_SOLVER_FILE;
+}
+
+template <bool HardMode>
+constexpr const char* strategyFile() {
+    return HardMode ? wordle::config::HARD_STRATEGY_FILE : wordle::config::EASY_STRATEGY_FILE;
+}
+
+// Prints the outcome of one game per target
+void reportGames(const std::vector<size_t>& games) {
+    double mean = std::accumulate(games.begin(), games.end(), 0.0) / static_cast<double>(wordle::config::NUM_TARGETS);
+    auto winPred = [](size_t guesses) noexcept -> bool { return guesses <= 6; };
+    size_t gamesWon = std::count_if(games.begin(), games.end(), winPred);
+    double winProb = static_cast<double>(gamesWon) / static_cast<double>(wordle::config::NUM_TARGETS);
+
+    std::cout << "Mean guesses: " << mean << "\n";
+    std::cout << "Win Percentage: " << winProb * 100.0 << "%\n";
+    std::cout << "Games lost: " << wordle::config::NUM_TARGETS - gamesWon << "\n";
+}
+
+// Starts a "--profile" run: clears the phase totals and reads hardware counters where the kernel permits
+void startProfile() {
+    if constexpr (!wordle::profile::ENABLED) {
+        std::cout << "Profile: not compiled in (configure with -DWORDLE_PROFILE=ON)\n";
+        return;
+    }
+    wordle::profile::reset();
+    if (!wordle::profile::useHardwareCounters(true)) std::cout << "Profile: hardware counters unavailable, timing only\n";
+}
+
+void printProfile() {
+    if constexpr (wordle::profile::ENABLED) std::cout << "Profile:\n" << wordle::profile::report().format();
+}
+
+template <bool HardMode>
+void statsImpl(bool profile) {
     using Bot = std::conditional_t<HardMode, wordle::bot::HardBot, wordle::bot::EasyBot>;
 
     if constexpr (HardMode) {
@@ -17,8 +67,20 @@ void statsImpl() {
         std::cout << "Easy Mode Stats: \n";
     }
     
-    // Get first guess
+    // Serve the opening book if one was built for this bot
     Bot bot{};
+    if (auto book = wordle::book::readOpeningBook(bookFile<HardMode>(), bot.getVocab()); book && book->matches(Bot::BOOK_MODE, bot.getBeamCandidates(), bot.getVocab())) {
+        std::cout << "Opening book: " << book->size() << " nodes\n";
+        bot.useOpeningBook(std::make_shared<const wordle::book::OpeningBook>(std::move(*book)));
+    }
+
+    // Games overlap heavily, so share one transposition cache across all of them
+    auto suggestionCache = std::make_shared<wordle::cache::SuggestionCache>();
+    bot.useSuggestionCache(suggestionCache);
+
+    if (profile) startProfile();
+
+    // Get first guess
     const auto firstSuggestion = bot.suggest();
     wordle::guard::hybridGuard(firstSuggestion.isValid, "Unable to retrieve first guess");
 
@@ -49,24 +111,225 @@ void statsImpl() {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
     std::cout << "Simulation Time: " << duration << " ms\n";
 
-    double mean = std::accumulate(games.begin(), games.end(), 0.0) / static_cast<double>(wordle::config::NUM_TARGETS);
-    auto winPred = [](size_t guesses) noexcept -> bool { return guesses <= 6; };
-    size_t gamesWon = std::count_if(games.begin(), games.end(), winPred);
-    double winProb = static_cast<double>(gamesWon) / static_cast<double>(wordle::config::NUM_TARGETS);
+    reportGames(games);
+    std::cout << "Suggestion cache: " << suggestionCache->hits() << " hits, " << suggestionCache->misses() << " misses\n";
 
-    std::cout << "Mean guesses: " << mean << "\n";
-    std::cout << "Win Percentage: " << winProb * 100.0 << "%\n";
+    const auto pruneStats = bot.getPruneStats();
+    std::cout << "Pruned: " << pruneStats.candidatesPruned << " of " << pruneStats.candidates << " candidates ("
+              << pruneStats.binsSkipped << " bins), " << pruneStats.binScansCut << " of " << pruneStats.binScans
+              << " bin scans cut short (" << pruneStats.guessesSkipped << " guesses)\n";
+
+    // Only pages touched by the games are counted, so this reads after them
+    constexpr double MB = 1024.0 * 1024.0;
+    const auto& context = *bot.getContext();
+    std::cout << "Matrix: " << context.matrixBytes() / MB << " MB, " << context.hugePageBytes() / MB << " MB on huge pages\n";
+
+    if (profile) printProfile();
+}
+
+// Plays every target along the strategy tree written by "solve", as statsImpl() plays them with a bot
+template <bool HardMode>
+void exactStatsImpl() {
+    if constexpr (HardMode) {
+        std::cout << "Hard Mode Stats (exact solver): \n";
+    } else {
+        std::cout << "Easy Mode Stats (exact solver): \n";
+    }
+
+    const auto context = wordle::engine::Context::shared();
+    const auto& vocab = context->vocab();
+    const auto& fMap = context->view();
+    constexpr auto mode = wordle::solver::Solver<HardMode>::BOOK_MODE;
+
+    auto strategy = wordle::book::readOpeningBook(strategyFile<HardMode>(), vocab);
+    wordle::guard::runtimeGuard(strategy && strategy->matches(mode, wordle::book::SOLVER_BEAM, vocab), "No strategy in {} (run \"solve\" first)", strategyFile<HardMode>());
+
+    const auto& root = (*strategy)[wordle::book::ROOT];
+    std::cout << "Strategy: " << strategy->size() << " nodes\n";
+    std::cout << "First guess: " << vocab[root.guess] << " with expected guesses " << root.entropy << "\n";
+
+    // Simulate all games
+    std::vector<size_t> games{};
+    games.reserve(wordle::config::NUM_TARGETS);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t solutionIndex = 0; solutionIndex < wordle::config::NUM_TARGETS; ++solutionIndex) {
+        wordle::book::Cursor cursor{&*strategy};
+        size_t guesses = 1;
+        const auto& fMapSlice = fMap[solutionIndex];
+
+        for (const auto* node = cursor.current(); node->guess != solutionIndex; ++guesses) {
+            cursor.advance(node->guess, fMapSlice[node->guess]);
+            node = cursor.current();
+            wordle::guard::runtimeGuard(node != nullptr, "Strategy has no guess for {}", vocab[solutionIndex]);
+        }
+        games.push_back(guesses);
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Simulation Time: " << duration << " ms\n";
+    reportGames(games);
+    std::cout << "Worst case: " << *std::max_element(games.begin(), games.end()) << " guesses\n";
+}
+
+template <bool HardMode>
+void simulateImpl() {
+    using Bot = std::conditional_t<HardMode, wordle::bot::HardBot, wordle::bot::EasyBot>;
+
+    if constexpr (HardMode) {
+        std::cout << "Hard Mode Simulation: \n";
+    } else {
+        std::cout << "Easy Mode Simulation: \n";
+    }
+
+    // Book and cache are shared by every game worker
+    std::shared_ptr<const wordle::book::OpeningBook> openingBook = nullptr;
+    {
+        Bot probe{1};
+        auto book = wordle::book::readOpeningBook(bookFile<HardMode>(), probe.getVocab());
+        if (book && book->matches(Bot::BOOK_MODE, probe.getBeamCandidates(), probe.getVocab())) {
+            std::cout << "Opening book: " << book->size() << " nodes\n";
+            openingBook = std::make_shared<const wordle::book::OpeningBook>(std::move(*book));
+        }
+    }
+    auto suggestionCache = std::make_shared<wordle::cache::SuggestionCache>();
+
+    const auto plan = wordle::simulation::ThreadPlan::forThreads();
+    const auto report = wordle::simulation::simulate<Bot>(plan, openingBook, suggestionCache);
+
+    const size_t gamesWon = report.gamesWon();
+    std::cout << "Threads: " << plan.gameWorkers << " games x " << plan.suggestThreads << " per suggestion\n";
+    std::cout << "Simulation Time: " << report.duration.count() << " ms\n";
+    std::cout << "Mean guesses: " << report.meanGuesses() << "\n";
+    std::cout << "Win Percentage: " << static_cast<double>(gamesWon) / static_cast<double>(wordle::config::NUM_TARGETS) * 100.0 << "%\n";
     std::cout << "Games lost: " << wordle::config::NUM_TARGETS - gamesWon << "\n";
+    std::cout << "Throughput: " << report.gamesPerSecond() << " games/s\n";
+    std::cout << "Suggestion cache: " << suggestionCache->hits() << " hits, " << suggestionCache->misses() << " misses\n";
 }
 
-inline void stats(std::string_view mode) {
+inline void simulate(std::string_view mode) {
     if (mode == "hard") {
-        statsImpl<true>();
+        simulateImpl<true>();
         return;
     }
 
     if (mode == "easy") {
-        statsImpl<false>();
+        simulateImpl<false>();
+        return;
+    }
+
+    std::cerr << "Argument error: " << "please pass \"hard\" or \"easy\" (without quotations, case-sensitive)\n";
+}
+
+template <bool HardMode>
+void bookImpl(uint32_t maxDepth) {
+    using Bot = std::conditional_t<HardMode, wordle::bot::HardBot, wordle::bot::EasyBot>;
+
+    Bot bot{};
+    auto start = std::chrono::steady_clock::now();
+    const auto book = wordle::book::Builder<Bot>{bot, maxDepth}.build();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    wordle::guard::runtimeGuard(wordle::book::writeOpeningBook(bookFile<HardMode>(), book), "Unable to write {}", bookFile<HardMode>());
+    std::cout << "Opening book: " << book.size() << " nodes written to " << bookFile<HardMode>() << " in " << duration << " ms\n";
+}
+
+inline void buildBook(std::string_view mode, uint32_t maxDepth) {
+    if (mode == "hard") {
+        bookImpl<true>(maxDepth);
+        return;
+    }
+
+    if (mode == "easy") {
+        bookImpl<false>(maxDepth);
+        return;
+    }
+
+    std::cerr << "Argument error: " << "please pass \"hard\" or \"easy\" (without quotations, case-sensitive)\n";
+}
+
+template <bool HardMode>
+void solveImpl(size_t candidateLimit) {
+    using Solver = wordle::solver::Solver<HardMode>;
+
+    auto options = wordle::solver::Options::forMode(Solver::BOOK_MODE);
+    options.candidateLimit = candidateLimit;
+    Solver solver{wordle::engine::Context::shared(), options};
+    if (solver.load(solverFile<HardMode>())) {
+        std::cout << "Solver memo: " << solver.memoSize() << " states from " << solverFile<HardMode>() << "\n";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const auto solution = solver.solve();
+    const auto strategy = solver.strategy();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    wordle::guard::runtimeGuard(solver.save(solverFile<HardMode>()), "Unable to write {}", solverFile<HardMode>());
+    wordle::guard::runtimeGuard(wordle::book::writeOpeningBook(strategyFile<HardMode>(), strategy), "Unable to write {}", strategyFile<HardMode>());
+
+    const auto stats = solver.getStats();
+    std::cout << "First guess: " << solver.getVocab()[solution.guess] << "\n";
+    std::cout << "Expected guesses: " << static_cast<double>(solution.cost.totalGuesses) / static_cast<double>(wordle::config::NUM_TARGETS) << "\n";
+    std::cout << "Worst case: " << solution.cost.worstCase << " guesses\n";
+    std::cout << "Solve Time: " << duration << " ms (" << stats.states << " states searched, " << stats.memoHits << " memo hits, "
+              << stats.candidatesPruned << " of " << stats.candidates << " candidates pruned)\n";
+    std::cout << "Strategy: " << strategy.size() << " nodes written to " << strategyFile<HardMode>() << "\n";
+}
+
+inline void solve(std::string_view mode, size_t candidateLimit) {
+    if (mode == "hard") {
+        solveImpl<true>(candidateLimit);
+        return;
+    }
+
+    if (mode == "easy") {
+        solveImpl<false>(candidateLimit);
+        return;
+    }
+
+    std::cerr << "Argument error: " << "please pass \"hard\" or \"easy\" (without quotations, case-sensitive)\n";
+}
+
+// Lends the opening book built for this mode (if any) to the server's bots
+template <bool HardMode>
+void serveBook(wordle::server::Server& server, const wordle::vocab::Vocab& vocab) {
+    using Bot = std::conditional_t<HardMode, wordle::bot::HardBot, wordle::bot::EasyBot>;
+
+    auto book = wordle::book::readOpeningBook(bookFile<HardMode>(), vocab);
+    if (book && book->matches(Bot::BOOK_MODE, wordle::config::HARDWARE_CONCURRENCY, vocab)) {
+        std::cerr << "Opening book: " << book->size() << " nodes from " << bookFile<HardMode>() << "\n";
+        server.useOpeningBook(Bot::BOOK_MODE, std::make_shared<const wordle::book::OpeningBook>(std::move(*book)));
+    }
+}
+
+// Answers the line protocol of server.hpp on stdin and stdout, or on a Unix domain socket (logs go to stderr)
+inline void serve(std::optional<std::string_view> socketPath) {
+    const auto context = wordle::engine::Context::shared();
+    wordle::server::Server server{{}, context};
+    serveBook<true>(server, context->vocab());
+    serveBook<false>(server, context->vocab());
+
+    if (socketPath) {
+        std::cerr << "Serving on " << *socketPath << "\n";
+        wordle::server::serveSocket(server, *socketPath);
+    } else {
+        wordle::server::serveStream(server, STDIN_FILENO, STDOUT_FILENO);
+    }
+
+    const auto& latencies = server.getLatencies();
+    std::cerr << "Requests: " << latencies.count() << " (p50 " << latencies.percentile(50) << " us, p99 "
+              << latencies.percentile(99) << " us, max " << latencies.max() << " us)\n";
+}
+
+// exact replays the strategy written by "solve" instead of running a bot, profile reports where suggest() spent its time
+inline void stats(std::string_view mode, bool exact, bool profile = false) {
+    if (mode == "hard") {
+        exact ? exactStatsImpl<true>() : statsImpl<true>(profile);
+        return;
+    }
+
+    if (mode == "easy") {
+        exact ? exactStatsImpl<false>() : statsImpl<false>(profile);
         return;
     }
 
@@ -74,15 +337,65 @@ inline void stats(std::string_view mode) {
 }
 
 int main(int argc, char** argv) {
-    if (argc != 3) {
+    // Optional second argument is a Unix domain socket path (stdin and stdout otherwise)
+    if (argc >= 2 && std::string_view{argv[1]} == "serve" && argc <= 3) {
+        serve(argc == 3 ? std::optional<std::string_view>{argv[2]} : std::nullopt);
+        return 0;
+    }
+
+    if (argc != 3 && argc != 4) {
         std::cerr << "Argument error: invalid command (see README.txt)\n";
         return 1;
     }
 
     std::string_view flagOne{argv[1]};
 
-    if (flagOne == "stats") {
-        stats(argv[2]);
+    if (flagOne == "stats" && argc == 3) {
+        stats(argv[2], false);
+        return 0;
+    }
+
+    if (flagOne == "stats" && argc == 4 && std::string_view{argv[3]} == "exact") {
+        stats(argv[2], true);
+        return 0;
+    }
+
+    if (flagOne == "stats" && argc == 4 && std::string_view{argv[3]} == "--profile") {
+        stats(argv[2], false, true);
+        return 0;
+    }
+
+    if (flagOne == "simulate" && argc == 3) {
+        simulate(argv[2]);
+        return 0;
+    }
+
+    // Optional third argument limits the book to that many guesses per game
+    if (flagOne == "book") {
+        uint32_t maxDepth = wordle::book::NO_DEPTH_LIMIT;
+        if (argc == 4) {
+            maxDepth = static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10));
+            if (maxDepth == 0) {
+                std::cerr << "Argument error: book depth must be a positive integer\n";
+                return 1;
+            }
+        }
+        buildBook(argv[2], maxDepth);
+        return 0;
+    }
+
+    // Optional third argument sets the guesses searched per state (0 searches every guess)
+    if (flagOne == "solve") {
+        size_t candidateLimit = wordle::solver::DEFAULT_CANDIDATE_LIMIT;
+        if (argc == 4) {
+            char* end = nullptr;
+            candidateLimit = static_cast<size_t>(std::strtoul(argv[3], &end, 10));
+            if (end == argv[3] || *end != '\0') {
+                std::cerr << "Argument error: candidate limit must be a non-negative integer\n";
+                return 1;
+            }
+        }
+        solve(argv[2], candidateLimit);
         return 0;
     }
 
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <sys/mman.h>
+
+#include "arena.hpp"
+
+namespace {
+    struct Live {
+        size_t length;
+        wordle::util::arena::Backing backing;
+    };
+
+    std::atomic<wordle::util::arena::Policy> currentPolicy = wordle::util::arena::Policy::TRANSPARENT;
+    std::mutex liveMtx;
+    std::map<uintptr_t, Live> live;  // Arena start -> mapping, for backingOf() and stats()
+
+    constexpr size_t roundUp(size_t bytes, size_t multiple) noexcept {
+        return (bytes + multiple - 1) / multiple * multiple;
+    }
+
+    // Anonymous mapping of length bytes starting on a huge page boundary, or nullptr
+    std::byte* mapAligned(size_t length) noexcept {
+        constexpr size_t HUGE = wordle::util::arena::HUGE_PAGE_SIZE;
+        void* raw = ::mmap(nullptr, length + HUGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+
+        // Trim the slack on both sides, keeping [aligned, aligned + length)
+        auto* start = static_cast<std::byte*>(raw);
+        auto* aligned = reinterpret_cast<std::byte*>(roundUp(reinterpret_cast<uintptr_t>(start), HUGE));
+        const size_t head = static_cast<size_t>(aligned - start);
+        if (head > 0) ::munmap(start, head);
+        ::munmap(aligned + length, HUGE - head);
+        return aligned;
+    }
+
+    // Value of a "Name:   1234 kB" smaps line, in bytes
+    size_t smapsBytes(std::string_view line) noexcept {
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) return 0;
+        line.remove_prefix(colon + 1);
+        while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+
+        size_t kilobytes = 0;
+        std::from_chars(line.data(), line.data() + line.size(), kilobytes);
+        return kilobytes * 1024;
+    }
+}
+
+void wordle::util::arena::setPolicy(Policy policy) noexcept {
+    currentPolicy.store(policy, std::memory_order_relaxed);
+}
+
+wordle::util::arena::Policy wordle::util::arena::policy() noexcept {
+    return currentPolicy.load(std::memory_order_relaxed);
+}
+
+void* wordle::util::arena::map(size_t bytes) {
+    const size_t length = roundUp(std::max<size_t>(bytes, 1), HUGE_PAGE_SIZE);
+    const Policy requested = policy();
+    std::byte* data = nullptr;
+    Backing backing = Backing::NONE;
+
+    // Step 1: Reserved huge pages, if asked for and the pool has enough
+#ifdef MAP_HUGETLB
+    if (requested == Policy::HUGETLB) {
+        void* addr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED) {
+            data = static_cast<std::byte*>(addr);
+            backing = Backing::HUGETLB;
+        }
+    }
+#endif
+
+    // Step 2: Ordinary pages, handed to khugepaged and the fault path unless huge pages are off
+    if (!data) {
+        data = mapAligned(length);
+        if (!data) throw std::bad_alloc{};
+#ifdef MADV_HUGEPAGE
+        if (requested != Policy::OFF && ::madvise(data, length, MADV_HUGEPAGE) == 0) backing = Backing::TRANSPARENT;
+#endif
+    }
+
+    std::lock_guard<std::mutex> lock(liveMtx);
+    live[reinterpret_cast<uintptr_t>(data)] = {length, backing};
+    return data;
+}
+
+void wordle::util::arena::unmap(void* ptr, size_t bytes) noexcept {
+    if (!ptr) return;
+    {
+        std::lock_guard<std::mutex> lock(liveMtx);
+        live.erase(reinterpret_cast<uintptr_t>(ptr));
+    }
+    ::munmap(ptr, roundUp(std::max<size_t>(bytes, 1), HUGE_PAGE_SIZE));
+}
+
+wordle::util::arena::Backing wordle::util::arena::backingOf(const void* ptr) noexcept {
+    std::lock_guard<std::mutex> lock(liveMtx);
+    const auto it = live.find(reinterpret_cast<uintptr_t>(ptr));
+    return it == live.end() ? Backing::NONE : it->second.backing;
+}
+
+wordle::util::arena::Stats wordle::util::arena::stats() noexcept {
+    Stats stats{};
+    std::lock_guard<std::mutex> lock(liveMtx);
+    for (const auto& [start, arena] : live) {
+        ++stats.arenas;
+        stats.bytes[static_cast<size_t>(arena.backing)] += arena.length;
+    }
+    return stats;
+}
+
+bool wordle::util::arena::isSupported(Backing backing) noexcept {
+    switch (backing) {
+#ifdef MADV_HUGEPAGE
+        case Backing::TRANSPARENT: return true;
+#endif
+#ifdef MAP_HUGETLB
+        case Backing::HUGETLB: return true;
+#endif
+        case Backing::NONE: return true;
+        default: return false;
+    }
+}
+
+size_t wordle::util::arena::hugePageBytes(const void* ptr, size_t bytes) {
+    const auto first = reinterpret_cast<uintptr_t>(ptr);
+    const uintptr_t last = first + bytes;
+
+    std::ifstream smaps{"/proc/self/smaps"};
+    std::string line;
+    size_t overlap = 0;  // Bytes of the current mapping inside [first, last)
+    size_t huge = 0;
+    while (std::getline(smaps, line)) {
+        // Mapping header: "start-end perms offset dev inode [path]"
+        const size_t dash = line.find('-');
+        if (dash != std::string::npos && dash < line.find(' ') && line.find(':') > dash) {
+            uintptr_t start = 0;
+            uintptr_t end = 0;
+            std::from_chars(line.data(), line.data() + dash, start, 16);
+            std::from_chars(line.data() + dash + 1, line.data() + line.size(), end, 16);
+            overlap = (start < last && first < end) ? std::min(end, last) - std::max(start, first) : 0;
+            continue;
+        }
+        if (overlap == 0) continue;
+
+        const std::string_view field{line};
+        if (field.starts_with("AnonHugePages:") || field.starts_with("FilePmdMapped:") || field.starts_with("ShmemPmdMapped:") ||
+            field.starts_with("Private_Hugetlb:") || field.starts_with("Shared_Hugetlb:")) {
+            huge += std::min(smapsBytes(field), overlap);
+        }
+    }
+    return std::min(huge, bytes);
+}
+
+const char* wordle::util::arena::toString(Backing backing) noexcept {
+    switch (backing) {
+        case Backing::TRANSPARENT: return "transparent huge pages";
+        case Backing::HUGETLB: return "hugetlbfs pages";
+        default: return "small pages";
+    }
+}
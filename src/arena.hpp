@@ -0,0 +1,103 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "config.hpp"
+
+/*
+Page-level storage for the engine's large tables: feedback matrix rows, node replicas and bit planes.
+
+Every allocation of at least LARGE_ALLOCATION bytes is its own arena, an anonymous mapping aligned to HUGE_PAGE_SIZE so
+the kernel can back it with huge pages. The process-wide policy decides how hard to try:
+    OFF:          plain pages
+    TRANSPARENT:  madvise(MADV_HUGEPAGE), the kernel backs whatever it can with transparent huge pages (default)
+    HUGETLB:      pages reserved in the hugetlbfs pool (MAP_HUGETLB), falling back to TRANSPARENT if the pool is short
+Platforms without these flags get plain pages whatever the policy, reported as Backing::NONE.
+Smaller allocations come from the aligned heap. Whether huge pages were actually obtained is only known once pages are
+touched, so hugePageBytes() asks the kernel (/proc/self/smaps).
+*/
+namespace wordle::util::arena {
+
+    enum class Policy : uint8_t { OFF = 0, TRANSPARENT, HUGETLB };
+
+    // What an arena ended up with (NONE: ordinary small pages)
+    enum class Backing : uint8_t { NONE = 0, TRANSPARENT, HUGETLB };
+
+    constexpr inline size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+    constexpr inline size_t LARGE_ALLOCATION = HUGE_PAGE_SIZE;  // Smaller requests stay on the heap
+
+    // Bytes held by live arenas, by backing
+    struct Stats {
+        size_t arenas = 0;
+        size_t bytes[3]{};
+
+        [[nodiscard]] size_t total() const noexcept { return bytes[0] + bytes[1] + bytes[2]; }
+    };
+
+    // Applies to arenas mapped from now on
+    void setPolicy(Policy policy) noexcept;
+
+    [[nodiscard]] Policy policy() noexcept;
+
+    // Maps a zeroed arena of at least bytes (rounded up to whole huge pages). Throws std::bad_alloc if nothing can be mapped.
+    [[nodiscard]] void* map(size_t bytes);
+
+    // Unmaps an arena returned by map(bytes)
+    void unmap(void* ptr, size_t bytes) noexcept;
+
+    // Backing chosen for the arena at ptr (NONE if ptr isn't a live arena)
+    [[nodiscard]] Backing backingOf(const void* ptr) noexcept;
+
+    [[nodiscard]] Stats stats() noexcept;
+
+    // Returns true if this platform can ask for backing at all (MAP_HUGETLB and MADV_HUGEPAGE are Linux only)
+    [[nodiscard]] bool isSupported(Backing backing) noexcept;
+
+    // Bytes of [ptr, ptr + bytes) currently backed by huge pages of any kind, per the kernel (0 where it can't tell)
+    [[nodiscard]] size_t hugePageBytes(const void* ptr, size_t bytes);
+
+    [[nodiscard]] const char* toString(Backing backing) noexcept;
+
+}  // namespace wordle::util::arena
+
+namespace wordle::util {
+
+/*
+Allocator placing large requests in their own arena (see arena::map) and small ones on the Alignment-aligned heap.
+Arenas are page aligned, so any Alignment up to the page size holds for both.
+*/
+template <typename T, size_t Alignment = config::CACHE_LINE_SIZE>
+requires (std::has_single_bit(Alignment) && Alignment >= alignof(T) && Alignment <= 4096)
+struct ArenaAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = ArenaAllocator<U, Alignment>;
+    };
+
+    constexpr ArenaAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr ArenaAllocator(const ArenaAllocator<U, Alignment>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (bytes >= arena::LARGE_ALLOCATION) return static_cast<T*>(arena::map(bytes));
+        return static_cast<T*>(::operator new(bytes, std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (bytes >= arena::LARGE_ALLOCATION) return arena::unmap(ptr, bytes);
+        ::operator delete(ptr, bytes, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    constexpr bool operator==(const ArenaAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+}  // namespace wordle::util
@@ -0,0 +1,95 @@
+#include "bitSlice.hpp"
+
+wordle::bitslice::PlaneMatrix::PlaneMatrix(const wordle::feedback::FeedbackMatrixView& fMap)
+: planes(wordle::config::NUM_WORDS * PLANES_PER_GUESS * TARGET_WORDS, 0) {
+    using namespace wordle::feedback::__impl;
+
+    for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+        const auto* row = fMap.row(guessIndex);
+        for (size_t targetIndex = 0; targetIndex < wordle::config::NUM_TARGETS; ++targetIndex) {
+            size_t encoding = row[targetIndex];
+            const Word bit = Word{1} << (targetIndex % 64);
+            for (size_t position = 0; position < wordle::config::WORD_LENGTH; ++position) {
+                const size_t trit = encoding % BASE;
+                encoding /= BASE;
+                if (trit == EXHAUSTED) continue;
+                planes[offset(guessIndex, targetIndex / 64, position, trit == CORRECT)] |= bit;
+            }
+        }
+    }
+}
+
+namespace {
+    using wordle::bitslice::Word;
+    using wordle::bitslice::TARGET_WORDS;
+
+    struct Splitter {
+        const Word* const* wordPlanes;  // Planes of the guess for each active word
+        const uint8_t* activeWords;
+        size_t numActive;
+        const wordle::feedback::Encoding* row;
+        wordle::entropy::SparseHistogram& histogram;
+
+        // Reads the row for each of the few targets in mask
+        void emitEach(const Word* mask) const noexcept {
+            for (size_t i = 0; i < numActive; ++i) {
+                for (Word bits = mask[i]; bits; bits &= bits - 1) {
+                    const size_t targetIndex = activeWords[i] * 64 + std::countr_zero(bits);
+                    histogram.add(row[targetIndex], 1);
+                }
+            }
+        }
+
+        // Splits the count targets in mask (all sharing bin prefix) by position, then recurses
+        void split(const Word* mask, size_t count, size_t position, size_t prefix) const noexcept {
+            if (position == wordle::config::WORD_LENGTH) {
+                histogram.add(static_cast<wordle::feedback::Encoding>(prefix), static_cast<wordle::histogram::WordIndex>(count));
+                return;
+            }
+            if (count <= wordle::bitslice::SHORTCUT_COUNT) {
+                emitEach(mask);
+                return;
+            }
+
+            // Step 1: Split mask into green, yellow and grey pieces at this position
+            Word greenMask[TARGET_WORDS];
+            Word yellowMask[TARGET_WORDS];
+            Word greyMask[TARGET_WORDS];
+            size_t greenCount = 0;
+            size_t yellowCount = 0;
+            for (size_t i = 0; i < numActive; ++i) {
+                const Word green = wordPlanes[i][2 * position];
+                const Word yellow = wordPlanes[i][2 * position + 1];
+                greenMask[i] = mask[i] & green;
+                yellowMask[i] = mask[i] & yellow;
+                greyMask[i] = mask[i] & ~(green | yellow);
+                greenCount += std::popcount(greenMask[i]);
+                yellowCount += std::popcount(yellowMask[i]);
+            }
+            const size_t greyCount = count - greenCount - yellowCount;
+
+            // Step 2: Recurse into non-empty pieces
+            const size_t multiplier = wordle::feedback::__impl::multipliers[position];
+            if (greyCount) split(greyMask, greyCount, position + 1, prefix + wordle::feedback::__impl::EXHAUSTED * multiplier);
+            if (yellowCount) split(yellowMask, yellowCount, position + 1, prefix + wordle::feedback::__impl::WRONG_POSITION * multiplier);
+            if (greenCount) split(greenMask, greenCount, position + 1, prefix + wordle::feedback::__impl::CORRECT * multiplier);
+        }
+    };
+}
+
+void wordle::bitslice::countBins(const PlaneMatrix& planes, size_t guessIndex, const wordle::feedback::Encoding* row, const AliveSet& alive, wordle::entropy::SparseHistogram& histogram) noexcept {
+    histogram.clear();
+    if (alive.size() == 0) return;
+
+    // Root mask: the alive words, compacted to the active ones, and where their planes are (unread if never split)
+    Word mask[TARGET_WORDS];
+    const Word* wordPlanes[TARGET_WORDS];
+    for (size_t i = 0; i < alive.activeSize(); ++i) {
+        const size_t w = alive.active()[i];
+        mask[i] = alive.word(w);
+        wordPlanes[i] = planes.planesOf(guessIndex, w);
+    }
+
+    const Splitter splitter{wordPlanes, alive.active(), alive.activeSize(), row, histogram};
+    splitter.split(mask, alive.size(), 0, 0);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "arena.hpp"
+#include "config.hpp"
+#include "entropy.hpp"
+#include "feedback.hpp"
+#include "feedbackMatrix.hpp"
+#include "util.hpp"
+
+/*
+Bit-sliced feedback over targets: bin counting as AND + popcount instead of one gather per alive word.
+
+For every guess, each letter position gets two bit planes over the NUM_TARGETS targets: "green here" and "yellow
+here" (grey is neither). A set of alive targets is a bitset over the same positions. Splitting the alive set by
+position 0, then 1, ... and popcounting the pieces yields every non-empty bin; pieces small enough are finished by
+reading their few rows directly. Only the 64-bit words where the alive set has members are ever touched.
+
+Planes are derived from the rows engines read (fMap.row(guess)[target]), so counts are exactly those of the gather
+path. They cover targets only: fillers are never in an alive target set.
+
+Engines count by gathering unless a bot selects Counting::BITSLICED; bench_bitslice compares the two per alive size.
+*/
+namespace wordle::bitslice {
+    constexpr inline size_t TARGET_WORDS = (config::NUM_TARGETS + 63) / 64;  // 64-bit words per target bitset
+    constexpr inline size_t PLANES_PER_GUESS = 2 * config::WORD_LENGTH;       // Green and yellow per position
+    constexpr inline size_t SHORTCUT_COUNT = 4;                                // Pieces this small read their rows instead of splitting
+
+    // How engines count feedback bins over alive targets
+    enum class Counting : uint8_t { GATHER = 0, BITSLICED };
+
+    using Word = uint64_t;
+    using Bitset = std::array<Word, TARGET_WORDS>;
+
+    /*
+    Green/yellow planes for every guess against every target, NUM_WORDS * PLANES_PER_GUESS * TARGET_WORDS words.
+    The planes of one guess over one 64-target word are contiguous (80 bytes), so a small alive set touches a couple of
+    cache lines per guess and active word.
+    */
+    class PlaneMatrix {
+        std::vector<Word, util::ArenaAllocator<Word, config::CACHE_LINE_SIZE>> planes;
+
+        static constexpr size_t offset(size_t guessIndex, size_t word, size_t position, bool isGreen) noexcept {
+            return (guessIndex * TARGET_WORDS + word) * PLANES_PER_GUESS + position * 2 + static_cast<size_t>(!isGreen);
+        }
+
+    public:
+        explicit PlaneMatrix(const feedback::FeedbackMatrixView& fMap);
+
+        // The PLANES_PER_GUESS planes of guess over targets [64 * word, 64 * word + 64): green, yellow for each position
+        [[nodiscard]] const Word* planesOf(size_t guessIndex, size_t word) const noexcept {
+            return planes.data() + offset(guessIndex, word, 0, true);
+        }
+
+        [[nodiscard]] size_t bytes() const noexcept { return planes.size() * sizeof(Word); }
+    };
+
+    /*
+    Set of alive targets as a bitset, plus the list of its non-zero words.
+    */
+    class AliveSet {
+        Bitset bits{};
+        std::array<uint8_t, TARGET_WORDS> activeWords{};
+        size_t numActive = 0;
+        size_t numTargets = 0;
+
+    public:
+        AliveSet() noexcept = default;
+
+        // Replaces the set with the targets in [first, last), which must be distinct target indices
+        template <std::input_iterator IndexIterator>
+        void assign(IndexIterator first, IndexIterator last) noexcept {
+            bits.fill(0);
+            numTargets = 0;
+            for (auto it = first; it != last; ++it) {
+                const size_t targetIndex = *it;
+                bits[targetIndex / 64] |= Word{1} << (targetIndex % 64);
+                ++numTargets;
+            }
+
+            numActive = 0;
+            for (size_t w = 0; w < TARGET_WORDS; ++w) {
+                activeWords[numActive] = static_cast<uint8_t>(w);
+                numActive += bits[w] != 0;
+            }
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return numTargets; }
+        [[nodiscard]] size_t activeSize() const noexcept { return numActive; }
+        [[nodiscard]] const uint8_t* active() const noexcept { return activeWords.data(); }
+        [[nodiscard]] Word word(size_t w) const noexcept { return bits[w]; }
+    };
+
+    /*
+    Replaces histogram with the bin counts of guessIndex over alive.
+    row is fMap.row(guessIndex), read for pieces of at most SHORTCUT_COUNT targets.
+    */
+    void countBins(const PlaneMatrix& planes, size_t guessIndex, const feedback::Encoding* row, const AliveSet& alive, entropy::SparseHistogram& histogram) noexcept;
+}
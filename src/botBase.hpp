@@ -1,12 +1,22 @@
 #pragma once
 
-#include "vocab.hpp"
+#include "bitSlice.hpp"
+#include "engineContext.hpp"
+#include "entropy.hpp"
 #include "feedback.hpp"
+#include "feedbackMatrix.hpp"
+#include "fingerprint.hpp"
+#include "gameSpec.hpp"
+#include "histogram.hpp"
+#include "lookahead.hpp"
+#include "openingBook.hpp"
 #include "parallelTaskQueue.hpp"
+#include "selection.hpp"
+#include "suggestionCache.hpp"
 #include "vocab.hpp"
 
 namespace wordle::bot {
-    using WordCountT = boost::uint_t<std::bit_width(config::NUM_WORDS - 1)>::least;
+    using WordCountT = histogram::WordIndex;
 
     struct Suggestion {
         double entropy = std::numeric_limits<double>::min();
@@ -15,7 +25,7 @@ namespace wordle::bot {
         bool isValid = false;
     };
 
-    enum class FilterFlag: uint8_t { INVALID_GUESS_AND_FEEDBACK = 0, INVALID_FEEDBACK, INVALID_GUESS, VALID };
+    enum class FilterFlag: uint8_t { INVALID_GUESS_AND_FEEDBACK = 0, INVALID_GUESS, INVALID_FEEDBACK, VALID };  // Bits: guess valid, feedback valid
 
     namespace concepts {
         template <typename T>
@@ -26,48 +36,169 @@ namespace wordle::bot {
     }
 
 
-    struct BotBase {
+    using PruneStats = lookahead::PruneStats;
+
+
+    /*
+    State and helpers shared by the bots of one game spec. The bots borrow an engine::Context, whose matrix, histograms
+    and bit planes are only built for spec::Standard so far, so that is the one spec they can be instantiated for.
+    */
+    template <typename Spec>
+    struct BasicBotBase {
+        static_assert(std::same_as<Spec, spec::Standard>, "the engine context is only built for spec::Standard");
+
     protected:
-        using BinCounts = std::array<WordCountT, wordle::feedback::NUM_FEEDBACKS>;
-        using WordIndexBins = std::vector<std::vector<WordCountT>>;
-        wordle::feedback::FeedbackMap fMap;
-        wordle::vocab::Vocab vocab; 
+        using Encoding = typename Spec::Encoding;
+        using BinCounts = histogram::BinCounts;
+        std::shared_ptr<const wordle::engine::Context> context;  // Immutable vocab and matrix, borrowed from other bots
+        const typename Spec::Vocab& vocab;
+        wordle::feedback::FeedbackMatrixView fMap;  // What the engines read
         wordle::parallel::TaskQueue taskQueue;
+        std::shared_ptr<const wordle::book::OpeningBook> openingBook;  // Optional, shared between bots
+        wordle::book::Cursor bookCursor;
+        std::shared_ptr<wordle::cache::SuggestionCache> suggestionCache;  // Optional, shared between bots
+        uint64_t cacheSalt = 0;
+        wordle::fingerprint::Fingerprint aliveFingerprint = 0;             // Maintained by reset() and filter()
+        wordle::bitslice::Counting counting = wordle::bitslice::Counting::GATHER;
+        const wordle::bitslice::PlaneMatrix* planes = nullptr;             // The context's planes while counting is BITSLICED
+        bool pruning = true;                                               // Bound-based early exits in the depth-2 search
+        lookahead::Plan lookaheadPlan{};                                   // Set by the bots' constructors
+        bool standardLookahead = true;                                     // lookaheadPlan is the built-in two-level search
+        PruneStats pruneStats{};
+        std::mutex pruneMtx;
         
-        BotBase(size_t maxThreads = wordle::config::HARDWARE_CONCURRENCY) :
-        vocab{wordle::vocab::constructVocab()},
-        taskQueue{maxThreads} {
-            this->fMap = wordle::feedback::constructFeedbackMap(vocab, taskQueue, maxThreads);
+        // Borrows the process-wide context for layout
+        BasicBotBase(size_t maxThreads = wordle::config::HARDWARE_CONCURRENCY, wordle::feedback::Layout layout = wordle::feedback::Layout::FLAT) :
+        BasicBotBase{wordle::engine::Context::shared(layout, maxThreads), maxThreads} {}
+
+        // Borrows _context, which must not be null
+        BasicBotBase(std::shared_ptr<const wordle::engine::Context> _context, size_t maxThreads = wordle::config::HARDWARE_CONCURRENCY) :
+        context{requireContext(std::move(_context))},
+        vocab{context->vocab()},
+        fMap{context->view()},
+        taskQueue{maxThreads} {}
+
+        // Reads node's replica of the matrix and keeps this bot's workers on the node's CPUs (see Context::view(node))
+        void placeOn(size_t node) {
+            fMap = context->view(node);
+            taskQueue.threadPool()->pin({wordle::topology::Topology::system().node(node).cpus});
+        }
+
+        static std::shared_ptr<const wordle::engine::Context> requireContext(std::shared_ptr<const wordle::engine::Context> context) {
+            guard::hybridGuard<std::invalid_argument>(context != nullptr, "bots require an engine context");
+            return context;
+        }
+
+        ~BasicBotBase() = default;
+
+        // Serves suggestions from book while games stay on it. Throws if book was built for another configuration.
+        void attachOpeningBook(std::shared_ptr<const wordle::book::OpeningBook> book, wordle::book::Mode mode, size_t beamCandidates) {
+            guard::hybridGuard<std::invalid_argument>(!book || book->matches(mode, beamCandidates, vocab), "opening book was built for another mode, beam width or vocab");
+            openingBook = std::move(book);
+            bookCursor = wordle::book::Cursor{openingBook.get()};
         }
 
-        ~BotBase() = default;
+        // Shares cache with other bots of the same mode and beam width (nullptr detaches)
+        void attachSuggestionCache(std::shared_ptr<wordle::cache::SuggestionCache> cache, wordle::book::Mode mode, size_t beamCandidates) noexcept {
+            suggestionCache = std::move(cache);
+            cacheSalt = (static_cast<uint64_t>(mode) << 32) ^ beamCandidates;
+        }
 
+        // Switches how bins are counted. BITSLICED builds the context's planes on first use, once for all its bots.
+        void selectCounting(wordle::bitslice::Counting mode) {
+            planes = mode == wordle::bitslice::Counting::BITSLICED ? &context->planes() : nullptr;
+            counting = mode;
+        }
 
+        /*
+        Counts the bins of guessIndex over the targets in [start, stop).
+        alive must hold the same targets when counting is BITSLICED, and is ignored otherwise.
+        */
         template <concepts::WordIndexIterator TargetIndexIterator>
-        double baseEntropy(size_t guessIndex, TargetIndexIterator start, TargetIndexIterator stop, BinCounts& binCounts) {
-            const size_t N = std::distance(start, stop);
-            if (N <= 2) return std::max(0.0, static_cast<double>(N) - 1.0);
-            // Clear bin counts
-            binCounts.fill(0);
-
-            // Get bin counts
-            const auto& guessSlice = fMap[guessIndex];
-            for (auto it = start; it != stop; ++it) {
-                size_t targetIndex = *it;
-                size_t fbIndex = guessSlice[targetIndex];
-                ++binCounts[fbIndex];
+        void countTargets(size_t guessIndex, TargetIndexIterator start, TargetIndexIterator stop, const wordle::bitslice::AliveSet& alive, entropy::SparseHistogram& histogram, const Encoding* nextGuessRow = nullptr) {
+            if (planes) {
+                wordle::bitslice::countBins(*planes, guessIndex, fMap.row(guessIndex), alive, histogram);
+            } else {
+                histogram.count(fMap.row(guessIndex), start, stop, nextGuessRow);
+            }
+        }
+
+        // Adds one search worker's counters
+        void recordPruning(const PruneStats& local) {
+            std::lock_guard<std::mutex> lock(pruneMtx);
+            pruneStats += local;
+        }
+
+        // Ends a bin scan at a perfect split, counting the guesses it leaves unscored
+        bool stopScan(const entropy::EntropyMaximizer& best, PruneStats& stats, size_t guessesLeft) const noexcept {
+            return lookahead::stopScan(pruning, best, stats, guessesLeft);
+        }
+
+        // Depth-2 gain of a candidate (see lookahead::expansionGain)
+        template <typename BinSize, typename SearchBin>
+        std::optional<double> depthTwoGain(double depthOne, size_t numBins, size_t numAlive, BinSize&& binSize, SearchBin&& searchBin, const std::atomic<double>& best, PruneStats& stats) {
+            return lookahead::expansionGain(pruning, depthOne, numBins, numAlive, 1, std::forward<BinSize>(binSize), std::forward<SearchBin>(searchBin), best, stats);
+        }
+
+        // Searches plan.depth guesses ahead. Books only record the standard plan; caches key on the plan.
+        void selectLookahead(const lookahead::Plan& plan, size_t beamCandidates) {
+            lookahead::validate(plan);
+            lookaheadPlan = plan;
+            standardLookahead = plan.isStandard(beamCandidates);
+        }
+
+        // Runs a non-standard plan through lookahead::Engine
+        template <bool HardMode>
+        Suggestion lookaheadSearch(std::span<const WordCountT> targets, std::span<const WordCountT> fillers) {
+            PruneStats stats{};
+            const auto best = lookahead::Engine<HardMode>{fMap, lookaheadPlan, pruning}.search(targets, fillers, taskQueue, stats);
+            recordPruning(stats);
+            return {best.value, vocab[best.guessIndex], best.guessIndex, true};
+        }
+
+        // Recorded suggestion for the current game state, if the game is still on the opening book
+        std::optional<Suggestion> bookSuggestion() const {
+            const auto* node = bookCursor.current();
+            if (!node) return std::nullopt;
+            return Suggestion{node->entropy, vocab[node->guess], node->guess, true};
+        }
+
+        // Answers from the opening book (standard plan only), then the suggestion cache, and only then runs search()
+        template <std::invocable Search>
+        Suggestion serve(size_t numAlive, Search&& search) {
+            if (standardLookahead) {
+                if (auto booked = bookSuggestion()) return *booked;
             }
+            if (!suggestionCache) return search();
 
-            // Calculate Entropy of guess
-            double entropy = 0;
-            for (double count : binCounts) {
-                if (count > 0) {
-                    double prob = count / N;
-                    entropy -= prob * std::log2(prob);
-                }
+            const auto key = wordle::fingerprint::salted(aliveFingerprint, standardLookahead ? cacheSalt : cacheSalt ^ lookaheadPlan.salt());
+            if (auto cached = suggestionCache->find(key, numAlive)) {
+                return Suggestion{cached->entropy, vocab[cached->guessIndex], cached->guessIndex, true};
             }
-            return entropy;
+
+            Suggestion suggestion = search();
+            if (suggestion.isValid) {
+                suggestionCache->insert(key, {suggestion.entropy, static_cast<uint32_t>(suggestion.guessIndex), static_cast<uint32_t>(numAlive)});
+            }
+            return suggestion;
+        }
+
+
+        /*
+        Exact entropy of guessIndex over the targets in [start, stop), which must number probabilities.size().
+        alive is as for countTargets(). nextGuessRow (optional) is the row the caller evaluates next; it is prefetched
+        while this one is counted.
+        */
+        template <concepts::WordIndexIterator TargetIndexIterator>
+        double baseEntropy(size_t guessIndex, TargetIndexIterator start, TargetIndexIterator stop, const wordle::bitslice::AliveSet& alive, entropy::SparseHistogram& histogram, const entropy::ProbabilityTable& probabilities, const Encoding* nextGuessRow = nullptr) {
+            const size_t N = std::distance(start, stop);
+            if (N <= 2) return std::max(0.0, static_cast<double>(N) - 1.0);
+
+            countTargets(guessIndex, start, stop, alive, histogram, nextGuessRow);
+            return histogram.exactEntropy(probabilities);
         }
 
     };
+
+    using BotBase = BasicBotBase<spec::Standard>;
 } // namespace wordle::bot
\ No newline at end of file
@@ -5,13 +5,20 @@ namespace wordle::config {
 
     constexpr inline auto TARGET_FILE = "wordle_targets.csv";
     constexpr inline auto FILLER_FILE = "wordle_fillers.csv";
+    constexpr inline auto FEEDBACK_CACHE_FILE = "wordle_feedback.bin";  // Written next to the word lists on first run
+    constexpr inline auto HARD_BOOK_FILE = "wordle_book_hard.bin";      // Written by "book hard"
+    constexpr inline auto EASY_BOOK_FILE = "wordle_book_easy.bin";      // Written by "book easy"
+    constexpr inline auto HARD_SOLVER_FILE = "wordle_solver_hard.bin";  // Solver memo, read and written by "solve hard"
+    constexpr inline auto EASY_SOLVER_FILE = "wordle_solver_easy.bin";  // Solver memo, read and written by "solve easy"
+    constexpr inline auto HARD_STRATEGY_FILE = "wordle_strategy_hard.bin";  // Written by "solve hard", read by "stats hard exact"
+    constexpr inline auto EASY_STRATEGY_FILE = "wordle_strategy_easy.bin";  // Written by "solve easy", read by "stats easy exact"
     constexpr inline size_t ALPHABET_SIZE = 'z' - 'a' + 1;
     constexpr inline size_t WORD_LENGTH = 5;
     constexpr inline size_t NUM_TARGETS = 2315;
     constexpr inline size_t NUM_FILLERS = 10657;
     constexpr inline size_t NUM_WORDS = NUM_TARGETS + NUM_FILLERS;
     constexpr inline size_t CACHE_LINE_SIZE = 128;       // On my architecture, cache line size is 128
-    constexpr inline size_t HARDWARE_CONCURRENCY = 8ul;  // I have 8 cores on my machine
+    constexpr inline size_t HARDWARE_CONCURRENCY = 8ul;  // Beam width and bot threads; the machine's count is topology::hardwareConcurrency()
     constexpr inline bool IS_HARD_MODE = true;
 }
 
@@ -1,11 +1,15 @@
+#include <algorithm>
+#include <atomic>
 #include <memory>
-#include <ranges>
 
 #include "easyBot.hpp"
+#include "profile.hpp"
 
 namespace wordle {
 
-bot::Suggestion wordle::bot::EasyBot::suggest() {
+template <typename Spec>
+bot::Suggestion wordle::bot::BasicEasyBot<Spec>::search() {
+    WORDLE_PROFILE_SCOPE(SEARCH);
     bot::Suggestion suggestion{};
     if (aliveTargets.empty()) return suggestion;
     if (aliveTargets.size() <= 2) {
@@ -15,109 +19,145 @@ bot::Suggestion wordle::bot::EasyBot::suggest() {
         suggestion.isValid = true;
         return suggestion;
     }
+    if (!standardLookahead) return this->template lookaheadSearch<false>(aliveTargets, {});
 
-    size_t threadsAtBarrier = 0;
-    std::condition_variable cv{};
-    std::mutex mtx{};
     std::fill(entropies.begin(), entropies.end(), std::numeric_limits<double>::min());
-    
-    auto worker = [&](size_t threadID, size_t fpStart, size_t fpEnd) {
-        std::array<WordCountT, feedback::NUM_FEEDBACKS> binCounts;
+    const size_t numAlive = aliveTargets.size();
+    const entropy::ProbabilityTable probabilities{numAlive};
+    topCandidates.resize(std::min(numAlive, beamCandidates));  // No wider than the alive set, as in HardBot and the lookahead engine
+    bitslice::AliveSet aliveSet;
+    if (planes) aliveSet.assign(aliveTargets.cbegin(), aliveTargets.cend());
+    std::atomic<double> bestTotal = std::numeric_limits<double>::lowest();  // Best finished depth-2 total, for pruning
+
+    // Step 1: Depth-1 entropy of every guess, split evenly between the threads, each keeping its best
+    auto firstPass = [&](size_t threadID, size_t fpStart, size_t fpEnd) {
+        WORDLE_PROFILE_SCOPE(FIRST_PASS);
+        entropy::SparseHistogram histogram;
+        auto& top = localTop[threadID];
         for (size_t guessIndex = fpStart; guessIndex < fpEnd; ++guessIndex) {
-            binCounts.fill(0);
-            const auto& fpSlice = fMap[guessIndex];
-            for (size_t targetIndex : aliveTargets) {
-                size_t fbIndex = fpSlice[targetIndex];
-                ++binCounts[fbIndex];
-            }
-
-            double entropy = 0;
-            const double numerator = static_cast<double>(aliveTargets.size());
-            for (double count : binCounts) {
-                if (!count) continue;
-                double prob = count / numerator;
-                entropy -= prob * std::log2(prob);
-            }
-
-            entropies[guessIndex] = entropy;
+            const Encoding* nextRow = (guessIndex + 1 < fpEnd) ? fMap.row(guessIndex + 1) : nullptr;
+            countTargets(guessIndex, aliveTargets.cbegin(), aliveTargets.cend(), aliveSet, histogram, nextRow);
+            entropies[guessIndex] = histogram.exactEntropy(probabilities);
+            top.offer(entropies[guessIndex], guessIndex);
         }
+        top.finish();
+    };
 
-        std::unique_lock<std::mutex> lock(mtx);
-        if (++threadsAtBarrier < maxThreads) {
-            cv.wait(lock, [&]() { return threadsAtBarrier >= maxThreads; });
-        } else {
-            constexpr size_t ZERO = 0;
-            constexpr auto guessIt = std::ranges::iota_view{ZERO, wordle::config::NUM_WORDS};
-            std::partial_sort_copy(
-                guessIt.begin(), guessIt.end(),
-                topCandidates.begin(), topCandidates.end(),
-                [&](size_t i, size_t j) { return entropies[i] > entropies[j]; }
-            );
-            cv.notify_all();
-        }
+    constexpr size_t N = Spec::NUM_WORDS;
+    const size_t baseWork = N / maxThreads;
+    const size_t extraWork = N % maxThreads;
+    for (auto& top : localTop) top.reset(topCandidates.size());
+    for (size_t threadID = 0, index = 0; index < N; ++threadID) {
+        size_t stopIndex = index + baseWork + static_cast<size_t>(threadID < extraWork);
+        taskQueue.push(firstPass, threadID, index, stopIndex);
+        index = stopIndex;
+    }
+    {
+        WORDLE_PROFILE_SCOPE(BARRIER);
+        taskQueue.wait();
+    }
 
-        const size_t candidateIndex = topCandidates[threadID];
-        const auto& candidateSlice = fMap[candidateIndex];
-        std::vector<std::vector<WordCountT>> targetBins(wordle::config::NUM_TARGETS);
+    // The beam is the best of the tasks' lists, merged
+    {
+        WORDLE_PROFILE_SCOPE(TOP_CANDIDATES);
+        selection::merge(localTop, topCandidates);
+    }
 
-        binCounts.fill(0);
-        for (size_t targetIndex : aliveTargets) {
-            size_t fbIndex = candidateSlice[targetIndex];
-            ++binCounts[fbIndex];
-        }
-        for (size_t i = 0; i < binCounts.size(); ++i) {
-            targetBins[i].resize(binCounts[i]);
-        }
-        for (WordCountT targetIndex : aliveTargets) {
-            size_t fbIndex = candidateSlice[targetIndex];
-            targetBins[fbIndex].push_back(targetIndex);
+    // Adds a fully searched candidate's depth-2 gain, summed in bin order as the exhaustive search always has.
+    // An abandoned candidate keeps its depth-1 entropy, which is below the best total.
+    auto finish = [&](size_t slot) {
+        auto& expansion = expansions[slot];
+        if (expansion.abandoned.load(std::memory_order_relaxed)) return;
+
+        const auto& bins = candidateBins[slot];
+        double gain = 0.0;
+        for (size_t i = 0; i < Spec::NUM_FEEDBACKS; ++i) {
+            gain += static_cast<double>(bins.binSize(i)) / static_cast<double>(numAlive) * expansion.binValues[i];
         }
+        const size_t candidateIndex = topCandidates[slot];
+        entropies[candidateIndex] += gain;
+        lookahead::raiseBest(bestTotal, entropies[candidateIndex]);
+    };
 
-        double entropyDelta = 0;
-        for (const auto& targets : targetBins) {
-            const double numerator = targets.size();
-            const double weight = numerator / static_cast<double>(aliveTargets.size());
-
-            if (targets.size() <= 2) {
-                entropyDelta += weight * std::max(0.0, static_cast<double>(targets.size() - 1));
-                continue;
-            } 
-
-            double binEntropy = std::numeric_limits<double>::min();
-            for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
-                binCounts.fill(0);
-                const auto& guessSlice = fMap[guessIndex];
-                for (size_t solutionIndex : targets) {
-                    size_t fbIndex = guessSlice[solutionIndex];
-                    ++binCounts[fbIndex];
-                }
+    // Step 2: Split every candidate into one work item per bin of more than 2 targets. Smaller bins are exact already.
+    PruneStats setupStats{};
+    binItems.clear();
+    {
+        WORDLE_PROFILE_SCOPE(CANDIDATE_BINS);
+        BinCounts binCounts;
+        for (size_t slot = 0; slot < topCandidates.size(); ++slot) {
+            auto& bins = candidateBins[slot];
+            auto& expansion = expansions[slot];
+            bins.partition(fMap.row(topCandidates[slot]), aliveTargets.data(), numAlive, binCounts);
+
+            double optimistic = entropies[topCandidates[slot]];
+            size_t binsLeft = 0;
+            for (size_t i = 0; i < Spec::NUM_FEEDBACKS; ++i) {
+                const size_t n = binCounts[i];
+                expansion.binValues[i] = std::max(0.0, static_cast<double>(n) - 1.0);
+                optimistic += static_cast<double>(n) / static_cast<double>(numAlive) * entropy::entropyBound(n);
+                if (n <= 2) continue;
+                binItems.push_back({static_cast<uint32_t>(slot), static_cast<Encoding>(i), static_cast<WordCountT>(n)});
+                ++binsLeft;
+            }
+            expansion.optimistic.store(optimistic, std::memory_order_relaxed);
+            expansion.binsLeft.store(binsLeft, std::memory_order_relaxed);
+            expansion.abandoned.store(false, std::memory_order_relaxed);
+            ++setupStats.candidates;
+            if (binsLeft == 0) finish(slot);
+        }
+    }
+    recordPruning(setupStats);
+
+    // Largest bins first across all candidates, so no thread is left with a big one at the end
+    std::stable_sort(binItems.begin(), binItems.end(), [](const BinItem& a, const BinItem& b) { return a.size > b.size; });
+
+    // Step 3: Threads claim items until none are left. The thread finishing a candidate's last bin adds its gain.
+    std::atomic_size_t nextItem = 0;
+    auto secondPass = [&]() {
+        entropy::SparseHistogram histogram;
+        bitslice::AliveSet binSet;
+        PruneStats stats{};
+
+        for (size_t k = nextItem.fetch_add(1, std::memory_order_relaxed); k < binItems.size(); k = nextItem.fetch_add(1, std::memory_order_relaxed)) {
+            const BinItem item = binItems[k];
+            auto& expansion = expansions[item.slot];
+
+            // Bins still being searched count at their bound, so the optimistic total never undershoots
+            if (pruning && !expansion.abandoned.load(std::memory_order_relaxed) &&
+                expansion.optimistic.load(std::memory_order_relaxed) < bestTotal.load(std::memory_order_relaxed)) {
+                if (!expansion.abandoned.exchange(true, std::memory_order_relaxed)) ++stats.candidatesPruned;
+            }
 
-                double guessEntropy = 0;
-                for (double count : binCounts) {
-                    if (!count) continue;
-                    double prob = count / numerator;
-                    guessEntropy -= prob * std::log2(prob);
+            if (expansion.abandoned.load(std::memory_order_relaxed)) {
+                ++stats.binsSkipped;
+            } else {
+                WORDLE_PROFILE_SCOPE(BIN_ENTROPY);
+                const auto targets = candidateBins[item.slot].bin(item.bin);
+                if (planes) binSet.assign(targets.begin(), targets.end());
+                entropy::EntropyMaximizer binEntropy{targets.size()};
+                ++stats.binScans;
+                for (size_t guessIndex = 0; guessIndex < Spec::NUM_WORDS; ++guessIndex) {
+                    const Encoding* nextRow = (guessIndex + 1 < Spec::NUM_WORDS) ? fMap.row(guessIndex + 1) : nullptr;
+                    countTargets(guessIndex, targets.begin(), targets.end(), binSet, histogram, nextRow);
+                    binEntropy.consider(histogram);
+                    if (stopScan(binEntropy, stats, Spec::NUM_WORDS - guessIndex - 1)) break;
                 }
 
-                binEntropy = std::max(binEntropy, guessEntropy);
+                const double value = binEntropy.value();
+                const double weight = static_cast<double>(item.size) / static_cast<double>(numAlive);
+                expansion.binValues[item.bin] = value;
+                expansion.optimistic.fetch_sub(weight * (entropy::entropyBound(item.size) - value), std::memory_order_relaxed);
             }
 
-            entropyDelta += weight * binEntropy;
+            // Release our bin value to whichever thread finishes the candidate
+            if (expansion.binsLeft.fetch_sub(1, std::memory_order_acq_rel) == 1) finish(item.slot);
         }
-
-        entropies[candidateIndex] += entropyDelta;
+        recordPruning(stats);
     };
-    
-    constexpr size_t N = config::NUM_WORDS;
-    const size_t baseWork = N / maxThreads;
-    const size_t extraWork = N % maxThreads;
-    size_t index = 0;
 
-    for (size_t threadID = 0; index < N; ++threadID) {
-        size_t stopIndex = index + baseWork + static_cast<size_t>(threadID < extraWork);
-        taskQueue.push(worker, threadID, index, stopIndex);
-        index = stopIndex;
-    }
+    const size_t secondPassThreads = std::min(maxThreads, binItems.size());
+    for (size_t threadID = 0; threadID < secondPassThreads; ++threadID) taskQueue.push(secondPass);
     taskQueue.wait();
 
     // Get index of best word and its entropy
@@ -135,4 +175,7 @@ bot::Suggestion wordle::bot::EasyBot::suggest() {
     return {bestEntropy, vocab[bestGuessIndex], bestGuessIndex, true};
 }
 
-}
\ No newline at end of file
+// Pre-instantiated for the specs spec::dispatchWordLength() can pick
+template class bot::BasicEasyBot<spec::Standard>;
+
+}
@@ -1,20 +1,53 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <numeric>
+#include <span>
 
 #include "botBase.hpp"
 
 namespace wordle::bot {
 
-class EasyBot : private BotBase {
+template <typename Spec>
+class BasicEasyBot : private BasicBotBase<Spec> {
     friend struct EasyBotInspector;
 
+    using Base = BasicBotBase<Spec>;
+    using typename Base::Encoding, typename Base::BinCounts;
+    using Base::context, Base::vocab, Base::fMap, Base::taskQueue, Base::bookCursor, Base::aliveFingerprint, Base::counting, Base::planes,
+        Base::pruning, Base::lookaheadPlan, Base::standardLookahead, Base::pruneStats, Base::pruneMtx;
+    using Base::placeOn, Base::attachOpeningBook, Base::attachSuggestionCache, Base::selectCounting, Base::countTargets, Base::recordPruning,
+        Base::stopScan, Base::selectLookahead, Base::lookaheadSearch, Base::serve;
+
+
     std::vector<double> entropies;
     std::vector<WordCountT> aliveTargets;
     std::vector<WordCountT> topCandidates;
     const size_t beamCandidates;
     const size_t maxThreads;
 
+    // Second-pass work item: one bin of one beam candidate, searched by whichever thread claims it
+    struct BinItem {
+        uint32_t slot;  // Index into topCandidates
+        Encoding bin;
+        WordCountT size;
+    };
+
+    // Depth-2 expansion of one beam candidate, shared by the threads searching its bins
+    struct Expansion {
+        std::atomic<double> optimistic;  // Depth-1 entropy, plus searched bins exact and the rest at their bound
+        std::atomic_size_t binsLeft;
+        std::atomic_bool abandoned;
+        std::array<double, Spec::NUM_FEEDBACKS> binValues;
+    };
+
+    // Scratch reused across suggest() calls, so the second pass doesn't allocate in steady state
+    std::vector<histogram::BinPartition> candidateBins;  // Bins of each beam candidate
+    std::vector<Expansion> expansions;                   // One per beam candidate
+    std::vector<BinItem> binItems;
+    std::vector<selection::TopK> localTop;               // Best first-pass guesses of each first-pass task
+
     struct GuessValidation {
         size_t index;
         bool isValid;
@@ -26,28 +59,21 @@ class EasyBot : private BotBase {
 
         // Binary search for word
         auto search = [&](bool searchTargets) { 
-            size_t left = searchTargets ? 0 : wordle::config::NUM_TARGETS;
-            size_t right = searchTargets ? wordle::config::NUM_TARGETS : wordle::config::NUM_WORDS;
+            size_t left = searchTargets ? 0 : Spec::NUM_TARGETS;
+            size_t right = searchTargets ? Spec::NUM_TARGETS : Spec::NUM_WORDS;  // Exclusive
 
-            while (left <= right) {
+            while (left < right) {
                 size_t middle = (left + right) / 2;
                 std::string_view candidate = vocab[middle];
 
-                bool found = true;
-                for (size_t i = 0; i < wordle::config::WORD_LENGTH; ++i) {
-                    char gChar = guess[i];
-                    char cChar = candidate[i];
-
-                    if (gChar == cChar) continue;
-                    found = false;
-                    if (cChar < gChar) {
-                        left = middle + 1;
-                    } else {
-                        right = middle - 1;
-                    }
+                if (candidate < guess) {
+                    left = middle + 1;
+                    continue;
+                }
+                if (guess < candidate) {
+                    right = middle;
+                    continue;
                 }
-
-                if (!found) continue;
 
                 // NOTE: Atomic not necessary due to unique targets and fillers
                 gv.index = middle;
@@ -62,19 +88,44 @@ class EasyBot : private BotBase {
         return gv;
     }
 
+    // Live two-level search over the current alive set
+    Suggestion search();
+
 public:
-    EasyBot(size_t _maxThreads = config::HARDWARE_CONCURRENCY, size_t _beamCandidates = config::HARDWARE_CONCURRENCY)
-    : BotBase{_maxThreads},
-      entropies(config::NUM_WORDS),
+    static constexpr book::Mode BOOK_MODE = book::Mode::EASY;
+
+    BasicEasyBot(size_t _maxThreads = config::HARDWARE_CONCURRENCY, size_t _beamCandidates = config::HARDWARE_CONCURRENCY, feedback::Layout layout = feedback::Layout::FLAT)
+    : Base{_maxThreads, layout},
+      entropies(Spec::NUM_WORDS),
       topCandidates(_beamCandidates),
       beamCandidates{_beamCandidates},
-      maxThreads{_maxThreads} {
+      maxThreads{_maxThreads},
+      candidateBins(_beamCandidates),
+      expansions(_beamCandidates),
+      localTop(_maxThreads) {
+        selectLookahead(lookahead::Plan::standard(beamCandidates), beamCandidates);
+        reset();
+    }
+
+    // Borrows an existing engine context instead of the process-wide one
+    BasicEasyBot(std::shared_ptr<const engine::Context> context, size_t _maxThreads = config::HARDWARE_CONCURRENCY, size_t _beamCandidates = config::HARDWARE_CONCURRENCY)
+    : Base{std::move(context), _maxThreads},
+      entropies(Spec::NUM_WORDS),
+      topCandidates(_beamCandidates),
+      beamCandidates{_beamCandidates},
+      maxThreads{_maxThreads},
+      candidateBins(_beamCandidates),
+      expansions(_beamCandidates),
+      localTop(_maxThreads) {
+        selectLookahead(lookahead::Plan::standard(beamCandidates), beamCandidates);
         reset();
     }
 
     void reset() {
-        aliveTargets.resize(wordle::config::NUM_TARGETS);
+        aliveTargets.resize(Spec::NUM_TARGETS);
         std::iota(aliveTargets.begin(), aliveTargets.end(), 0);
+        bookCursor.reset();
+        aliveFingerprint = fingerprint::ALL_TARGETS;
     }
 
     const auto& getFMap() const noexcept {
@@ -85,29 +136,97 @@ public:
         return vocab;
     }
 
-    Suggestion suggest();
+    const std::shared_ptr<const engine::Context>& getContext() const noexcept {
+        return context;
+    }
+
+    std::span<const WordCountT> getAliveTargets() const noexcept {
+        return aliveTargets;
+    }
+
+    size_t getBeamCandidates() const noexcept {
+        return beamCandidates;
+    }
+
+    // GATHER reads one feedback per alive target, BITSLICED splits bitsets of them (see bitSlice.hpp)
+    void setCounting(bitslice::Counting mode) {
+        selectCounting(mode);
+    }
+
+    bitslice::Counting getCounting() const noexcept {
+        return counting;
+    }
+
+    // Turns bound-based pruning of the depth-2 search on or off. Suggestions are the same either way.
+    void setPruning(bool enabled) noexcept {
+        pruning = enabled;
+    }
+
+    PruneStats getPruneStats() {
+        std::lock_guard<std::mutex> lock(pruneMtx);
+        return pruneStats;
+    }
+
+    // Searches plan.depth guesses ahead with plan.widths candidates per depth (see lookahead.hpp). Plans other than
+    // the standard two-level one bypass opening books. Throws std::invalid_argument for an invalid plan.
+    void setLookahead(const lookahead::Plan& plan) {
+        selectLookahead(plan, beamCandidates);
+    }
+
+    const lookahead::Plan& getLookahead() const noexcept {
+        return lookaheadPlan;
+    }
+
+    // Answers from book until a game leaves it (nullptr detaches). Throws if book was built for another configuration.
+    void useOpeningBook(std::shared_ptr<const book::OpeningBook> book) {
+        attachOpeningBook(std::move(book), BOOK_MODE, beamCandidates);
+    }
+
+    // Reads the matrix replica of NUMA node and keeps suggest() workers on its CPUs (node indexes Topology::system().nodes())
+    void placeOnNode(size_t node) {
+        placeOn(node);
+    }
+
+    // Shares cache across reset() calls, games and bots of the same mode and beam width (nullptr detaches)
+    void useSuggestionCache(std::shared_ptr<cache::SuggestionCache> cache) noexcept {
+        attachSuggestionCache(std::move(cache), BOOK_MODE, beamCandidates);
+    }
+
+    Suggestion suggest() {
+        return serve(aliveTargets.size(), [this] { return search(); });
+    }
+
+    void filter(size_t guessIndex, Encoding fbEncoding) {
+        bookCursor.advance(guessIndex, fbEncoding);
 
-    void filter(size_t guessIndex, wordle::feedback::Encoding fbEncoding) {
         // Filter aliveTargets
         aliveTargets.erase(
             std::remove_if(aliveTargets.begin(), aliveTargets.end(),
-                [guessIndex, fbEncoding, this](WordCountT i) { return this->fMap[i][guessIndex] != fbEncoding; }),
+                [guessIndex, fbEncoding, this](WordCountT i) {
+                    const bool isRemoved = this->fMap[i][guessIndex] != fbEncoding;
+                    aliveFingerprint ^= fingerprint::KEYS[i] & -static_cast<fingerprint::Fingerprint>(isRemoved);
+                    return isRemoved;
+                }),
             aliveTargets.end()
         );
     }
 
     FilterFlag tryFilter(std::string_view guess, std::string_view fbString) {
         auto gv = validateGuess(guess);
-        bool validFeedback = feedback::isValidFeedbackString(fbString);
+        bool validFeedback = feedback::isValidFeedbackString<Spec>(fbString);
 
         uint8_t flagUnderlying = (static_cast<uint8_t>(gv.isValid) << 1u) | static_cast<uint8_t>(validFeedback);
         FilterFlag flag{flagUnderlying};
 
         if (flag == FilterFlag::VALID) {
-            filter(gv.index, feedback::encodeFeedbackString(fbString));
+            filter(gv.index, feedback::__impl::encodeFeedbackString<Spec>(fbString));
         }
         return flag;
     }
 };
 
+extern template class BasicEasyBot<spec::Standard>;
+
+using EasyBot = BasicEasyBot<spec::Standard>;
+
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "embeddedMatrix.hpp"
+#include "feedbackCache.hpp"
+
+#ifdef WORDLE_EMBED_MATRIX
+
+// The matrix image is page aligned (.p2align 12), which keeps its rows PAYLOAD_OFFSET bytes in on cache lines
+static_assert(4096 % wordle::config::CACHE_LINE_SIZE == 0 && wordle::feedback::cache::PAYLOAD_OFFSET % wordle::config::CACHE_LINE_SIZE == 0);
+
+// Mach-O keeps read-only data in __TEXT,__const and prefixes C symbols with an underscore, ELF uses a .rodata section
+#ifdef __APPLE__
+#define WORDLE_EMBEDDED_SECTION "__TEXT,__const"
+#define WORDLE_EMBEDDED_SYMBOL(name) "_" #name
+#else
+#define WORDLE_EMBEDDED_SECTION ".rodata.wordle_embedded, \"a\", @progbits"
+#define WORDLE_EMBEDDED_SYMBOL(name) #name
+#endif
+
+// WORDLE_EMBEDDED_VOCAB_FILE and WORDLE_EMBEDDED_MATRIX_FILE are the generated files' paths, set by CMake
+asm(
+    ".pushsection " WORDLE_EMBEDDED_SECTION "\n"
+    ".p2align 12\n"
+    ".globl " WORDLE_EMBEDDED_SYMBOL(wordle_embedded_matrix) "\n"
+    ".globl " WORDLE_EMBEDDED_SYMBOL(wordle_embedded_matrix_end) "\n"
+    WORDLE_EMBEDDED_SYMBOL(wordle_embedded_matrix) ":\n"
+    ".incbin \"" WORDLE_EMBEDDED_MATRIX_FILE "\"\n"
+    WORDLE_EMBEDDED_SYMBOL(wordle_embedded_matrix_end) ":\n"
+    ".globl " WORDLE_EMBEDDED_SYMBOL(wordle_embedded_vocab) "\n"
+    ".globl " WORDLE_EMBEDDED_SYMBOL(wordle_embedded_vocab_end) "\n"
+    WORDLE_EMBEDDED_SYMBOL(wordle_embedded_vocab) ":\n"
+    ".incbin \"" WORDLE_EMBEDDED_VOCAB_FILE "\"\n"
+    WORDLE_EMBEDDED_SYMBOL(wordle_embedded_vocab_end) ":\n"
+    ".popsection\n"
+);
+
+#undef WORDLE_EMBEDDED_SECTION
+#undef WORDLE_EMBEDDED_SYMBOL
+
+extern "C" {
+    extern const std::byte wordle_embedded_matrix[];
+    extern const std::byte wordle_embedded_matrix_end[];
+    extern const char wordle_embedded_vocab[];
+    extern const char wordle_embedded_vocab_end[];
+}
+
+bool wordle::feedback::embedded::available() noexcept {
+    return true;
+}
+
+std::span<const char> wordle::feedback::embedded::vocabImage() noexcept {
+    return {wordle_embedded_vocab, wordle_embedded_vocab_end};
+}
+
+std::span<const std::byte> wordle::feedback::embedded::matrixImage() noexcept {
+    return {wordle_embedded_matrix, wordle_embedded_matrix_end};
+}
+
+#else
+
+bool wordle::feedback::embedded::available() noexcept {
+    return false;
+}
+
+std::span<const char> wordle::feedback::embedded::vocabImage() noexcept {
+    return {};
+}
+
+std::span<const std::byte> wordle::feedback::embedded::matrixImage() noexcept {
+    return {};
+}
+
+#endif
+
+std::optional<wordle::vocab::Vocab> wordle::feedback::embedded::loadVocab() {
+    const auto image = vocabImage();
+    if (image.size() != wordle::config::NUM_WORDS * wordle::config::WORD_LENGTH) return std::nullopt;
+
+    return wordle::vocab::Vocab::fromLetters(image);
+}
+
+std::optional<wordle::feedback::FeedbackMatrix> wordle::feedback::embedded::loadMatrix(const wordle::vocab::Vocab& vocab) {
+    const auto image = matrixImage();
+    if (!wordle::feedback::cache::isValidImage(image, vocab)) return std::nullopt;
+    return wordle::feedback::FeedbackMatrix::borrowed(reinterpret_cast<const wordle::feedback::Encoding*>(image.data() + wordle::feedback::cache::PAYLOAD_OFFSET));
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+#include "feedbackMatrix.hpp"
+#include "vocab.hpp"
+
+/*
+Vocab and feedback matrix compiled into the binary (CMake option WORDLE_EMBED_MATRIX).
+
+At build time wordle_embed_gen writes the vocab as NUM_WORDS packed WORD_LENGTH-letter words and the matrix as a
+feedback cache file (see feedbackCache.hpp); both are then assembled into a read-only section of every binary that
+links wordle_lib. Serving them needs no CSV parsing, no matrix construction and no file I/O.
+
+Builds without the option embed nothing: the images are empty and the loaders return std::nullopt.
+*/
+namespace wordle::feedback::embedded {
+
+    // Returns true if this build embedded the vocab and matrix
+    [[nodiscard]] bool available() noexcept;
+
+    // Packed words, NUM_WORDS * WORD_LENGTH letters with no separators (empty without the option)
+    [[nodiscard]] std::span<const char> vocabImage() noexcept;
+
+    // Feedback cache image, header included (empty without the option)
+    [[nodiscard]] std::span<const std::byte> matrixImage() noexcept;
+
+    // Unpacks vocabImage(). Returns std::nullopt if nothing was embedded.
+    [[nodiscard]] std::optional<vocab::Vocab> loadVocab();
+
+    // Borrows matrixImage()'s rows. Returns std::nullopt if nothing was embedded or it was built from another vocab.
+    [[nodiscard]] std::optional<FeedbackMatrix> loadMatrix(const vocab::Vocab& vocab);
+
+}  // namespace wordle::feedback::embedded
@@ -0,0 +1,78 @@
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "embeddedMatrix.hpp"
+#include "engineContext.hpp"
+#include "feedbackCache.hpp"
+#include "parallelTaskQueue.hpp"
+#include "topology.hpp"
+
+std::shared_ptr<const wordle::engine::Context> wordle::engine::Context::create(wordle::feedback::Layout layout, size_t numThreads) {
+    // Builds with WORDLE_EMBED_MATRIX start from the binary's own read-only data
+    if (layout == wordle::feedback::Layout::FLAT) {
+        if (auto words = wordle::feedback::embedded::loadVocab()) {
+            if (auto matrix = wordle::feedback::embedded::loadMatrix(*words)) {
+                return std::shared_ptr<const Context>(new Context{std::move(*words), std::move(*matrix)});
+            }
+        }
+    }
+
+    auto words = wordle::vocab::constructVocab();
+    wordle::parallel::TaskQueue queue{numThreads};
+
+    wordle::feedback::FeedbackMatrix matrix;
+    if (layout == wordle::feedback::Layout::FLAT) {
+        matrix = wordle::feedback::cache::loadFeedbackMatrix(words, queue, numThreads);
+    } else {
+        matrix = wordle::feedback::FeedbackMatrix{wordle::feedback::constructFeedbackMap(words, queue, numThreads)};
+    }
+
+    // Private constructor, so no std::make_shared
+    return std::shared_ptr<const Context>(new Context{std::move(words), std::move(matrix)});
+}
+
+std::shared_ptr<const wordle::engine::Context> wordle::engine::Context::shared(wordle::feedback::Layout layout, size_t numThreads) {
+    static std::mutex mtx;
+    static std::array<std::weak_ptr<const Context>, 2> instances;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& instance = instances[static_cast<size_t>(layout)];
+    if (auto context = instance.lock()) return context;
+
+    auto context = create(layout, numThreads);
+    instance = context;
+    return context;
+}
+
+const wordle::bitslice::PlaneMatrix& wordle::engine::Context::planes() const {
+    std::call_once(planesOnce, [this]() { bitPlanes = std::make_unique<const wordle::bitslice::PlaneMatrix>(view()); });
+    return *bitPlanes;
+}
+
+const wordle::feedback::FeedbackMatrixView& wordle::engine::Context::view(size_t node) const {
+    const auto& topology = wordle::topology::Topology::system();
+    guard::hybridGuard<std::invalid_argument>(node < topology.numNodes(), "no such NUMA node");
+    if (topology.numNodes() == 1 || layout() != wordle::feedback::Layout::FLAT) return view();
+
+    std::lock_guard<std::mutex> lock(replicaMtx);
+    if (replicas.empty()) replicas.resize(topology.numNodes());
+    auto& replica = replicas[node];
+    if (replica) return replica->view();
+
+    // Zeroing and copying from a thread on the node makes it the first toucher of every page
+    std::thread builder([&]() {
+        wordle::topology::pinThread(::pthread_self(), topology.node(node).cpus);
+        wordle::feedback::FlatFeedbackMap rows(wordle::config::NUM_WORDS * wordle::feedback::FLAT_STRIDE);
+        std::memcpy(rows.data(), view().data(), rows.size() * sizeof(wordle::feedback::Encoding));
+        replica = std::make_unique<const wordle::feedback::FeedbackMatrix>(std::move(rows));
+    });
+    builder.join();
+    return replica->view();
+}
+
+size_t wordle::engine::Context::numReplicas() const {
+    std::lock_guard<std::mutex> lock(replicaMtx);
+    return std::count_if(replicas.begin(), replicas.end(), [](const auto& replica) { return replica != nullptr; });
+}
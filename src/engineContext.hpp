@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bitSlice.hpp"
+#include "config.hpp"
+#include "feedbackMatrix.hpp"
+#include "vocab.hpp"
+
+/*
+Immutable engine context: the vocab and feedback matrix every bot reads.
+
+Contexts are only handed out as std::shared_ptr<const Context>, so any number of bots (sessions, simulation workers,
+benchmarks) can borrow one and keep only their own mutable state. Context::shared() returns the process-wide context
+for a layout, building it on first use and releasing it once the last bot drops it.
+
+Bit planes for bitslice counting are derived from the matrix on first request, once per context. So are the per-node
+replicas of view(node) on NUMA machines.
+*/
+namespace wordle::engine {
+
+    class Context {
+        vocab::Vocab words;
+        feedback::FeedbackMatrix matrix;
+        mutable std::once_flag planesOnce;
+        mutable std::unique_ptr<const bitslice::PlaneMatrix> bitPlanes;  // Built by the first planes() call
+        mutable std::mutex replicaMtx;
+        mutable std::vector<std::unique_ptr<const feedback::FeedbackMatrix>> replicas;  // Per NUMA node, built by view(node)
+
+        Context(vocab::Vocab _words, feedback::FeedbackMatrix _matrix) noexcept
+        : words{std::move(_words)},
+          matrix{std::move(_matrix)} {}
+
+    public:
+        Context(const Context&) = delete;
+        Context& operator=(const Context&) = delete;
+
+        // Builds a private context (FLAT layout serves the embedded matrix if the build has one, else maps the feedback cache, building it if needed)
+        [[nodiscard]] static std::shared_ptr<const Context> create(
+            feedback::Layout layout = feedback::Layout::FLAT,
+            size_t numThreads = config::HARDWARE_CONCURRENCY
+        );
+
+        // Process-wide context for layout, shared by every caller while any of them holds it
+        [[nodiscard]] static std::shared_ptr<const Context> shared(
+            feedback::Layout layout = feedback::Layout::FLAT,
+            size_t numThreads = config::HARDWARE_CONCURRENCY
+        );
+
+        [[nodiscard]] const vocab::Vocab& vocab() const noexcept { return words; }
+
+        [[nodiscard]] const feedback::FeedbackMatrixView& view() const noexcept { return matrix.view(); }
+
+        /*
+        Rows local to NUMA node (an index into topology::Topology::system().nodes()). With several nodes, FLAT contexts
+        copy the matrix once per node on first request, first-touched by a thread pinned to the node so every page of
+        the copy lives there. Otherwise returns view(). Throws if node doesn't exist.
+        */
+        [[nodiscard]] const feedback::FeedbackMatrixView& view(size_t node) const;
+
+        // Number of node replicas built so far
+        [[nodiscard]] size_t numReplicas() const;
+
+        // Green/yellow planes of view() over targets, built on first use (thread-safe)
+        [[nodiscard]] const bitslice::PlaneMatrix& planes() const;
+
+        [[nodiscard]] feedback::Layout layout() const noexcept { return matrix.layout(); }
+
+        // Returns true if rows are served straight from a mapped cache file
+        [[nodiscard]] bool isMapped() const noexcept { return matrix.isMapped(); }
+
+        [[nodiscard]] size_t matrixBytes() const noexcept { return matrix.bytes(); }
+
+        // Bytes of the matrix actually on huge pages right now (see util::arena)
+        [[nodiscard]] size_t hugePageBytes() const { return matrix.hugePageBytes(); }
+    };
+
+}  // namespace wordle::engine
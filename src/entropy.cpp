@@ -0,0 +1,25 @@
+#include "entropy.hpp"
+#include "guard.hpp"
+
+const std::array<wordle::entropy::Fixed, wordle::entropy::MAX_COUNT + 1>& wordle::entropy::cLogCTable() noexcept {
+    static const auto table = [] {
+        std::array<Fixed, MAX_COUNT + 1> t{};
+        for (size_t c = 2; c <= MAX_COUNT; ++c) {
+            const double value = static_cast<double>(c) * std::log2(static_cast<double>(c));
+            t[c] = static_cast<Fixed>(std::llround(std::ldexp(value, FIXED_BITS)));
+        }
+        return t;
+    }();
+    return table;
+}
+
+wordle::entropy::ProbabilityTable::ProbabilityTable(size_t n) : terms(n + 1) {
+    guard::hybridGuard<std::invalid_argument>(n > 0, "ProbabilityTable requires at least one word");
+
+    // Same expressions as the per-bin loop, so every term is bit for bit what it used to compute
+    for (size_t c = 1; c <= n; ++c) {
+        double count = static_cast<double>(c);
+        double prob = count / n;
+        terms[c] = {prob, std::log2(prob)};
+    }
+}
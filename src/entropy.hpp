@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "config.hpp"
+#include "feedback.hpp"
+#include "histogram.hpp"
+
+/*
+Entropy scoring of feedback histograms.
+
+For N words split into bins of c words each, H = log2(N) - sum(c * log2(c)) / N.
+With N fixed, ranking guesses by H is ranking them by S = sum(c * log2(c)) (lower is better), which is summed here
+in fixed point from a precomputed table, without a log2 per bin.
+
+Reported entropies stay the exact doubles the engines always produced: sum(-p * log2(p)) over non-empty bins in
+ascending bin order. A fixed-point sum is within TIE_TOLERANCE of the exact one, so only guesses whose S is that
+close to the best seen need their exact double, and the maximum comes out bit for bit the same.
+*/
+namespace wordle::entropy {
+    using Fixed = int64_t;
+
+    constexpr inline int FIXED_BITS = 40;                          // c * log2(c) <= 12972 * 13.7, so sums fit in 63 bits
+    constexpr inline Fixed TIE_TOLERANCE = Fixed{1} << 20;         // Far above table rounding (< 2^8) and double error (< 2^14)
+    constexpr inline size_t MAX_COUNT = config::NUM_WORDS;         // Largest bin count the table covers
+    constexpr inline double BOUND_SLACK = 1e-9;                    // Far above the rounding of any exact entropy or weighted sum
+
+    // c * log2(c) * 2^FIXED_BITS, rounded, for every c in [0, MAX_COUNT]
+    const std::array<Fixed, MAX_COUNT + 1>& cLogCTable() noexcept;
+
+    /*
+    Upper bound, plus BOUND_SLACK, on the information depth guesses can expect to gain over n words:
+    log2(min(n, NUM_FEEDBACKS^depth)). At depth 1 it bounds the exact entropy of any histogram of n words.
+    */
+    [[nodiscard]] inline double entropyBound(size_t n, size_t depth = 1) noexcept {
+        if (n <= 1) return 0.0;
+        size_t outcomes = 1;  // Feedback sequences depth guesses can tell apart, once below n
+        for (size_t d = 0; d < depth && outcomes < n; ++d) outcomes *= feedback::NUM_FEEDBACKS;
+        return std::log2(static_cast<double>(std::min(n, outcomes))) + BOUND_SLACK;
+    }
+
+    /*
+    Terms of the exact entropy for a fixed N: probability and its log2 for every count in [0, N].
+    Building one costs N log2 calls, so it pays off when many guesses are scored against the same words.
+    */
+    class ProbabilityTable {
+        struct Term {
+            double prob;
+            double log2Prob;
+        };
+
+        std::vector<Term> terms;
+
+    public:
+        explicit ProbabilityTable(size_t n);
+
+        [[nodiscard]] size_t size() const noexcept { return terms.size() - 1; }
+
+        [[nodiscard]] const Term& operator[](size_t count) const noexcept { return terms[count]; }
+    };
+
+    /*
+    Feedback histogram that remembers which bins it touched, so scoring and resetting cost O(touched) instead of
+    O(NUM_FEEDBACKS). Small inputs count straight into the touched list, large ones go through histogram::countBins.
+    */
+    class SparseHistogram {
+        histogram::BinCounts counts{};
+        std::array<feedback::Encoding, feedback::NUM_FEEDBACKS + 1> touched{};  // One spare slot for the branch-free append
+        size_t numTouched = 0;
+        bool sorted = true;
+
+        // Collects non-empty bins after a full overwrite of counts
+        void collectTouched() noexcept {
+            numTouched = 0;
+            for (size_t bin = 0; bin < feedback::NUM_FEEDBACKS; ++bin) {
+                touched[numTouched] = static_cast<feedback::Encoding>(bin);
+                numTouched += counts[bin] != 0;
+            }
+            sorted = true;
+        }
+
+        // Exact entropies sum in ascending bin order, like a full pass over counts would
+        void sortTouched() noexcept {
+            if (sorted) return;
+            std::sort(touched.begin(), touched.begin() + numTouched);
+            sorted = true;
+        }
+
+    public:
+        void clear() noexcept {
+            for (size_t i = 0; i < numTouched; ++i) counts[touched[i]] = 0;
+            numTouched = 0;
+            sorted = true;
+        }
+
+        // Adds count words to bin (for producers other than count(), e.g. bitslice::countBins)
+        void add(feedback::Encoding bin, histogram::WordIndex count) noexcept {
+            touched[numTouched] = bin;
+            numTouched += counts[bin] == 0;
+            counts[bin] += count;
+            sorted = sorted && (numTouched <= 1 || touched[numTouched - 2] < touched[numTouched - 1]);
+        }
+
+        // Replaces the histogram with that of row[*it] for it in [first, last). nextRow is prefetched for large inputs.
+        template <std::random_access_iterator IndexIterator>
+        void count(const feedback::Encoding* row, IndexIterator first, IndexIterator last, const feedback::Encoding* nextRow = nullptr) noexcept {
+            const size_t n = std::distance(first, last);
+            if constexpr (std::contiguous_iterator<IndexIterator> && std::same_as<std::iter_value_t<IndexIterator>, histogram::WordIndex>) {
+                if (n >= histogram::SMALL_INPUT) {
+                    histogram::countBins(row, std::to_address(first), n, counts, nextRow);
+                    collectTouched();
+                    return;
+                }
+            }
+
+            clear();
+            for (auto it = first; it != last; ++it) {
+                const feedback::Encoding bin = row[*it];
+                touched[numTouched] = bin;
+                numTouched += counts[bin]++ == 0;
+            }
+            sorted = numTouched <= 1;
+        }
+
+        // Ranking key: sum(c * log2(c)) in fixed point. Lower means higher entropy for the same N.
+        [[nodiscard]] Fixed fixedSum() const noexcept {
+            const auto& table = cLogCTable();
+            Fixed sum = 0;
+            for (size_t i = 0; i < numTouched; ++i) sum += table[counts[touched[i]]];
+            return sum;
+        }
+
+        // Exact entropy of n counted words
+        [[nodiscard]] double exactEntropy(size_t n) noexcept {
+            sortTouched();
+            double entropy = 0;
+            for (size_t i = 0; i < numTouched; ++i) {
+                double count = counts[touched[i]];
+                double prob = count / n;
+                entropy -= prob * std::log2(prob);
+            }
+            return entropy;
+        }
+
+        // Exact entropy of table.size() counted words, without calling log2
+        [[nodiscard]] double exactEntropy(const ProbabilityTable& table) noexcept {
+            sortTouched();
+            double entropy = 0;
+            for (size_t i = 0; i < numTouched; ++i) {
+                const auto& term = table[counts[touched[i]]];
+                entropy -= term.prob * term.log2Prob;
+            }
+            return entropy;
+        }
+
+        [[nodiscard]] const histogram::BinCounts& binCounts() const noexcept { return counts; }
+
+        [[nodiscard]] size_t touchedBins() const noexcept { return numTouched; }
+    };
+
+    /*
+    Running maximum of exact entropies over histograms of the same n words.
+    Histograms are screened by fixedSum(); exact entropies are only computed within TIE_TOLERANCE of the best sum.
+    */
+    class EntropyMaximizer {
+        size_t n;
+        Fixed bestSum = std::numeric_limits<Fixed>::max();
+        double best = std::numeric_limits<double>::min();
+
+    public:
+        explicit EntropyMaximizer(size_t _n) noexcept : n{_n} {}
+
+        void consider(SparseHistogram& histogram) noexcept {
+            const Fixed sum = histogram.fixedSum();
+            if (sum - TIE_TOLERANCE > bestSum) return;
+            bestSum = std::min(bestSum, sum);
+            best = std::max(best, histogram.exactEntropy(n));
+        }
+
+        // Same value as std::max over every considered exact entropy, starting from numeric_limits<double>::min()
+        [[nodiscard]] double value() const noexcept { return best; }
+
+        /*
+        True once a histogram of all singletons was considered. No histogram of n words scores higher, and any other
+        all-singleton histogram sums the same n terms, so the remaining guesses can't change value().
+        */
+        [[nodiscard]] bool isSaturated() const noexcept { return bestSum == 0; }
+    };
+}
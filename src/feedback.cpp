@@ -1,15 +1,70 @@
+#include <cstring>
+
 #include "config.hpp"
 #include "feedback.hpp"
 
+template <typename Spec>
+wordle::feedback::__impl::BasicBatchEncoder<Spec>::BasicBatchEncoder(const typename Spec::Vocab& vocab) : numWords{vocab.size()} {
+    const size_t numBlocks = (numWords + LANES - 1) / LANES;
+    for (auto& plane : planes) plane.assign(numBlocks, Lanes{});
+
+    for (size_t w = 0; w < numWords; ++w) {
+        for (size_t position = 0; position < Spec::WORD_LENGTH; ++position) {
+            planes[position][w / LANES][w % LANES] = static_cast<unsigned char>(vocab[w][position]);
+        }
+    }
+}
+
+template <typename Spec>
+void wordle::feedback::__impl::BasicBatchEncoder<Spec>::operator()(std::string_view guess, Encoding* row) const noexcept {
+    constexpr size_t L = Spec::WORD_LENGTH;
+    constexpr auto& multipliers = multipliersFor<L>;
+    const size_t numBlocks = planes[0].size();
+
+    for (size_t block = 0; block < numBlocks; ++block) {
+        Lanes letters[L];
+        for (size_t j = 0; j < L; ++j) letters[j] = planes[j][block];
+
+        // Step 1: Greens, and which solution letters are left unmatched by them (all bits set for true)
+        Lanes green[L];
+        Lanes unmatched[L];
+        Lanes encoding{};
+        for (size_t i = 0; i < L; ++i) {
+            green[i] = reinterpret_cast<Lanes>(letters[i] == static_cast<Encoding>(static_cast<unsigned char>(guess[i])));
+            unmatched[i] = ~green[i];
+            encoding += green[i] & static_cast<Encoding>(CORRECT * multipliers[i]);
+        }
+
+        // Step 2: Yellow where the guess letter still has an unmatched copy after the yellows left of it took theirs
+        Lanes yellow[L];
+        for (size_t i = 0; i < L; ++i) {
+            const auto letter = static_cast<Encoding>(static_cast<unsigned char>(guess[i]));
+            Lanes available{};
+            for (size_t j = 0; j < L; ++j) {
+                available += reinterpret_cast<Lanes>(letters[j] == letter) & unmatched[j] & 1;
+            }
+            Lanes taken{};
+            for (size_t k = 0; k < i; ++k) {
+                if (guess[k] == guess[i]) taken += yellow[k] & 1;
+            }
+            yellow[i] = ~green[i] & reinterpret_cast<Lanes>(available > taken);
+            encoding += yellow[i] & static_cast<Encoding>(WRONG_POSITION * multipliers[i]);
+        }
+
+        // Step 3: Store the block, or the words left in the last one
+        const size_t first = block * LANES;
+        std::memcpy(row + first, &encoding, std::min(LANES, numWords - first) * sizeof(Encoding));
+    }
+}
+
+// Pre-instantiated for the specs spec::dispatchWordLength() can pick
+template class wordle::feedback::__impl::BasicBatchEncoder<wordle::spec::Standard>;
+
 wordle::feedback::FeedbackMap wordle::feedback::constructFeedbackMapBasic(const wordle::vocab::Vocab& vocab) {
     wordle::feedback::FeedbackMap fMap(wordle::config::NUM_WORDS, std::vector<wordle::feedback::Encoding>(wordle::config::NUM_WORDS));
-    wordle::feedback::Encoder encoder{};
+    const wordle::feedback::BatchEncoder encoder{vocab};
     for (size_t i = 0; i < wordle::config::NUM_WORDS; ++i) {
-        std::string_view guess = vocab[i];
-        auto& fSlice = fMap[i];
-        for (size_t j = 0; j < wordle::config::NUM_WORDS; ++j) {
-            fSlice[j] = encoder(guess, vocab[j]);
-        }
+        encoder(vocab[i], fMap[i].data());
     }
     return fMap;
 }
@@ -17,24 +72,21 @@ wordle::feedback::FeedbackMap wordle::feedback::constructFeedbackMapBasic(const
 wordle::feedback::FeedbackMap wordle::feedback::constructFeedbackMap(const wordle::vocab::Vocab& vocab, wordle::parallel::TaskQueue& queue, size_t numThreads) {
     constexpr size_t ENCODING_SIZE = sizeof(wordle::feedback::Encoding);
     constexpr size_t PADS = (wordle::config::NUM_WORDS * ENCODING_SIZE + wordle::config::CACHE_LINE_SIZE - 1) / wordle::config::CACHE_LINE_SIZE;
+    static_assert(PADS >= wordle::feedback::ROW_PADDING);
 
     wordle::feedback::FeedbackMap fMap(wordle::config::NUM_WORDS, std::vector<wordle::feedback::Encoding>(wordle::config::NUM_WORDS + PADS));
 
     constexpr size_t numJobs = wordle::config::NUM_WORDS;
     const size_t baseWork = numJobs / numThreads;
     const size_t extraWork = numJobs % numThreads;
+    const wordle::feedback::BatchEncoder encoder{vocab};  // Read-only, shared by every job
     size_t threadID = 0;
     for (size_t start = 0; start < numJobs; ++threadID) {
         size_t newStart = start + baseWork + static_cast<size_t>(threadID < extraWork);
         queue.push(
-            [&vocab, &fMap, start, newStart]() {
-                thread_local wordle::feedback::Encoder encoder{};
+            [&vocab, &fMap, &encoder, start, newStart]() {
                 for (size_t guessIndex = start; guessIndex < newStart; ++guessIndex) {
-                    auto& fMapSlice = fMap[guessIndex];
-                    std::string_view guess = vocab[guessIndex];
-                    for (size_t solutionIndex = 0; solutionIndex < wordle::config::NUM_WORDS; ++solutionIndex) {
-                        fMapSlice[solutionIndex] = encoder(guess, vocab[solutionIndex]);
-                    }
+                    encoder(vocab[guessIndex], fMap[guessIndex].data());
                 }
             }
         );
@@ -53,15 +105,14 @@ wordle::feedback::FlatFeedbackMap wordle::feedback::constructFlatFeedbackMap(
     // Choose number of jobs based on number of threads (e.g., fewer than threads if work is heavy)
     const size_t totalWords = wordle::config::NUM_WORDS;
 
-    // Padded stride to avoid false sharing (align each row to 64 bytes)
-    constexpr size_t CACHE_LINE_SIZE = wordle::config::CACHE_LINE_SIZE;
-    constexpr size_t ENCODING_SIZE = sizeof(wordle::feedback::Encoding);
-    const size_t stride = ((totalWords * ENCODING_SIZE + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * (CACHE_LINE_SIZE / ENCODING_SIZE);
+    // Padded stride to avoid false sharing (each row spans whole cache lines)
+    constexpr size_t stride = wordle::feedback::FLAT_STRIDE;
 
     // Flat map: contiguous and cache-aligned
-    std::vector<wordle::feedback::Encoding> flatMap(totalWords * stride);
+    wordle::feedback::FlatFeedbackMap flatMap(totalWords * stride);
 
-    // Dispatch encoding jobs
+    // Dispatch encoding jobs, sharing one read-only encoder
+    const wordle::feedback::BatchEncoder encoder{vocab};
     const size_t baseWork = totalWords / numThreads;
     const size_t extraWork = totalWords % numThreads;
 
@@ -70,14 +121,9 @@ wordle::feedback::FlatFeedbackMap wordle::feedback::constructFlatFeedbackMap(
         const size_t workSize = baseWork + static_cast<size_t>(threadID < extraWork);
         const size_t stop = start + workSize;
 
-        queue.push([start, stop, &flatMap, &vocab]() {
-            thread_local wordle::feedback::Encoder encoder{};
+        queue.push([start, stop, &flatMap, &vocab, &encoder]() {
             for (size_t guessIndex = start; guessIndex < stop; ++guessIndex) {
-                const std::string_view guess = vocab[guessIndex];
-                wordle::feedback::Encoding* row = &flatMap[guessIndex * stride];
-                for (size_t solutionIndex = 0; solutionIndex < wordle::config::NUM_WORDS; ++solutionIndex) {
-                    row[solutionIndex] = encoder(guess, vocab[solutionIndex]);
-                }
+                encoder(vocab[guessIndex], &flatMap[guessIndex * stride]);
             }
         });
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "arena.hpp"
 #include "config.hpp"
+#include "gameSpec.hpp"
 #include "parallelTaskQueue.hpp"
 #include "util.hpp"
 #include "vocab.hpp"
@@ -13,10 +15,16 @@ namespace wordle::feedback::position {
 }  // namespace wordle::feedback::position
 
 namespace wordle::feedback {
-    constexpr inline size_t NUM_FEEDBACKS = wordle::util::constevalPow(3ul, config::WORD_LENGTH);  // Number of unique wordle feedbacks
-    using Encoding = boost::uint_t<std::bit_width(NUM_FEEDBACKS - 1)>::least;                      // Smallest type that can represent all unique wordle feedbacks
+    constexpr inline size_t NUM_FEEDBACKS = spec::Standard::NUM_FEEDBACKS;  // Number of unique wordle feedbacks
+    using Encoding = spec::Standard::Encoding;                             // Smallest type that can represent all unique wordle feedbacks
     using FeedbackMap = std::vector<std::vector<Encoding>>;
-    using FlatFeedbackMap = std::vector<Encoding>;
+    using FlatFeedbackMap = std::vector<Encoding, util::ArenaAllocator<Encoding, config::CACHE_LINE_SIZE>>;  // Rows start on cache lines, huge pages where available
+
+    // Row stride of a FlatFeedbackMap, padded so every row spans whole cache lines
+    constexpr inline size_t FLAT_STRIDE = ((config::NUM_WORDS * sizeof(Encoding) + config::CACHE_LINE_SIZE - 1) / config::CACHE_LINE_SIZE) * (config::CACHE_LINE_SIZE / sizeof(Encoding));
+
+    // Readable Encodings past NUM_WORDS at the end of every row built by constructFlatFeedbackMap or constructFeedbackMap
+    constexpr inline size_t ROW_PADDING = FLAT_STRIDE - config::NUM_WORDS;
 
     // Variations of function implementations for Encoder
     namespace __impl {
@@ -25,10 +33,11 @@ namespace wordle::feedback {
         constexpr inline Encoding CORRECT = 2;
         constexpr inline Encoding BASE = 3;
 
-        // Returns mulipliers for Encoding
-        consteval inline std::array<Encoding, config::WORD_LENGTH> initMultipliers() {
-            std::array<Encoding, config::WORD_LENGTH> multipliers{};
-            Encoding multiplier = 1;
+        // Returns mulipliers for encoding words of WordLength letters
+        template <size_t WordLength>
+        consteval inline std::array<spec::EncodingFor<WordLength>, WordLength> initMultipliers() {
+            std::array<spec::EncodingFor<WordLength>, WordLength> multipliers{};
+            spec::EncodingFor<WordLength> multiplier = 1;
             for (size_t i = 0; i < multipliers.size(); ++i) {
                 multipliers[i] = multiplier;
                 multiplier *= BASE;
@@ -37,20 +46,37 @@ namespace wordle::feedback {
         }
 
         // Multipliers for encoding
-        constexpr inline std::array<Encoding, config::WORD_LENGTH> multipliers = initMultipliers();
+        template <size_t WordLength>
+        constexpr inline std::array<spec::EncodingFor<WordLength>, WordLength> multipliersFor = initMultipliers<WordLength>();
+
+        constexpr inline std::array<Encoding, config::WORD_LENGTH> multipliers = multipliersFor<config::WORD_LENGTH>;
 
         // Returns 0 (currently), but just adding in case I change encoding values for robustness
-        consteval inline Encoding encodeAsExhausted() {
-            Encoding encoding = 0;
-            for (size_t i = 0; i < multipliers.size(); ++i) {
-                encoding += EXHAUSTED * multipliers[i];
+        template <typename Spec = spec::Standard>
+        consteval inline typename Spec::Encoding encodeAsExhausted() {
+            typename Spec::Encoding encoding = 0;
+            for (size_t i = 0; i < Spec::WORD_LENGTH; ++i) {
+                encoding += EXHAUSTED * multipliersFor<Spec::WORD_LENGTH>[i];
+            }
+            return encoding;
+        }
+
+        // Feedback of a guess that is the solution
+        template <typename Spec = spec::Standard>
+        consteval inline typename Spec::Encoding encodeAsCorrect() {
+            typename Spec::Encoding encoding = 0;
+            for (size_t i = 0; i < Spec::WORD_LENGTH; ++i) {
+                encoding += CORRECT * multipliersFor<Spec::WORD_LENGTH>[i];
             }
             return encoding;
         }
 
-        struct ArrEncoder {
+        template <typename Spec>
+        struct BasicArrEncoder {
+            using Encoding = typename Spec::Encoding;
+
         protected:
-            using Count = boost::uint_t<std::bit_width(wordle::config::WORD_LENGTH)>::least;
+            using Count = boost::uint_t<std::bit_width(Spec::WORD_LENGTH)>::least;
             std::array<Count, wordle::config::ALPHABET_SIZE> unmatchedCounts{};
 
             [[nodiscard]] constexpr Count& getCount(char letter) {
@@ -66,15 +92,16 @@ namespace wordle::feedback {
             }
 
         public:
-            constexpr ArrEncoder() noexcept = default;
-            ~ArrEncoder() noexcept = default;
+            constexpr BasicArrEncoder() noexcept = default;
+            ~BasicArrEncoder() noexcept = default;
 
             [[nodiscard]] Encoding operator()(std::string_view guess, std::string_view solution) {
-                Encoding encoding = encodeAsExhausted();
+                constexpr auto& multipliers = multipliersFor<Spec::WORD_LENGTH>;
+                Encoding encoding = encodeAsExhausted<Spec>();
                 resetUnmatchedCounts();  // Reset counts
 
                 // Step 1: Add CORRECT to encoding and update solution counts
-                for (size_t i = 0; i < config::WORD_LENGTH; ++i) {
+                for (size_t i = 0; i < Spec::WORD_LENGTH; ++i) {
                     char solutionLetter = solution[i];
                     bool isCorrect = guess[i] == solutionLetter;
                     encoding += (CORRECT * multipliers[i] * static_cast<Encoding>(isCorrect));
@@ -82,7 +109,7 @@ namespace wordle::feedback {
                 }
                 
                 // Step 2: Add WRONG_POSITION to encoding and update solution counts
-                for (size_t i = 0; i < config::WORD_LENGTH; ++i) {
+                for (size_t i = 0; i < Spec::WORD_LENGTH; ++i) {
                     char guessLetter = guess[i];
                     Count& count = getCount(guessLetter);
                     bool isWrongPosition = (solution[i] != guessLetter) && (count > 0);
@@ -93,28 +120,89 @@ namespace wordle::feedback {
             }
         };
 
-        [[nodiscard]] constexpr inline Encoding encodeFeedbackString(std::string_view fbString) {
-            wordle::guard::hybridGuard(fbString.size() == wordle::config::WORD_LENGTH, "fbString is not expected size");
-            Encoding encoding = 0;
+        using ArrEncoder = BasicArrEncoder<spec::Standard>;
+
+        // 32-byte GCC vector of Lane (GCC drops vector_size from dependent types, so each lane type is spelled out)
+        template <typename Lane>
+        struct VectorOf;
+
+        template <>
+        struct VectorOf<uint8_t> { typedef uint8_t type __attribute__((vector_size(32))); };
+
+        template <>
+        struct VectorOf<uint16_t> { typedef uint16_t type __attribute__((vector_size(32))); };
+
+        /*
+        Scores one guess against a whole vocab at once. Words are stored as one plane per letter position (structure
+        of arrays, LANES words per block, padded with zeros that match no letter), so ArrEncoder's per-pair logic runs
+        on whole blocks through GCC vector extensions: compares of the guess letters against the planes find greens
+        and unmatched letters, and repeated guess letters use them up left to right exactly as ArrEncoder's counts do.
+        A block is one 32-byte register under -march=native: 32 words with one-byte encodings, 16 with two-byte ones.
+
+        Instantiated in feedback.cpp for the specs spec::dispatchWordLength() can pick.
+        */
+        template <typename Spec>
+        class BasicBatchEncoder {
+        public:
+            using Encoding = typename Spec::Encoding;
+            static constexpr size_t LANES = 32 / sizeof(Encoding);
+            using Lanes = typename VectorOf<Encoding>::type;
+
+        private:
+            std::array<std::vector<Lanes>, Spec::WORD_LENGTH> planes;  // planes[position][block]
+            size_t numWords = 0;
+
+        public:
+            explicit BasicBatchEncoder(const typename Spec::Vocab& vocab);
+
+            [[nodiscard]] size_t size() const noexcept { return numWords; }
+
+            // Writes the encoding of guess against every word to row[0, size()). Thread-safe.
+            void operator()(std::string_view guess, Encoding* row) const noexcept;
+        };
+
+        extern template class BasicBatchEncoder<spec::Standard>;
+
+        using BatchEncoder = BasicBatchEncoder<spec::Standard>;
+
+        template <typename Spec = spec::Standard>
+        [[nodiscard]] constexpr inline typename Spec::Encoding encodeFeedbackString(std::string_view fbString) {
+            wordle::guard::hybridGuard(fbString.size() == Spec::WORD_LENGTH, "fbString is not expected size");
+            typename Spec::Encoding encoding = 0;
             
-            for (size_t i = 0; i < wordle::config::WORD_LENGTH; ++i) {
-                Encoding pf;
+            for (size_t i = 0; i < Spec::WORD_LENGTH; ++i) {
+                typename Spec::Encoding pf;
                 switch (fbString[i]) {
                     case (wordle::feedback::position::CORRECT) : pf = CORRECT; break;
                     case (wordle::feedback::position::EXHAUSTED) : pf = EXHAUSTED; break;
                     case (wordle::feedback::position::WRONG_POSITION) : pf = WRONG_POSITION; break;
                     default : wordle::guard::hybridError("invalid character encountered in fbString");
                 }
-                encoding += (pf * multipliers[i]);
+                encoding += (pf * multipliersFor<Spec::WORD_LENGTH>[i]);
             }
             return encoding;
         }
 
-        
+        // Inverse of encodeFeedbackString (encoding must be below Spec::NUM_FEEDBACKS)
+        template <typename Spec = spec::Standard>
+        [[nodiscard]] inline std::string decodeFeedbackString(typename Spec::Encoding encoding) {
+            std::string fbString(Spec::WORD_LENGTH, wordle::feedback::position::EXHAUSTED);
+            size_t remaining = encoding;
+            for (size_t i = 0; i < Spec::WORD_LENGTH; ++i, remaining /= BASE) {
+                switch (remaining % BASE) {
+                    case CORRECT : fbString[i] = wordle::feedback::position::CORRECT; break;
+                    case WRONG_POSITION : fbString[i] = wordle::feedback::position::WRONG_POSITION; break;
+                    default : break;
+                }
+            }
+            return fbString;
+        }
+
     }  // namespace __impl
 
+    template <typename Spec = spec::Standard>
     constexpr inline bool isValidFeedbackString(std::string_view fbString) {
-        if (fbString.size() != wordle::config::WORD_LENGTH) return false;
+        if (fbString.size() != Spec::WORD_LENGTH) return false;
         auto pred = [](char c) noexcept -> bool { return c == position::CORRECT || c == position::EXHAUSTED || c == position::WRONG_POSITION; };
         return std::all_of(fbString.begin(), fbString.end(), pred);
     }
@@ -123,6 +211,14 @@ namespace wordle::feedback {
     FeedbackMap constructFeedbackMap(const wordle::vocab::Vocab& vocab, wordle::parallel::TaskQueue& queue, size_t numThreads = wordle::config::HARDWARE_CONCURRENCY);
     FlatFeedbackMap constructFlatFeedbackMap(const wordle::vocab::Vocab& vocab, wordle::parallel::TaskQueue& queue, size_t numThreads = wordle::config::HARDWARE_CONCURRENCY);
     using Encoder = __impl::ArrEncoder;
-    inline auto encodeFeedbackString = __impl::encodeFeedbackString;
+    using BatchEncoder = __impl::BatchEncoder;  // What the construct functions use
+
+    // Encoders of any spec (the batch encoder is only instantiated for the ones spec::dispatchWordLength() can pick)
+    template <typename Spec>
+    using BasicEncoder = __impl::BasicArrEncoder<Spec>;
+    template <typename Spec>
+    using BasicBatchEncoder = __impl::BasicBatchEncoder<Spec>;
+    inline auto encodeFeedbackString = __impl::encodeFeedbackString<>;
+    inline auto decodeFeedbackString = __impl::decodeFeedbackString<>;
     
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "feedbackCache.hpp"
+
+uint64_t wordle::feedback::cache::vocabChecksum(const wordle::vocab::Vocab& vocab) noexcept {
+    constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+    uint64_t hash = FNV_OFFSET;
+    auto mix = [&hash](unsigned char byte) noexcept {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    };
+
+    for (std::string_view word : vocab) {
+        for (char c : word) mix(static_cast<unsigned char>(c));
+        mix('\n');  // Word separator keeps "ab","c" distinct from "a","bc"
+    }
+    return hash;
+}
+
+wordle::feedback::cache::Header wordle::feedback::cache::makeHeader(const wordle::vocab::Vocab& vocab) noexcept {
+    return {
+        MAGIC,
+        FORMAT_VERSION,
+        static_cast<uint32_t>(sizeof(wordle::feedback::Encoding)),
+        wordle::config::NUM_WORDS,
+        wordle::config::WORD_LENGTH,
+        wordle::feedback::NUM_FEEDBACKS,
+        wordle::feedback::FLAT_STRIDE,
+        PAYLOAD_OFFSET,
+        vocabChecksum(vocab)
+    };
+}
+
+bool wordle::feedback::cache::writeFeedbackCache(std::string_view path, const wordle::vocab::Vocab& vocab, const wordle::feedback::FlatFeedbackMap& flatMap) {
+    if (flatMap.size() * sizeof(wordle::feedback::Encoding) != PAYLOAD_SIZE) return false;
+
+    const std::filesystem::path target{path};
+    std::filesystem::path temporary{target};
+    temporary += ".tmp";
+
+    // Step 1: Write header, padding and payload to a temporary file
+    {
+        std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+        if (!file) return false;
+
+        const Header header = makeHeader(vocab);
+        std::array<char, PAYLOAD_OFFSET> prefix{};
+        std::memcpy(prefix.data(), &header, sizeof(Header));
+
+        file.write(prefix.data(), prefix.size());
+        file.write(reinterpret_cast<const char*>(flatMap.data()), static_cast<std::streamsize>(PAYLOAD_SIZE));
+        if (!file.flush()) {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+    }
+
+    // Step 2: Atomically replace any existing cache (readers keep their old mapping alive)
+    std::error_code ec;
+    std::filesystem::rename(temporary, target, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+bool wordle::feedback::cache::isValidImage(std::span<const std::byte> image, const wordle::vocab::Vocab& vocab) noexcept {
+    if (image.size() < PAYLOAD_OFFSET + PAYLOAD_SIZE) return false;
+
+    Header header;
+    std::memcpy(&header, image.data(), sizeof(Header));
+
+    const Header expected = makeHeader(vocab);
+    return header.magic == expected.magic
+        && header.version == expected.version
+        && header.encodingSize == expected.encodingSize
+        && header.numWords == expected.numWords
+        && header.wordLength == expected.wordLength
+        && header.numFeedbacks == expected.numFeedbacks
+        && header.stride == expected.stride
+        && header.payloadOffset == expected.payloadOffset
+        && header.vocabChecksum == expected.vocabChecksum;
+}
+
+std::optional<wordle::feedback::FeedbackMatrix> wordle::feedback::cache::openFeedbackCache(std::string_view path, const wordle::vocab::Vocab& vocab) {
+    auto file = wordle::util::MappedFile::open(path);
+    if (!file.isOpen() || !isValidImage(file.bytes(), vocab)) return std::nullopt;
+
+    return wordle::feedback::FeedbackMatrix{std::move(file), PAYLOAD_OFFSET};
+}
+
+wordle::feedback::FeedbackMatrix wordle::feedback::cache::loadFeedbackMatrix(
+    const wordle::vocab::Vocab& vocab,
+    wordle::parallel::TaskQueue& queue,
+    size_t numThreads,
+    std::string_view path
+) {
+    // Warm start: serve the mapped file directly
+    if (auto cached = openFeedbackCache(path, vocab)) return std::move(*cached);
+
+    // Cold start: build, persist, then prefer the shared mapping over our private copy
+    auto flatMap = wordle::feedback::constructFlatFeedbackMap(vocab, queue, numThreads);
+    if (writeFeedbackCache(path, vocab, flatMap)) {
+        if (auto cached = openFeedbackCache(path, vocab)) return std::move(*cached);
+    }
+    return wordle::feedback::FeedbackMatrix{std::move(flatMap)};
+}
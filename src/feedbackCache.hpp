@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "config.hpp"
+#include "feedback.hpp"
+#include "feedbackMatrix.hpp"
+#include "parallelTaskQueue.hpp"
+#include "vocab.hpp"
+
+/*
+On-disk feedback matrix cache.
+
+File layout (native endianness):
+    [Header][zero padding up to payloadOffset][NUM_WORDS rows of FLAT_STRIDE Encodings]
+
+payloadOffset is a multiple of CACHE_LINE_SIZE, so mapped rows keep the same alignment as constructFlatFeedbackMap.
+A file is stale (and ignored) if its version, dimensions or vocab checksum differ from the running build.
+*/
+namespace wordle::feedback::cache {
+
+    constexpr inline std::array<char, 8> MAGIC{'W', 'R', 'D', 'L', 'F', 'B', 'M', '\0'};
+    constexpr inline uint32_t FORMAT_VERSION = 1;  // Bump whenever Encoder output or the layout changes
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t encodingSize;
+        uint64_t numWords;
+        uint64_t wordLength;
+        uint64_t numFeedbacks;
+        uint64_t stride;
+        uint64_t payloadOffset;
+        uint64_t vocabChecksum;
+    };
+
+    constexpr inline size_t PAYLOAD_OFFSET = ((sizeof(Header) + config::CACHE_LINE_SIZE - 1) / config::CACHE_LINE_SIZE) * config::CACHE_LINE_SIZE;
+    constexpr inline size_t PAYLOAD_SIZE = config::NUM_WORDS * FLAT_STRIDE * sizeof(Encoding);
+
+    // FNV-1a over every word (and its position) in vocab
+    [[nodiscard]] uint64_t vocabChecksum(const vocab::Vocab& vocab) noexcept;
+
+    // Header describing a matrix built from vocab by this build
+    [[nodiscard]] Header makeHeader(const vocab::Vocab& vocab) noexcept;
+
+    // Writes flatMap to path (via a temporary file and rename). Returns false if the file could not be written.
+    bool writeFeedbackCache(std::string_view path, const vocab::Vocab& vocab, const FlatFeedbackMap& flatMap);
+
+    // Returns true if image (a whole cache file's bytes, wherever they live) holds a matrix built from vocab by this build
+    [[nodiscard]] bool isValidImage(std::span<const std::byte> image, const vocab::Vocab& vocab) noexcept;
+
+    // Maps the cache at path. Returns std::nullopt if it is missing, truncated or stale for vocab.
+    [[nodiscard]] std::optional<FeedbackMatrix> openFeedbackCache(std::string_view path, const vocab::Vocab& vocab);
+
+    /*
+    Maps the cache at path if it is valid for vocab. Otherwise builds the matrix in parallel, writes the cache,
+    and serves the freshly written file (falling back to the in-memory map if the file can't be written).
+    */
+    [[nodiscard]] FeedbackMatrix loadFeedbackMatrix(
+        const vocab::Vocab& vocab,
+        parallel::TaskQueue& queue,
+        size_t numThreads = config::HARDWARE_CONCURRENCY,
+        std::string_view path = config::FEEDBACK_CACHE_FILE
+    );
+
+}  // namespace wordle::feedback::cache
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "arena.hpp"
+#include "config.hpp"
+#include "feedback.hpp"
+#include "guard.hpp"
+#include "mappedFile.hpp"
+
+namespace wordle::feedback {
+
+// Memory layout of a feedback matrix
+enum class Layout : uint8_t {
+    FLAT = 0,  // One contiguous buffer, rows FLAT_STRIDE apart and cache-line aligned
+    NESTED     // One heap vector per row (FeedbackMap), reached through a row table
+};
+
+/*
+Non-owning, read-only view of a feedback matrix: row guessIndex holds that guess's encoding against every word.
+
+Guarantees (both layouts):
+    - every row holds NUM_WORDS valid Encodings followed by at least ROW_PADDING readable ones
+FLAT layout additionally:
+    - row(i) == data() + i * stride(), with stride() == FLAT_STRIDE
+    - every row starts on a CACHE_LINE_SIZE boundary
+
+The layout is resolved when the view is built, so row() doesn't branch on it: row(i) is rowTable[i & tableMask] plus
+i * rowStride. NESTED tables list every row (mask ~0, stride 0); FLAT ones hold only the first row (mask 0, stride
+FLAT_STRIDE), which keeps that load on one hot cache line.
+*/
+class FeedbackMatrixView {
+    const Encoding* const* rowTable = nullptr;
+    size_t tableMask = 0;
+    size_t rowStride = 0;
+
+    constexpr FeedbackMatrixView(const Encoding* const* _rowTable, size_t _tableMask, size_t _rowStride) noexcept
+    : rowTable{_rowTable},
+      tableMask{_tableMask},
+      rowStride{_rowStride} {}
+
+public:
+    static constexpr size_t ROW_ALIGNMENT = config::CACHE_LINE_SIZE;
+    static_assert((FLAT_STRIDE * sizeof(Encoding)) % ROW_ALIGNMENT == 0);
+
+    constexpr FeedbackMatrixView() noexcept = default;
+
+    // View over FLAT_STRIDE-strided rows starting at *firstRow (must be cache-line aligned). firstRow must outlive the view.
+    static FeedbackMatrixView flat(const Encoding* const* firstRow) {
+        guard::hybridGuard<std::invalid_argument>(reinterpret_cast<uintptr_t>(*firstRow) % ROW_ALIGNMENT == 0, "flat feedback rows must be cache-line aligned");
+        return {firstRow, 0, FLAT_STRIDE};
+    }
+
+    // View over independently allocated rows, rowTable[i] pointing at row i
+    static constexpr FeedbackMatrixView nested(const Encoding* const* rowTable) noexcept {
+        return {rowTable, ~size_t{0}, 0};
+    }
+
+    [[nodiscard]] constexpr const Encoding* row(size_t guessIndex) const noexcept {
+        return rowTable[guessIndex & tableMask] + guessIndex * rowStride;
+    }
+
+    [[nodiscard]] constexpr std::span<const Encoding> operator[](size_t guessIndex) const noexcept {
+        return {row(guessIndex), config::NUM_WORDS};
+    }
+
+    [[nodiscard]] constexpr Layout layout() const noexcept {
+        return tableMask ? Layout::NESTED : Layout::FLAT;
+    }
+
+    // Start of the contiguous buffer (nullptr for NESTED)
+    [[nodiscard]] constexpr const Encoding* data() const noexcept {
+        return rowTable && !tableMask ? rowTable[0] : nullptr;
+    }
+
+    // Distance between consecutive rows in Encodings (0 for NESTED, where rows are unrelated)
+    [[nodiscard]] constexpr size_t stride() const noexcept { return rowStride; }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return rowTable == nullptr; }
+};
+
+/*
+Owning storage behind a FeedbackMatrixView.
+FLAT matrices are backed by a mapped cache file (zero-copy), an owned FlatFeedbackMap or rows embedded in the binary,
+NESTED ones by a FeedbackMap. Owned flat rows live in a huge page arena (see arena.hpp); mapped files are advised to
+use huge pages too, which only some filesystems honor.
+*/
+class FeedbackMatrix {
+    util::MappedFile mapping{};
+    FlatFeedbackMap flatRows{};
+    FeedbackMap nestedRows{};
+    std::vector<const Encoding*> rowTable{};  // Every row for NESTED, the first one for FLAT
+    FeedbackMatrixView matrixView{};
+
+    // Points the view at FLAT rows starting at base
+    void viewFlat(const Encoding* base) {
+        rowTable.assign(1, base);
+        matrixView = FeedbackMatrixView::flat(rowTable.data());
+    }
+
+public:
+    FeedbackMatrix() noexcept = default;
+    FeedbackMatrix(const FeedbackMatrix&) = delete;
+    FeedbackMatrix& operator=(const FeedbackMatrix&) = delete;
+    FeedbackMatrix(FeedbackMatrix&&) noexcept = default;           // Moving the buffers keeps their heap addresses, so the view stays valid
+    FeedbackMatrix& operator=(FeedbackMatrix&&) noexcept = default;
+    ~FeedbackMatrix() noexcept = default;
+
+    // Takes ownership of a flat map built by constructFlatFeedbackMap
+    explicit FeedbackMatrix(FlatFeedbackMap flatMap)
+    : flatRows{std::move(flatMap)} {
+        viewFlat(flatRows.data());
+    }
+
+    // Borrows rows starting payloadOffset bytes into a mapped file (caller validates the layout)
+    FeedbackMatrix(util::MappedFile file, size_t payloadOffset)
+    : mapping{std::move(file)} {
+        viewFlat(reinterpret_cast<const Encoding*>(mapping.data() + payloadOffset));
+        if (util::arena::policy() != util::arena::Policy::OFF) mapping.adviseHugePages();
+    }
+
+    // Borrows FLAT rows that outlive every matrix, such as ones embedded in the binary
+    static FeedbackMatrix borrowed(const Encoding* base) {
+        FeedbackMatrix matrix{};
+        matrix.viewFlat(base);
+        return matrix;
+    }
+
+    // Takes ownership of a nested map built by constructFeedbackMap
+    explicit FeedbackMatrix(FeedbackMap nestedMap)
+    : nestedRows{std::move(nestedMap)} {
+        rowTable.reserve(nestedRows.size());
+        for (const auto& row : nestedRows) rowTable.push_back(row.data());
+        matrixView = FeedbackMatrixView::nested(rowTable.data());
+    }
+
+    [[nodiscard]] const FeedbackMatrixView& view() const noexcept { return matrixView; }
+
+    [[nodiscard]] std::span<const Encoding> operator[](size_t guessIndex) const noexcept { return matrixView[guessIndex]; }
+
+    [[nodiscard]] const Encoding* data() const noexcept { return matrixView.data(); }
+
+    [[nodiscard]] size_t stride() const noexcept { return matrixView.stride(); }
+
+    [[nodiscard]] Layout layout() const noexcept { return matrixView.layout(); }
+
+    [[nodiscard]] bool empty() const noexcept { return matrixView.empty(); }
+
+    // Returns true if rows are served straight from a mapped cache file
+    [[nodiscard]] bool isMapped() const noexcept { return mapping.isOpen(); }
+
+    // Bytes of FLAT rows (0 for NESTED)
+    [[nodiscard]] size_t bytes() const noexcept {
+        return layout() == Layout::FLAT && !empty() ? config::NUM_WORDS * FLAT_STRIDE * sizeof(Encoding) : 0;
+    }
+
+    // Bytes of FLAT rows the kernel currently backs with huge pages
+    [[nodiscard]] size_t hugePageBytes() const {
+        return bytes() > 0 ? util::arena::hugePageBytes(data(), bytes()) : 0;
+    }
+};
+
+}  // namespace wordle::feedback
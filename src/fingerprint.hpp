@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "config.hpp"
+
+/*
+Zobrist fingerprints of word sets: every word index owns a fixed random 64-bit key, and a set hashes to the XOR of
+its keys. Removing a word is one XOR, so filter() keeps the fingerprint current in the same pass that erases words.
+Equal sets always share a fingerprint, whatever history produced them.
+*/
+namespace wordle::fingerprint {
+    using Fingerprint = uint64_t;
+
+    namespace __impl {
+        // splitmix64: well-mixed keys from a counter, usable at compile time
+        constexpr inline uint64_t splitmix64(uint64_t state) noexcept {
+            uint64_t z = state + 0x9e3779b97f4a7c15ull;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        constexpr inline std::array<Fingerprint, config::NUM_WORDS> makeKeys() noexcept {
+            std::array<Fingerprint, config::NUM_WORDS> keys{};
+            for (size_t i = 0; i < keys.size(); ++i) keys[i] = splitmix64(0x5eed0000ull + i);
+            return keys;
+        }
+
+        constexpr inline Fingerprint fingerprintRange(const std::array<Fingerprint, config::NUM_WORDS>& keys, size_t first, size_t last) noexcept {
+            Fingerprint fp = 0;
+            for (size_t i = first; i < last; ++i) fp ^= keys[i];
+            return fp;
+        }
+    }
+
+    constexpr inline std::array<Fingerprint, config::NUM_WORDS> KEYS = __impl::makeKeys();
+
+    constexpr inline Fingerprint ALL_TARGETS = __impl::fingerprintRange(KEYS, 0, config::NUM_TARGETS);  // Fresh EasyBot
+    constexpr inline Fingerprint ALL_WORDS = __impl::fingerprintRange(KEYS, 0, config::NUM_WORDS);      // Fresh HardBot
+
+    // Fingerprint of the words in [first, last)
+    template <typename IndexIterator>
+    constexpr Fingerprint of(IndexIterator first, IndexIterator last) noexcept {
+        Fingerprint fp = 0;
+        for (auto it = first; it != last; ++it) fp ^= KEYS[*it];
+        return fp;
+    }
+
+    // Mixes a bot configuration into a fingerprint, so differently configured bots never share keys
+    constexpr inline Fingerprint salted(Fingerprint fp, uint64_t salt) noexcept {
+        return fp ^ __impl::splitmix64(salt);
+    }
+}
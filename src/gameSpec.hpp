@@ -0,0 +1,65 @@
+#pragma once
+
+#include <bit>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/integer.hpp>
+
+#include "config.hpp"
+#include "guard.hpp"
+#include "util.hpp"
+#include "vocab.hpp"
+
+/*
+Game specs: the word length and word list sizes a variant of the game is compiled for.
+
+The encoders, BotBase and both bots are templates on a spec, so every variant gets its own constant-folded loops and
+the smallest Encoding that holds its feedbacks (one byte up to 5 letters, two from 6). dispatchWordLength() picks the
+pre-instantiated spec for a word length only known at runtime.
+
+Standard is the spec of config.hpp, and so far the only one instantiated: the engine context the bots read (matrix,
+histograms, bit planes), the caches, books and solver are still sized from config.hpp.
+*/
+namespace wordle::spec {
+
+    // Number of unique feedbacks for words of wordLength letters
+    consteval inline size_t numFeedbacks(size_t wordLength) {
+        return wordle::util::constevalPow(3ul, wordLength);
+    }
+
+    // Smallest type that can represent all unique feedbacks for words of WordLength letters
+    template <size_t WordLength>
+    using EncodingFor = typename boost::uint_t<std::bit_width(numFeedbacks(WordLength) - 1)>::least;
+
+    template <size_t WordLength, size_t NumTargets, size_t NumFillers>
+    struct GameSpec {
+        static_assert(WordLength > 0 && numFeedbacks(WordLength) <= (1ul << 16), "feedbacks must fit in 16 bits");
+
+        static constexpr size_t WORD_LENGTH = WordLength;
+        static constexpr size_t NUM_TARGETS = NumTargets;
+        static constexpr size_t NUM_FILLERS = NumFillers;
+        static constexpr size_t NUM_WORDS = NumTargets + NumFillers;
+        static constexpr size_t NUM_FEEDBACKS = numFeedbacks(WordLength);
+        using Encoding = EncodingFor<WordLength>;
+        using Vocab = vocab::BasicVocab<WordLength>;
+    };
+
+    using Standard = GameSpec<config::WORD_LENGTH, config::NUM_TARGETS, config::NUM_FILLERS>;
+
+    // Returns true if a spec with wordLength letters is pre-instantiated in the library
+    constexpr inline bool isSupportedWordLength(size_t wordLength) noexcept {
+        return wordLength == Standard::WORD_LENGTH;
+    }
+
+    /*
+    Calls f(std::type_identity<Spec>{}) with the pre-instantiated spec for wordLength, so f runs the bots and kernels
+    compiled for it. Throws std::invalid_argument for lengths without one.
+    */
+    template <typename F>
+    decltype(auto) dispatchWordLength(size_t wordLength, F&& f) {
+        guard::hybridGuard<std::invalid_argument>(isSupportedWordLength(wordLength), "no spec is instantiated for this word length");
+        return std::forward<F>(f)(std::type_identity<Standard>{});
+    }
+
+}  // namespace wordle::spec
@@ -1,12 +1,22 @@
 #pragma once
 
 #include <numeric>
+#include <optional>
+#include <span>
 
 #include "botBase.hpp"
 
 namespace wordle::bot {
 
-class HardBot : private BotBase {
+template <typename Spec>
+class BasicHardBot : private BasicBotBase<Spec> {
+    using Base = BasicBotBase<Spec>;
+    using typename Base::Encoding, typename Base::BinCounts;
+    using Base::context, Base::vocab, Base::fMap, Base::taskQueue, Base::bookCursor, Base::aliveFingerprint, Base::counting, Base::planes,
+        Base::pruning, Base::lookaheadPlan, Base::standardLookahead, Base::pruneStats, Base::pruneMtx;
+    using Base::placeOn, Base::attachOpeningBook, Base::attachSuggestionCache, Base::selectCounting, Base::countTargets, Base::recordPruning,
+        Base::stopScan, Base::selectLookahead, Base::lookaheadSearch, Base::serve, Base::depthTwoGain, Base::baseEntropy;
+
     std::vector<double> entropies;
     std::vector<WordCountT> aliveIndices{};
     std::vector<WordCountT> topCandidates{};
@@ -14,6 +24,19 @@ class HardBot : private BotBase {
     const size_t maxThreads;
     std::vector<WordCountT>::const_iterator fillerStart;
 
+    // Bins of one search worker's current candidate, reused across suggest() calls
+    struct BinScratch {
+        histogram::BinPartition targets;
+        histogram::BinPartition fillers;
+    };
+    std::vector<BinScratch> binScratch;
+
+    // First-pass handoff state, reused across suggest() calls
+    std::vector<selection::TopK> localTop;  // Best first-pass guesses of each search worker
+    std::vector<uint8_t> claimed;           // Guesses expanded speculatively while workers wait for the final top-k
+    std::vector<WordCountT> speculated;     // Guesses marked in claimed this search
+    std::vector<std::pair<WordCountT, std::optional<double>>> pendingGains;  // Speculative gains finished before the top-k
+
     struct GuessValidation {
         size_t index;
         bool isValid;
@@ -23,51 +46,6 @@ class HardBot : private BotBase {
         return std::distance(aliveIndices.cbegin(), fillerStart);
     }
 
-    template <bool ReturnTargetBin>
-    BotBase::WordIndexBins __getCandidateBin(size_t candidateIndex, BotBase::BinCounts& binCounts) {
-        const auto& candidateSlice = fMap[candidateIndex];
-        binCounts.fill(0);
-
-        // Step 1: Count number of words that fall in each feedback category given guessing candidate
-        std::vector<WordCountT>::const_iterator wordIndexStart;
-        std::vector<WordCountT>::const_iterator wordIndexStop;
-        if constexpr (ReturnTargetBin) {
-            wordIndexStart = aliveIndices.cbegin();
-            wordIndexStop = fillerStart;
-        } else {
-            wordIndexStart = fillerStart;
-            wordIndexStop = aliveIndices.cend();
-        }
-        for (auto it = wordIndexStart; it != wordIndexStop; ++it) {
-            size_t wordIndex = *it;
-            size_t fbIndex = candidateSlice[wordIndex];
-            ++binCounts[fbIndex];
-        }
-
-        // Step 2: Initialize output vector and reserve exact space for each bin
-        BotBase::WordIndexBins output(wordle::feedback::NUM_FEEDBACKS);
-        for (size_t i = 0; i < wordle::feedback::NUM_FEEDBACKS; ++i) {
-            output[i].reserve(binCounts[i]);
-        }
-
-        // Step 3: Add words in their respective bin
-        for (auto it = wordIndexStart; it != wordIndexStop; ++it) {
-            size_t wordIndex = *it;
-            size_t fbIndex = candidateSlice[wordIndex];
-            output[fbIndex].push_back(wordIndex);
-        }
-
-        return output;
-    }
-
-    BotBase::WordIndexBins getTargetIndexBins(size_t candidateIndex, BotBase::BinCounts& binCounts) {
-        return __getCandidateBin<true>(candidateIndex, binCounts);
-    }
-
-    BotBase::WordIndexBins getFillerIndexBins(size_t candidateIndex, BotBase::BinCounts& binCounts) {
-        return __getCandidateBin<false>(candidateIndex, binCounts);
-    }
-
     GuessValidation validateGuess(std::string_view guess) {
         GuessValidation gv{0, false};
         if (!util::isValidWord(guess)) return gv;
@@ -76,28 +54,21 @@ class HardBot : private BotBase {
         auto search = [&](bool searchTargets) {
             size_t numAliveTargets = aliveTargets(); 
             size_t left = searchTargets ? 0 : numAliveTargets;
-            size_t right = searchTargets ? numAliveTargets - 1 : aliveIndices.size() - 1;
+            size_t right = searchTargets ? numAliveTargets : aliveIndices.size();  // Exclusive
 
-            while (left <= right) {
+            while (left < right) {
                 size_t middle = (left + right) / 2;
                 size_t candidateIndex = aliveIndices[middle];
                 std::string_view candidate = vocab[candidateIndex];
 
-                bool found = true;
-                for (size_t i = 0; i < wordle::config::WORD_LENGTH; ++i) {
-                    char gChar = guess[i];
-                    char cChar = candidate[i];
-
-                    if (gChar == cChar) continue;
-                    found = false;
-                    if (cChar < gChar) {
-                        left = middle + 1;
-                    } else {
-                        right = middle - 1;
-                    }
+                if (candidate < guess) {
+                    left = middle + 1;
+                    continue;
+                }
+                if (guess < candidate) {
+                    right = middle;
+                    continue;
                 }
-
-                if (!found) continue;
 
                 // NOTE: Atomic not necessary due to unique targets and fillers
                 gv.index = candidateIndex;
@@ -113,43 +84,74 @@ class HardBot : private BotBase {
     }
 
     template <concepts::WordIndexIterator TargetIndexIterator, concepts::WordIndexIterator FillerIndexIterator>
-    double binEntropy(TargetIndexIterator tStart, TargetIndexIterator tStop, FillerIndexIterator fStart, FillerIndexIterator fStop, BotBase::BinCounts& binCounts) {
+    double binEntropy(TargetIndexIterator tStart, TargetIndexIterator tStop, FillerIndexIterator fStart, FillerIndexIterator fStop, entropy::SparseHistogram& histogram, bitslice::AliveSet& binSet, PruneStats& stats) {
         const size_t N = std::distance(tStart, tStop);
         if (N <= 2) {
             return std::max(0.0, static_cast<double>(N) - 1.0);
         }
+        if (planes) binSet.assign(tStart, tStop);
 
         // Resulting maximum entropy from each possible guess in this bin
-        double bestEntropy = std::numeric_limits<double>::min();
+        entropy::EntropyMaximizer bestEntropy{N};
+        ++stats.binScans;
 
         // Find entropy of guessing each target in this bin, compare with out best
         for (auto it = tStart; it != tStop; ++it) {
-            double entropy = BotBase::baseEntropy(*it, tStart, tStop, binCounts);
-            bestEntropy = std::max(bestEntropy, entropy);
+            const Encoding* nextRow = (it + 1 != tStop) ? fMap.row(*(it + 1)) : (fStart != fStop ? fMap.row(*fStart) : nullptr);
+            countTargets(*it, tStart, tStop, binSet, histogram, nextRow);
+            bestEntropy.consider(histogram);
+            if (stopScan(bestEntropy, stats, std::distance(it + 1, tStop) + std::distance(fStart, fStop))) return bestEntropy.value();
         }
 
         // Find entropy of guessing each fillers in this bin, compare with our best
         for (auto it = fStart; it != fStop; ++it) {
-            double entropy = BotBase::baseEntropy(*it, tStart, tStop, binCounts);
-            bestEntropy = std::max(bestEntropy, entropy);
+            const Encoding* nextRow = (it + 1 != fStop) ? fMap.row(*(it + 1)) : nullptr;
+            countTargets(*it, tStart, tStop, binSet, histogram, nextRow);
+            bestEntropy.consider(histogram);
+            if (stopScan(bestEntropy, stats, std::distance(it + 1, fStop))) return bestEntropy.value();
         }
-        return bestEntropy;
+        return bestEntropy.value();
     }
 
+    // Live two-level search over the current alive set
+    Suggestion search();
+
 public:
-    HardBot(size_t _maxThreads = config::HARDWARE_CONCURRENCY, size_t _beamCandidates = config::HARDWARE_CONCURRENCY)
-    : BotBase{_maxThreads},
-      entropies(config::NUM_WORDS),
+    static constexpr book::Mode BOOK_MODE = book::Mode::HARD;
+
+    BasicHardBot(size_t _maxThreads = config::HARDWARE_CONCURRENCY, size_t _beamCandidates = config::HARDWARE_CONCURRENCY, feedback::Layout layout = feedback::Layout::FLAT)
+    : Base{_maxThreads, layout},
+      entropies(Spec::NUM_WORDS),
+      topCandidates(_beamCandidates),
+      beamCandidates{_beamCandidates},
+      maxThreads{_maxThreads},
+      binScratch(_maxThreads),
+      localTop(_maxThreads),
+      claimed(Spec::NUM_WORDS, 0) {
+        selectLookahead(lookahead::Plan::standard(beamCandidates), beamCandidates);
+        reset();
+    }
+
+    // Borrows an existing engine context instead of the process-wide one
+    BasicHardBot(std::shared_ptr<const engine::Context> context, size_t _maxThreads = config::HARDWARE_CONCURRENCY, size_t _beamCandidates = config::HARDWARE_CONCURRENCY)
+    : Base{std::move(context), _maxThreads},
+      entropies(Spec::NUM_WORDS),
       topCandidates(_beamCandidates),
       beamCandidates{_beamCandidates},
-      maxThreads{_maxThreads} {
+      maxThreads{_maxThreads},
+      binScratch(_maxThreads),
+      localTop(_maxThreads),
+      claimed(Spec::NUM_WORDS, 0) {
+        selectLookahead(lookahead::Plan::standard(beamCandidates), beamCandidates);
         reset();
     }
 
     void reset() noexcept {
-        aliveIndices.resize(wordle::config::NUM_WORDS);
+        aliveIndices.resize(Spec::NUM_WORDS);
         std::iota(aliveIndices.begin(), aliveIndices.end(), 0);
-        fillerStart = aliveIndices.cbegin() + wordle::config::NUM_TARGETS;
+        fillerStart = aliveIndices.cbegin() + Spec::NUM_TARGETS;
+        bookCursor.reset();
+        aliveFingerprint = fingerprint::ALL_WORDS;
     }
 
     const auto& getFMap() const noexcept {
@@ -160,32 +162,105 @@ public:
         return vocab;
     }
 
-    Suggestion suggest();
+    const std::shared_ptr<const engine::Context>& getContext() const noexcept {
+        return context;
+    }
+
+    std::span<const WordCountT> getAliveTargets() const noexcept {
+        return {aliveIndices.data(), aliveTargets()};
+    }
+
+    std::span<const WordCountT> getAliveFillers() const noexcept {
+        return {std::to_address(fillerStart), std::to_address(aliveIndices.cend())};
+    }
+
+    size_t getBeamCandidates() const noexcept {
+        return beamCandidates;
+    }
+
+    // GATHER reads one feedback per alive target, BITSLICED splits bitsets of them (see bitSlice.hpp)
+    void setCounting(bitslice::Counting mode) {
+        selectCounting(mode);
+    }
+
+    bitslice::Counting getCounting() const noexcept {
+        return counting;
+    }
+
+    // Turns bound-based pruning of the depth-2 search on or off. Suggestions are the same either way.
+    void setPruning(bool enabled) noexcept {
+        pruning = enabled;
+    }
+
+    PruneStats getPruneStats() {
+        std::lock_guard<std::mutex> lock(pruneMtx);
+        return pruneStats;
+    }
+
+    // Searches plan.depth guesses ahead with plan.widths candidates per depth (see lookahead.hpp). Plans other than
+    // the standard two-level one bypass opening books. Throws std::invalid_argument for an invalid plan.
+    void setLookahead(const lookahead::Plan& plan) {
+        selectLookahead(plan, beamCandidates);
+    }
+
+    const lookahead::Plan& getLookahead() const noexcept {
+        return lookaheadPlan;
+    }
+
+    // Answers from book until a game leaves it (nullptr detaches). Throws if book was built for another configuration.
+    void useOpeningBook(std::shared_ptr<const book::OpeningBook> book) {
+        attachOpeningBook(std::move(book), BOOK_MODE, beamCandidates);
+    }
+
+    // Reads the matrix replica of NUMA node and keeps suggest() workers on its CPUs (node indexes Topology::system().nodes())
+    void placeOnNode(size_t node) {
+        placeOn(node);
+    }
+
+    // Shares cache across reset() calls, games and bots of the same mode and beam width (nullptr detaches)
+    void useSuggestionCache(std::shared_ptr<cache::SuggestionCache> cache) noexcept {
+        attachSuggestionCache(std::move(cache), BOOK_MODE, beamCandidates);
+    }
+
+    Suggestion suggest() {
+        return serve(aliveIndices.size(), [this] { return search(); });
+    }
+
+    void filter(size_t guessIndex, Encoding fbEncoding) {
+        bookCursor.advance(guessIndex, fbEncoding);
 
-    void filter(size_t guessIndex, wordle::feedback::Encoding fbEncoding) {
         // Filter aliveIndices
         aliveIndices.erase(
             std::remove_if(aliveIndices.begin(), aliveIndices.end(),
-                [guessIndex, fbEncoding, this](WordCountT i) { return this->fMap[i][guessIndex] != fbEncoding; }),
+                [guessIndex, fbEncoding, this](WordCountT i) {
+                    const bool isRemoved = this->fMap[i][guessIndex] != fbEncoding;
+                    aliveFingerprint ^= fingerprint::KEYS[i] & -static_cast<fingerprint::Fingerprint>(isRemoved);
+                    return isRemoved;
+                }),
             aliveIndices.end()
         );
 
         // Find number of targets left
-        fillerStart = std::upper_bound(aliveIndices.begin(), aliveIndices.end(), static_cast<WordCountT>(wordle::config::NUM_TARGETS - 1));
+        fillerStart = std::upper_bound(aliveIndices.begin(), aliveIndices.end(), static_cast<WordCountT>(Spec::NUM_TARGETS - 1));
     }
 
     
     FilterFlag tryFilter(std::string_view guess, std::string_view fbString) {
         auto gv = validateGuess(guess);
-        bool validFeedback = feedback::isValidFeedbackString(fbString);
+        bool validFeedback = feedback::isValidFeedbackString<Spec>(fbString);
 
         uint8_t flagUnderlying = (static_cast<uint8_t>(gv.isValid) << 1u) | static_cast<uint8_t>(validFeedback);
         FilterFlag flag{flagUnderlying};
 
         if (flag == FilterFlag::VALID) {
-            filter(gv.index, feedback::encodeFeedbackString(fbString));
+            filter(gv.index, feedback::__impl::encodeFeedbackString<Spec>(fbString));
         }
         return flag;
     }
 };
+
+extern template class BasicHardBot<spec::Standard>;
+
+using HardBot = BasicHardBot<spec::Standard>;
+
 }
\ No newline at end of file
@@ -1,75 +1,157 @@
 #include <atomic>
-#include <barrier>
+#include <condition_variable>
+#include <mutex>
 
 #include <boost/iterator/zip_iterator.hpp>
 #include <boost/range/combine.hpp>
 
 #include "hardBot.hpp"
+#include "profile.hpp"
 
 namespace wordle {
 
-bot::Suggestion bot::HardBot::suggest() {
+template <typename Spec>
+bot::Suggestion bot::BasicHardBot<Spec>::search() {
     static_assert(bot::Suggestion{}.isValid == false);
+    WORDLE_PROFILE_SCOPE(SEARCH);
 
     const size_t numAliveTargets = aliveTargets();
     if (!numAliveTargets) return {};
     if (numAliveTargets <= 2) return {static_cast<double>(numAliveTargets) - 1.0, vocab[aliveIndices.front()], aliveIndices.front(), true};
+    if (!standardLookahead) return this->template lookaheadSearch<true>(getAliveTargets(), getAliveFillers());
 
     // Atomic Suggestion for final Entropy
     std::atomic_size_t topCandidateIndex = 0;
+    std::atomic<double> bestTotal = std::numeric_limits<double>::lowest();  // Best finished depth-2 total, for pruning
 
     // Reset entropies for valid suggestions
     std::fill(entropies.begin(), entropies.end(), std::numeric_limits<double>::min());
 
     const size_t N = aliveIndices.size();
+    const entropy::ProbabilityTable probabilities{numAliveTargets};
+    bitslice::AliveSet aliveSet;
+    if (planes) aliveSet.assign(aliveIndices.cbegin(), fillerStart);
     const size_t threadsLaunched = std::min(N, maxThreads);
+    topCandidates.resize(std::min(numAliveTargets, beamCandidates));
+    const std::span<selection::TopK> workerLists{localTop.data(), threadsLaunched};
+    for (auto& top : workerLists) top.reset(topCandidates.size());
+
+    // Handoff between the passes: workers publish their top-k lists as they finish, the last one merges them
+    std::mutex handoffMtx;
+    std::condition_variable handoffCv;
+    size_t workersFinished = 0;
+    bool isReady = false;
+
+    // Adds a candidate's depth-2 gain once it is known to be among the top candidates
+    auto applyGain = [&](size_t candidateIndex, const std::optional<double>& entropyDelta) {
+        if (!entropyDelta || std::find(topCandidates.begin(), topCandidates.end(), candidateIndex) == topCandidates.end()) return;
+        entropies[candidateIndex] += *entropyDelta;
+        lookahead::raiseBest(bestTotal, entropies[candidateIndex]);
+    };
+
+    // Best unclaimed guess among the leading ones published so far (call under handoffMtx)
+    auto leadingUnclaimed = [&]() -> std::optional<size_t> {
+        std::optional<size_t> leader;
+        selection::visitMerged(workerLists, topCandidates.size(), [&](const selection::Entry& entry) {
+            if (!claimed[entry.index]) leader = entry.index;
+            return !leader;
+        });
+        return leader;
+    };
 
-    std::barrier syncPoint(threadsLaunched, [this] noexcept {
-        std::partial_sort_copy(
-            aliveIndices.begin(), aliveIndices.end(),
-            topCandidates.begin(), topCandidates.end(),
-            [this](WordCountT i, WordCountT j) { return entropies[i] > entropies[j]; }
-        );
-    });
-
-    auto worker = [&](std::vector<WordCountT>::const_iterator firstPassGuessStart, std::vector<WordCountT>::const_iterator firstPassGuessStop) {
-        // Step 1: Calculate entropy of first guess for all valid guesses
-        BotBase::BinCounts binCounts{};
-        for (auto it = firstPassGuessStart; it < firstPassGuessStop; ++it) {
-            size_t guessIndex = *it;
-            double entropy = BotBase::baseEntropy(guessIndex, aliveIndices.cbegin(), fillerStart, binCounts);
-            entropies[guessIndex] = entropy;
+    auto worker = [&](size_t threadID, std::vector<WordCountT>::const_iterator firstPassGuessStart, std::vector<WordCountT>::const_iterator firstPassGuessStop) {
+        // Step 1: Calculate entropy of first guess for all valid guesses, keeping this worker's best
+        BinCounts binCounts{};
+        entropy::SparseHistogram histogram;
+        bitslice::AliveSet binSet;
+        auto& top = localTop[threadID];
+        {
+            WORDLE_PROFILE_SCOPE(FIRST_PASS);
+            for (auto it = firstPassGuessStart; it < firstPassGuessStop; ++it) {
+                size_t guessIndex = *it;
+                const Encoding* nextRow = (it + 1 < firstPassGuessStop) ? fMap.row(*(it + 1)) : nullptr;
+                double entropy = baseEntropy(guessIndex, aliveIndices.cbegin(), fillerStart, aliveSet, histogram, probabilities, nextRow);
+                entropies[guessIndex] = entropy;
+                top.offer(entropy, guessIndex);
+            }
         }
 
-        // Step 2: One thread gets top candidates while others wait
-        syncPoint.arrive_and_wait();
+        // 2-depth entropy gain of a candidate, or nullopt if it was abandoned below the best total
+        auto& bins = binScratch[threadID];
+        PruneStats stats{};
+        auto expand = [&](size_t candidateIndex) {
+            {
+                WORDLE_PROFILE_SCOPE(CANDIDATE_BINS);
+                const Encoding* candidateRow = fMap.row(candidateIndex);
+                bins.targets.partition(candidateRow, std::to_address(aliveIndices.cbegin()), numAliveTargets, binCounts);
+                bins.fillers.partition(candidateRow, std::to_address(fillerStart), N - numAliveTargets, binCounts);
+            }
 
-        // Step 3: Take as many candidates as possible, calculate their 2-depth entropy, and add it to entropies
-        std::vector<std::vector<WordCountT>> targetBins;
-        std::vector<std::vector<WordCountT>> fillerBins;
+            // Weight of each bin is how probable we are to see a solution land in it compared to others
+            WORDLE_PROFILE_SCOPE(BIN_ENTROPY);
+            return depthTwoGain(
+                entropies[candidateIndex], Spec::NUM_FEEDBACKS, numAliveTargets,
+                [&](size_t i) { return bins.targets.binSize(i); },
+                [&](size_t i) {
+                    const auto targets = bins.targets.bin(i);
+                    const auto fillers = bins.fillers.bin(i);
+                    return binEntropy(targets.begin(), targets.end(), fillers.begin(), fillers.end(), histogram, binSet, stats);
+                },
+                bestTotal, stats
+            );
+        };
+
+        // Step 2: Publish this worker's list. Until the last worker merges them all, expand the leading guesses
+        // published so far; a speculative gain only counts if its guess makes the final top-k.
+        {
+            WORDLE_PROFILE_SCOPE(BARRIER);
+            std::unique_lock<std::mutex> lock(handoffMtx);
+            top.finish();
+            if (++workersFinished == threadsLaunched) {
+                WORDLE_PROFILE_SCOPE(TOP_CANDIDATES);
+                selection::merge(workerLists, topCandidates);
+                for (const auto& [candidateIndex, entropyDelta] : pendingGains) applyGain(candidateIndex, entropyDelta);
+                isReady = true;
+            }
+            handoffCv.notify_all();
+
+            while (!isReady) {
+                const auto leader = leadingUnclaimed();
+                if (!leader) {
+                    handoffCv.wait(lock);
+                    continue;
+                }
+                claimed[*leader] = 1;
+                speculated.push_back(static_cast<WordCountT>(*leader));
+
+                lock.unlock();
+                const auto entropyDelta = expand(*leader);
+                lock.lock();
+                if (isReady) {
+                    applyGain(*leader, entropyDelta);
+                } else {
+                    pendingGains.emplace_back(static_cast<WordCountT>(*leader), entropyDelta);
+                }
+            }
+        }
 
+        // Step 3: Take as many candidates as possible, calculate their 2-depth entropy, and add it to entropies
         while (true) {
             size_t idx = topCandidateIndex.fetch_add(1, std::memory_order_relaxed);
             if (idx >= topCandidates.size()) break;
 
+            // Speculated candidates were expanded (or are still being expanded) by the worker that claimed them
             size_t candidateIndex = topCandidates[idx];
-            double entropyDelta = 0.0;
-            targetBins = getTargetIndexBins(candidateIndex, binCounts);
-            fillerBins = getFillerIndexBins(candidateIndex, binCounts);
-
-            for (size_t i = 0; i < wordle::feedback::NUM_FEEDBACKS; ++i) {
-                // Get weight of this bin (AKA, how probable we are to see a solution land in this bin compared to others)
-                const auto& targets = targetBins[i];
-                const auto& fillers = fillerBins[i];
-                const double weight = static_cast<double>(targets.size()) / static_cast<double>(numAliveTargets);
-                double bEntropy = binEntropy(targets.cbegin(), targets.cend(), fillers.cbegin(), fillers.cend(), binCounts);
-                entropyDelta += weight * bEntropy;
-            }
+            if (claimed[candidateIndex]) continue;
 
-            entropies[candidateIndex] += entropyDelta;
+            // An abandoned candidate keeps its depth-1 entropy, which is below the best total
+            const auto entropyDelta = expand(candidateIndex);
+            if (!entropyDelta) continue;
+            entropies[candidateIndex] += *entropyDelta;
+            lookahead::raiseBest(bestTotal, entropies[candidateIndex]);
         }
+        recordPruning(stats);
     };
-    topCandidates.resize(std::min(numAliveTargets, beamCandidates));
     const size_t baseWork = N / maxThreads;
     const size_t extraWork = N % maxThreads;
     std::vector<WordCountT>::const_iterator it = aliveIndices.cbegin();
@@ -77,11 +159,15 @@ bot::Suggestion bot::HardBot::suggest() {
 
     for (size_t threadID = 0; it != stop; ++threadID) {
         std::vector<WordCountT>::const_iterator nextIt = it + baseWork + (threadID < extraWork ? 1 : 0);
-        taskQueue.push(worker, it, nextIt);
+        taskQueue.push(worker, threadID, it, nextIt);
         it = nextIt;
     }
     taskQueue.wait();
 
+    for (WordCountT guessIndex : speculated) claimed[guessIndex] = 0;
+    speculated.clear();
+    pendingGains.clear();
+
     double bestEntropy = std::numeric_limits<double>::min();
     size_t wordIndex;
 
@@ -95,4 +181,7 @@ bot::Suggestion bot::HardBot::suggest() {
     return {bestEntropy, vocab[wordIndex], wordIndex, true};
 }
 
-}
\ No newline at end of file
+// Pre-instantiated for the specs spec::dispatchWordLength() can pick
+template class bot::BasicHardBot<spec::Standard>;
+
+}
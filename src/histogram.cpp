@@ -0,0 +1,226 @@
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define WORDLE_HISTOGRAM_X86 1
+#endif
+
+#include "guard.hpp"
+#include "histogram.hpp"
+
+namespace {
+    constexpr size_t SUB_HISTOGRAMS = 4;                       // Interleaved copies, indexed by position mod 4
+    constexpr size_t SUB_BINS = 256;                           // Every 8-bit Encoding, so gathered bytes need no range check
+    constexpr size_t PREFETCH_EVERY = 16;                      // Indices per prefetch of nextRow
+    static_assert(wordle::feedback::NUM_FEEDBACKS <= SUB_BINS);
+
+    using wordle::histogram::WordIndex;
+    using wordle::feedback::Encoding;
+    using SubHistograms = std::array<std::array<WordIndex, SUB_BINS>, SUB_HISTOGRAMS>;
+
+    // Sums the interleaved sub-histograms into binCounts
+    inline void merge(const SubHistograms& sub, WordIndex* binCounts) noexcept {
+        for (size_t bin = 0; bin < wordle::feedback::NUM_FEEDBACKS; ++bin) {
+            binCounts[bin] = static_cast<WordIndex>(sub[0][bin] + sub[1][bin] + sub[2][bin] + sub[3][bin]);
+        }
+    }
+
+    // Scalar tail shared by every kernel, starting at index start
+    inline void countTail(const Encoding* row, const WordIndex* indices, size_t start, size_t n, SubHistograms& sub) noexcept {
+        for (size_t i = start; i < n; ++i) {
+            ++sub[i % SUB_HISTOGRAMS][row[indices[i]]];
+        }
+    }
+}
+
+void wordle::histogram::__impl::countScalar(const Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const Encoding* nextRow) noexcept {
+    SubHistograms sub{};
+
+    size_t i = 0;
+    for (; i + PREFETCH_EVERY <= n; i += PREFETCH_EVERY) {
+        if (nextRow) __builtin_prefetch(nextRow + indices[i]);
+        for (size_t j = 0; j < PREFETCH_EVERY; j += SUB_HISTOGRAMS) {
+            ++sub[0][row[indices[i + j]]];
+            ++sub[1][row[indices[i + j + 1]]];
+            ++sub[2][row[indices[i + j + 2]]];
+            ++sub[3][row[indices[i + j + 3]]];
+        }
+    }
+    countTail(row, indices, i, n, sub);
+    merge(sub, binCounts);
+}
+
+#ifdef WORDLE_HISTOGRAM_X86
+
+__attribute__((target("avx2")))
+void wordle::histogram::__impl::countAvx2(const Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const Encoding* nextRow) noexcept {
+    static_assert(sizeof(WordIndex) == 2 && sizeof(Encoding) == 1, "AVX2 kernel expects 16-bit indices and 8-bit encodings");
+    SubHistograms sub{};
+    alignas(32) uint32_t lanes[16];
+    const int* base = reinterpret_cast<const int*>(row);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        if (nextRow) __builtin_prefetch(nextRow + indices[i]);
+
+        // Widen 16 indices to 32 bits and gather the 4 bytes at row + index for each
+        const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+        const __m256i low = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(packed));
+        const __m256i high = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(packed, 1));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_i32gather_epi32(base, low, 1));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 8), _mm256_i32gather_epi32(base, high, 1));
+
+        // Only the low byte of each lane is the encoding
+        for (size_t k = 0; k < 16; k += SUB_HISTOGRAMS) {
+            ++sub[0][static_cast<uint8_t>(lanes[k])];
+            ++sub[1][static_cast<uint8_t>(lanes[k + 1])];
+            ++sub[2][static_cast<uint8_t>(lanes[k + 2])];
+            ++sub[3][static_cast<uint8_t>(lanes[k + 3])];
+        }
+    }
+    countTail(row, indices, i, n, sub);
+    merge(sub, binCounts);
+}
+
+__attribute__((target("avx512f")))
+void wordle::histogram::__impl::countAvx512(const Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const Encoding* nextRow) noexcept {
+    static_assert(sizeof(WordIndex) == 2 && sizeof(Encoding) == 1, "AVX-512 kernel expects 16-bit indices and 8-bit encodings");
+    SubHistograms sub{};
+    alignas(16) uint8_t lanes[32];
+    const void* base = row;
+    constexpr __mmask16 ALL_LANES = 0xFFFF;
+
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        if (nextRow) {
+            __builtin_prefetch(nextRow + indices[i]);
+            __builtin_prefetch(nextRow + indices[i + 16]);
+        }
+
+        // Two 16-lane gathers, then narrow each lane to its low byte. GCC's unmasked intrinsics pass an uninitialized
+        // vector through (-Wmaybe-uninitialized under -Werror), so every step uses the all-lanes masked form over zero.
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i low = _mm512_maskz_cvtepu16_epi32(ALL_LANES, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i)));
+        const __m512i high = _mm512_maskz_cvtepu16_epi32(ALL_LANES, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i + 16)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm512_maskz_cvtepi32_epi8(ALL_LANES, _mm512_mask_i32gather_epi32(zero, ALL_LANES, low, base, 1)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 16), _mm512_maskz_cvtepi32_epi8(ALL_LANES, _mm512_mask_i32gather_epi32(zero, ALL_LANES, high, base, 1)));
+
+        for (size_t k = 0; k < 32; k += SUB_HISTOGRAMS) {
+            ++sub[0][lanes[k]];
+            ++sub[1][lanes[k + 1]];
+            ++sub[2][lanes[k + 2]];
+            ++sub[3][lanes[k + 3]];
+        }
+    }
+    countTail(row, indices, i, n, sub);
+    merge(sub, binCounts);
+}
+
+#else
+
+// Non-x86 builds only have the scalar kernel
+void wordle::histogram::__impl::countAvx2(const Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const Encoding* nextRow) noexcept {
+    countScalar(row, indices, n, binCounts, nextRow);
+}
+
+void wordle::histogram::__impl::countAvx512(const Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const Encoding* nextRow) noexcept {
+    countScalar(row, indices, n, binCounts, nextRow);
+}
+
+#endif
+
+bool wordle::histogram::isSupported(Kernel kernel) noexcept {
+#ifdef WORDLE_HISTOGRAM_X86
+    __builtin_cpu_init();  // May run before the CPU model is initialized (static initialization)
+#endif
+    switch (kernel) {
+        case Kernel::SCALAR : return true;
+#ifdef WORDLE_HISTOGRAM_X86
+        case Kernel::AVX2 : return __builtin_cpu_supports("avx2");
+        case Kernel::AVX512 : return __builtin_cpu_supports("avx512f");
+#endif
+        default : return false;
+    }
+}
+
+wordle::histogram::Kernel wordle::histogram::bestSupportedKernel() noexcept {
+    if (isSupported(Kernel::AVX512)) return Kernel::AVX512;
+    if (isSupported(Kernel::AVX2)) return Kernel::AVX2;
+    return Kernel::SCALAR;
+}
+
+wordle::histogram::__impl::CountFn wordle::histogram::__impl::kernelFunction(Kernel kernel) noexcept {
+    if (!isSupported(kernel)) return countScalar;
+    switch (kernel) {
+        case Kernel::AVX2 : return countAvx2;
+        case Kernel::AVX512 : return countAvx512;
+        default : return countScalar;
+    }
+}
+
+wordle::histogram::Kernel wordle::histogram::calibrateKernel() {
+    // Synthetic first pass: a random padded row against a sorted, target-sized index set
+    std::mt19937 rng{2315};
+    std::vector<Encoding> row(wordle::config::NUM_WORDS + wordle::feedback::ROW_PADDING);
+    std::uniform_int_distribution<unsigned> encodingDist(0, wordle::feedback::NUM_FEEDBACKS - 1);
+    for (auto& encoding : row) encoding = static_cast<Encoding>(encodingDist(rng));
+
+    std::vector<WordIndex> indices(wordle::config::NUM_TARGETS);
+    std::iota(indices.begin(), indices.end(), WordIndex{0});
+
+    constexpr size_t ROUNDS = 3;
+    constexpr size_t REPETITIONS = 64;
+    Kernel fastest = Kernel::SCALAR;
+    auto fastestTime = std::chrono::nanoseconds::max();
+    BinCounts binCounts{};
+
+    for (Kernel kernel : {Kernel::SCALAR, Kernel::AVX2, Kernel::AVX512}) {
+        if (!isSupported(kernel)) continue;
+        const auto fn = __impl::kernelFunction(kernel);
+        for (size_t round = 0; round < ROUNDS; ++round) {
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t rep = 0; rep < REPETITIONS; ++rep) {
+                fn(row.data(), indices.data(), indices.size(), binCounts.data(), nullptr);
+                asm volatile("" : : "r"(binCounts.data()) : "memory");  // Keep the counts observable
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed < fastestTime) {
+                fastestTime = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+                fastest = kernel;
+            }
+        }
+    }
+    return fastest;
+}
+
+namespace {
+    // First call calibrates and installs the fastest kernel, so countBins works even during static initialization
+    void resolveAndCount(const Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const Encoding* nextRow) noexcept {
+        using namespace wordle::histogram;
+        __impl::CountFn fn = __impl::countScalar;
+        try {
+            fn = __impl::kernelFunction(calibrateKernel());
+        } catch (...) {}  // Allocation failure: stay on the scalar kernel
+        __impl::CountFn expected = resolveAndCount;
+        __impl::activeCount.compare_exchange_strong(expected, fn, std::memory_order_relaxed);
+        fn(row, indices, n, binCounts, nextRow);
+    }
+}
+
+std::atomic<wordle::histogram::__impl::CountFn> wordle::histogram::__impl::activeCount{resolveAndCount};
+
+wordle::histogram::Kernel wordle::histogram::activeKernel() noexcept {
+    const __impl::CountFn fn = __impl::activeCount.load(std::memory_order_relaxed);
+    if (fn == resolveAndCount) return Kernel::SCALAR;  // Not calibrated yet
+    if (fn == __impl::countAvx512) return Kernel::AVX512;
+    if (fn == __impl::countAvx2) return Kernel::AVX2;
+    return Kernel::SCALAR;
+}
+
+void wordle::histogram::setKernel(Kernel kernel) {
+    guard::runtimeGuard(isSupported(kernel), "histogram kernel {} is not supported on this CPU", static_cast<int>(kernel));
+    __impl::activeCount.store(__impl::kernelFunction(kernel), std::memory_order_relaxed);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <boost/integer.hpp>
+
+#include "config.hpp"
+#include "feedback.hpp"
+
+/*
+Feedback histograms: for one guess row and a list of word indices, count how many words land in each feedback bin.
+
+This is the innermost loop of every entropy evaluation. Large inputs go through a kernel picked at runtime:
+    SCALAR : four interleaved sub-histograms, so repeated bins don't serialize on one store-to-load chain
+    AVX2   : 8-lane gathers of row[index] feeding the interleaved sub-histograms
+    AVX512 : 16-lane gathers of row[index] feeding the interleaved sub-histograms
+Every kernel prefetches nextRow (the row the caller evaluates next) at the same indices.
+The first countBins call times every supported kernel on a synthetic first pass and keeps the fastest, since
+gather throughput varies widely between microarchitectures (and microcode mitigations).
+Gathers read 4 bytes at row + index, which stays inside the ROW_PADDING every matrix row carries.
+*/
+namespace wordle::histogram {
+    using WordIndex = boost::uint_t<std::bit_width(config::NUM_WORDS - 1)>::least;  // Index of a word in the vocab
+    using BinCounts = std::array<WordIndex, feedback::NUM_FEEDBACKS>;
+
+    enum class Kernel : uint8_t { SCALAR = 0, AVX2, AVX512 };
+
+    // Below this many indices the plain scalar loop beats zeroing and merging sub-histograms
+    constexpr inline size_t SMALL_INPUT = 256;
+
+    namespace __impl {
+        using CountFn = void (*)(const feedback::Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const feedback::Encoding* nextRow) noexcept;
+
+        void countScalar(const feedback::Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const feedback::Encoding* nextRow) noexcept;
+        void countAvx2(const feedback::Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const feedback::Encoding* nextRow) noexcept;
+        void countAvx512(const feedback::Encoding* row, const WordIndex* indices, size_t n, WordIndex* binCounts, const feedback::Encoding* nextRow) noexcept;
+
+        CountFn kernelFunction(Kernel kernel) noexcept;
+
+        // Kernel used by countBins, calibrated on first use
+        extern std::atomic<CountFn> activeCount;
+    }
+
+    // Returns true if this CPU (and build) can run kernel
+    [[nodiscard]] bool isSupported(Kernel kernel) noexcept;
+
+    // Widest kernel this CPU supports
+    [[nodiscard]] Kernel bestSupportedKernel() noexcept;
+
+    // Times every supported kernel on a synthetic first pass and returns the fastest
+    [[nodiscard]] Kernel calibrateKernel();
+
+    // Kernel currently used by countBins
+    [[nodiscard]] Kernel activeKernel() noexcept;
+
+    // Forces the kernel used by countBins (for benchmarks and tests). Throws if kernel is unsupported.
+    void setKernel(Kernel kernel);
+
+    /*
+    Overwrites binCounts with the histogram of row[indices[0..n)].
+    nextRow (optional) is prefetched at the same indices for the caller's next evaluation.
+    */
+    inline void countBins(const feedback::Encoding* row, const WordIndex* indices, size_t n, BinCounts& binCounts, const feedback::Encoding* nextRow = nullptr) noexcept {
+        if (n < SMALL_INPUT) {
+            binCounts.fill(0);
+            for (size_t i = 0; i < n; ++i) {
+                ++binCounts[row[indices[i]]];
+            }
+            return;
+        }
+        __impl::activeCount.load(std::memory_order_relaxed)(row, indices, n, binCounts.data(), nextRow);
+    }
+
+    // Same as countBins, but always runs kernel
+    inline void countBinsWith(Kernel kernel, const feedback::Encoding* row, const WordIndex* indices, size_t n, BinCounts& binCounts, const feedback::Encoding* nextRow = nullptr) noexcept {
+        __impl::kernelFunction(kernel)(row, indices, n, binCounts.data(), nextRow);
+    }
+
+    /*
+    Words grouped by their feedback against one guess, in CSR form: bin b is indices[offsets[b], offsets[b + 1]).
+    One counting sort fills it, keeping the input order within each bin. The index buffer only grows, so a partition
+    reused across calls stops allocating once it has seen the largest input.
+    */
+    class BinPartition {
+        std::array<uint32_t, feedback::NUM_FEEDBACKS + 1> offsets{};
+        std::vector<WordIndex> indices;
+
+    public:
+        // Groups words[0..n) by row[word]. binCounts receives the size of every bin.
+        void partition(const feedback::Encoding* row, const WordIndex* words, size_t n, BinCounts& binCounts) {
+            countBins(row, words, n, binCounts);
+            for (size_t bin = 0; bin < feedback::NUM_FEEDBACKS; ++bin) offsets[bin + 1] = offsets[bin] + binCounts[bin];
+            if (indices.size() < n) indices.resize(n);
+
+            std::array<uint32_t, feedback::NUM_FEEDBACKS> cursor;
+            std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+            for (size_t i = 0; i < n; ++i) indices[cursor[row[words[i]]]++] = words[i];
+        }
+
+        [[nodiscard]] std::span<const WordIndex> bin(size_t fbIndex) const noexcept {
+            return {indices.data() + offsets[fbIndex], indices.data() + offsets[fbIndex + 1]};
+        }
+
+        [[nodiscard]] size_t binSize(size_t fbIndex) const noexcept {
+            return offsets[fbIndex + 1] - offsets[fbIndex];
+        }
+
+        // Words partitioned by the last call
+        [[nodiscard]] size_t size() const noexcept { return offsets.back(); }
+
+        // Words the buffer holds without reallocating
+        [[nodiscard]] size_t capacity() const noexcept { return indices.size(); }
+    };
+}
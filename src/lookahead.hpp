@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "config.hpp"
+#include "entropy.hpp"
+#include "feedback.hpp"
+#include "feedbackMatrix.hpp"
+#include "fingerprint.hpp"
+#include "guard.hpp"
+#include "histogram.hpp"
+#include "parallelTaskQueue.hpp"
+#include "selection.hpp"
+
+/*
+Depth-k lookahead search.
+
+The value of guess g over alive targets S is
+    E1(g) = H(g | S)
+    Ek(g) = E1(g) + sum over bins b of g: |S_b| / |S| * max over g' of E(k-1)(g' | S_b)
+that is, the information expected from g and the k - 1 best follow-ups. By the chain rule Ek(g) <= log2(|S|).
+
+A node is searched to depth k by iterative deepening: every guess gets E1, the widths[2] best by E1 get E2, the
+widths[3] best by E2 get E3, and so on, each level ranking the next. Bins are searched the same way one level
+shallower, and depth 1 is exhaustive.
+
+Plan::standard(beam) is the two-level search the bots have built in (HardBot follows Engine<true> and EasyBot
+Engine<false> exactly).
+*/
+namespace wordle::lookahead {
+    using WordIndex = histogram::WordIndex;
+
+    constexpr inline size_t MAX_DEPTH = 4;           // Deeper searches take hours per opening
+    constexpr inline size_t DEFAULT_DEEP_WIDTH = 2;  // Candidates expanded to depth 3 and beyond by default
+
+    /*
+    How deep to search and how many candidates to expand at each depth, at the root and inside every bin.
+    widths[d] candidates are expanded to depth d, for 2 <= d <= depth (entries 0 and 1 are unused).
+    */
+    struct Plan {
+        size_t depth = 2;
+        std::array<size_t, MAX_DEPTH + 1> widths{0, 0, config::HARDWARE_CONCURRENCY, DEFAULT_DEEP_WIDTH, DEFAULT_DEEP_WIDTH};
+
+        // depth levels with beam candidates at depth 2 and DEFAULT_DEEP_WIDTH beyond
+        static Plan ofDepth(size_t depth, size_t beam) noexcept {
+            Plan plan{};
+            plan.depth = depth;
+            plan.widths[2] = beam;
+            return plan;
+        }
+
+        // The two-level search the bots have built in
+        static Plan standard(size_t beam) noexcept {
+            return ofDepth(2, beam);
+        }
+
+        // Returns true if this plan searches exactly like standard(beam)
+        [[nodiscard]] bool isStandard(size_t beam) const noexcept {
+            return depth == 2 && widths[2] == beam;
+        }
+
+        // Distinguishes plans in suggestion cache keys
+        [[nodiscard]] uint64_t salt() const noexcept {
+            uint64_t salt = fingerprint::__impl::splitmix64(depth);
+            for (size_t d = 2; d <= depth; ++d) salt = fingerprint::__impl::splitmix64(salt ^ widths[d]);
+            return salt;
+        }
+
+        bool operator==(const Plan&) const noexcept = default;
+    };
+
+    // Throws std::invalid_argument unless 1 <= depth <= MAX_DEPTH and every width in use is positive
+    inline void validate(const Plan& plan) {
+        guard::hybridGuard<std::invalid_argument>(plan.depth >= 1 && plan.depth <= MAX_DEPTH, "lookahead depth must be in [1, MAX_DEPTH]");
+        for (size_t d = 2; d <= plan.depth; ++d) {
+            guard::hybridGuard<std::invalid_argument>(plan.widths[d] > 0, "lookahead widths must be positive up to the plan's depth");
+        }
+    }
+
+    // Search work skipped through entropy bounds, summed over searches
+    struct PruneStats {
+        size_t binScans = 0;          // Bins searched for their best guess
+        size_t binScansCut = 0;       // Of those, stopped early at a perfect split
+        size_t guessesSkipped = 0;    // Guess evaluations the cuts saved
+        size_t candidates = 0;        // Candidates expanded one level deeper
+        size_t candidatesPruned = 0;  // Of those, abandoned once their optimistic total fell below the best
+        size_t binsSkipped = 0;       // Bins the abandoned candidates never searched
+
+        PruneStats& operator+=(const PruneStats& other) noexcept {
+            binScans += other.binScans;
+            binScansCut += other.binScansCut;
+            guessesSkipped += other.guessesSkipped;
+            candidates += other.candidates;
+            candidatesPruned += other.candidatesPruned;
+            binsSkipped += other.binsSkipped;
+            return *this;
+        }
+    };
+
+    // Ends a depth-1 bin scan at a perfect split, counting the guesses it leaves unscored
+    inline bool stopScan(bool pruning, const entropy::EntropyMaximizer& best, PruneStats& stats, size_t guessesLeft) noexcept {
+        if (!pruning || !best.isSaturated()) return false;
+        ++stats.binScansCut;
+        stats.guessesSkipped += guessesLeft;
+        return true;
+    }
+
+    // Raises the best total seen by a search level to total
+    inline void raiseBest(std::atomic<double>& best, double total) noexcept {
+        double current = best.load(std::memory_order_relaxed);
+        while (current < total && !best.compare_exchange_weak(current, total, std::memory_order_relaxed)) {}
+    }
+
+    /*
+    Gain of expanding a candidate one level: sum over bins i < numBins, in bin order, of binSize(i) / numAlive times
+    the best value within bin i at binDepth (searchBin(i), only called for bins of more than 2 words).
+    Bins are searched largest first, so the optimistic total (depthOne, searched bins exact, the rest at
+    entropy::entropyBound) drops fast; once it falls below best the candidate is abandoned and nullopt returned.
+    Bounds carry entropy::BOUND_SLACK, so an abandoned candidate was strictly worse than best, never tied.
+    */
+    template <typename BinSize, typename SearchBin>
+    std::optional<double> expansionGain(bool pruning, double depthOne, size_t numBins, size_t numAlive, size_t binDepth, BinSize&& binSize, SearchBin&& searchBin, const std::atomic<double>& best, PruneStats& stats) {
+        std::vector<double> binValues(numBins, 0.0);
+        std::vector<uint32_t> order;
+        ++stats.candidates;
+
+        // Step 1: Small bins are exact already, the rest start at their bound
+        double optimistic = depthOne;
+        for (size_t i = 0; i < numBins; ++i) {
+            const size_t n = binSize(i);
+            const double weight = static_cast<double>(n) / static_cast<double>(numAlive);
+            if (n <= 2) {
+                binValues[i] = std::max(0.0, static_cast<double>(n) - 1.0);
+            } else {
+                order.push_back(static_cast<uint32_t>(i));
+            }
+            optimistic += weight * entropy::entropyBound(n, binDepth);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t i, uint32_t j) { return binSize(i) > binSize(j); });
+
+        // Step 2: Search the big bins first, replacing their bound with the exact best
+        for (size_t k = 0; k < order.size(); ++k) {
+            if (pruning && optimistic < best.load(std::memory_order_relaxed)) {
+                ++stats.candidatesPruned;
+                stats.binsSkipped += order.size() - k;
+                return std::nullopt;
+            }
+            const size_t i = order[k];
+            const size_t n = binSize(i);
+            const double weight = static_cast<double>(n) / static_cast<double>(numAlive);
+            binValues[i] = searchBin(i);
+            optimistic -= weight * (entropy::entropyBound(n, binDepth) - binValues[i]);
+        }
+
+        // Step 3: Sum in bin order, as the exhaustive search always has
+        double gain = 0.0;
+        for (size_t i = 0; i < numBins; ++i) {
+            const double weight = static_cast<double>(binSize(i)) / static_cast<double>(numAlive);
+            gain += weight * binValues[i];
+        }
+        return gain;
+    }
+
+    struct Scored {
+        double value = std::numeric_limits<double>::min();
+        size_t guessIndex = 0;
+    };
+
+    /*
+    Lookahead search over one game state. In HardMode only alive words (targets, then fillers) are guesses and
+    fillers are split along with targets; otherwise every word is a guess and only targets are split.
+    The root spreads its work over a task queue; bins are searched by the task that expands their candidate.
+    */
+    template <bool HardMode>
+    class Engine {
+        using Words = std::vector<WordIndex>;
+
+        struct Scratch {
+            entropy::SparseHistogram histogram;
+            PruneStats stats;
+        };
+
+        struct Bins {
+            std::vector<Words> targets = std::vector<Words>(feedback::NUM_FEEDBACKS);
+            std::vector<Words> fillers = std::vector<Words>(HardMode ? feedback::NUM_FEEDBACKS : 0);
+        };
+
+        const feedback::FeedbackMatrixView& fMap;
+        const Plan& plan;
+        bool pruning;
+
+        static std::span<const WordIndex> allWords() {
+            static const Words words = [] {
+                Words w(config::NUM_WORDS);
+                std::iota(w.begin(), w.end(), 0);
+                return w;
+            }();
+            return words;
+        }
+
+        std::span<const WordIndex> guessesOf(std::span<const WordIndex> targets, std::span<const WordIndex> fillers, Words& buffer) const {
+            if constexpr (!HardMode) return allWords();
+            buffer.assign(targets.begin(), targets.end());
+            buffer.insert(buffer.end(), fillers.begin(), fillers.end());
+            return buffer;
+        }
+
+        // Words of each bin of guess, in their original order
+        Bins split(size_t guessIndex, std::span<const WordIndex> targets, std::span<const WordIndex> fillers) const {
+            Bins bins;
+            const auto* row = fMap.row(guessIndex);
+            for (WordIndex w : targets) bins.targets[row[w]].push_back(w);
+            if constexpr (HardMode) {
+                for (WordIndex w : fillers) bins.fillers[row[w]].push_back(w);
+            }
+            return bins;
+        }
+
+        // Runs fn(i, scratch) for i in [0, count): as tasks on queue with their own scratch, or inline without one
+        template <typename Fn>
+        static void forEach(parallel::TaskQueue* queue, size_t count, Scratch& scratch, Fn&& fn) {
+            if (!queue || count <= 1) {
+                for (size_t i = 0; i < count; ++i) fn(i, scratch);
+                return;
+            }
+
+            std::mutex statsMtx;
+            for (size_t i = 0; i < count; ++i) {
+                queue->push([&, i]() {
+                    Scratch local;
+                    fn(i, local);
+                    std::lock_guard<std::mutex> lock(statsMtx);
+                    scratch.stats += local.stats;
+                });
+            }
+            queue->wait();
+        }
+
+        // Best E1 over the node's guesses, without ranking them
+        double scan(std::span<const WordIndex> targets, std::span<const WordIndex> fillers, Scratch& scratch) const {
+            Words buffer;
+            const auto guesses = guessesOf(targets, fillers, buffer);
+            entropy::EntropyMaximizer best{targets.size()};
+            ++scratch.stats.binScans;
+            for (size_t i = 0; i < guesses.size(); ++i) {
+                const feedback::Encoding* nextRow = (i + 1 < guesses.size()) ? fMap.row(guesses[i + 1]) : nullptr;
+                scratch.histogram.count(fMap.row(guesses[i]), targets.begin(), targets.end(), nextRow);
+                best.consider(scratch.histogram);
+                if (stopScan(pruning, best, scratch.stats, guesses.size() - i - 1)) break;
+            }
+            return best.value();
+        }
+
+        // Best value of a bin searched to depth
+        double value(std::span<const WordIndex> targets, std::span<const WordIndex> fillers, size_t depth, Scratch& scratch) const {
+            const size_t n = targets.size();
+            if (n <= 2) return std::max(0.0, static_cast<double>(n) - 1.0);
+            if (depth == 1) return scan(targets, fillers, scratch);
+            return deepen(targets, fillers, depth, scratch, nullptr).value;
+        }
+
+        Scored deepen(std::span<const WordIndex> targets, std::span<const WordIndex> fillers, size_t depth, Scratch& scratch, parallel::TaskQueue* queue) const {
+            const size_t n = targets.size();
+            Words buffer;
+            const auto guesses = guessesOf(targets, fillers, buffer);
+
+            // Step 1: E1 of every guess, in chunks when on the queue
+            std::vector<double> depthOne(guesses.size());
+            const entropy::ProbabilityTable probabilities{n};
+            const size_t numChunks = queue ? std::min(queue->capacity(), guesses.size()) : 1;
+            forEach(queue, numChunks, scratch, [&](size_t chunk, Scratch& s) {
+                const size_t first = guesses.size() * chunk / numChunks;
+                const size_t last = guesses.size() * (chunk + 1) / numChunks;
+                for (size_t i = first; i < last; ++i) {
+                    const feedback::Encoding* nextRow = (i + 1 < last) ? fMap.row(guesses[i + 1]) : nullptr;
+                    s.histogram.count(fMap.row(guesses[i]), targets.begin(), targets.end(), nextRow);
+                    depthOne[i] = s.histogram.exactEntropy(probabilities);
+                }
+            });
+            std::vector<double> values = depthOne;
+
+            // Step 2: Each level expands the best of the one before. Only the last level's values decide the result,
+            // so it is the only one pruned.
+            std::vector<uint32_t> candidates(guesses.size());
+            std::iota(candidates.begin(), candidates.end(), 0);
+            for (size_t d = 2; d <= depth; ++d) {
+                std::vector<uint32_t> expanded(std::min(plan.widths[d], n));
+                std::partial_sort_copy(
+                    candidates.begin(), candidates.end(),
+                    expanded.begin(), expanded.end(),
+                    [&](uint32_t i, uint32_t j) { return selection::isBetter({values[i], guesses[i]}, {values[j], guesses[j]}); }
+                );
+                candidates = std::move(expanded);
+
+                std::atomic<double> best = std::numeric_limits<double>::lowest();
+                const bool prune = pruning && d == depth;
+                forEach(queue, candidates.size(), scratch, [&](size_t k, Scratch& s) {
+                    const uint32_t c = candidates[k];
+                    const Bins bins = split(guesses[c], targets, fillers);
+                    const auto gain = expansionGain(
+                        prune, depthOne[c], feedback::NUM_FEEDBACKS, n, d - 1,
+                        [&](size_t i) { return bins.targets[i].size(); },
+                        [&](size_t i) { return value(bins.targets[i], HardMode ? std::span<const WordIndex>{bins.fillers[i]} : std::span<const WordIndex>{}, d - 1, s); },
+                        best, s.stats
+                    );
+
+                    // An abandoned candidate falls back to E1, which is below the best total
+                    values[c] = gain ? depthOne[c] + *gain : depthOne[c];
+                    if (gain) raiseBest(best, values[c]);
+                });
+            }
+
+            // Step 3: Best of the deepest level, first among equals
+            Scored result{};
+            for (uint32_t c : candidates) {
+                if (result.value < values[c]) result = {values[c], guesses[c]};
+            }
+            return result;
+        }
+
+    public:
+        Engine(const feedback::FeedbackMatrixView& _fMap, const Plan& _plan, bool _pruning) noexcept
+        : fMap{_fMap}, plan{_plan}, pruning{_pruning} {}
+
+        // Best guess plan.depth ahead over targets (at least 3, ascending) and, in HardMode, fillers (ascending)
+        Scored search(std::span<const WordIndex> targets, std::span<const WordIndex> fillers, parallel::TaskQueue& queue, PruneStats& stats) const {
+            Scratch scratch;
+            const auto result = deepen(targets, fillers, plan.depth, scratch, &queue);
+            stats += scratch.stats;
+            return result;
+        }
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace wordle::util {
+
+/*
+Read-only, move-only memory mapping of an entire file.
+MappedFile::open returns an empty mapping (isOpen() == false) if the file is missing, empty, or can't be mapped.
+Pages are mapped MAP_SHARED, so every process mapping the same file shares one copy in the page cache.
+*/
+class MappedFile {
+    const std::byte* ptr = nullptr;
+    size_t length = 0;
+
+    void unmap() noexcept {
+        if (ptr) ::munmap(const_cast<std::byte*>(ptr), length);
+        ptr = nullptr;
+        length = 0;
+    }
+
+public:
+    MappedFile() noexcept = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+    : ptr{std::exchange(other.ptr, nullptr)},
+      length{std::exchange(other.length, 0)} {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            ptr = std::exchange(other.ptr, nullptr);
+            length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() noexcept { unmap(); }
+
+    static MappedFile open(std::string_view path) {
+        const std::string pathStr{path};
+        const int fd = ::open(pathStr.c_str(), O_RDONLY);
+        if (fd < 0) return {};
+
+        MappedFile file{};
+        struct stat info{};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            const size_t size = static_cast<size_t>(info.st_size);
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED) {
+                file.ptr = static_cast<const std::byte*>(addr);
+                file.length = size;
+            }
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+        return file;
+    }
+
+    bool isOpen() const noexcept { return ptr != nullptr; }
+
+    // Asks the kernel to back the mapping with huge pages where the filesystem allows it. Returns false if refused.
+    bool adviseHugePages() const noexcept {
+#ifdef MADV_HUGEPAGE
+        return ptr && ::madvise(const_cast<std::byte*>(ptr), length, MADV_HUGEPAGE) == 0;
+#else
+        return false;
+#endif
+    }
+
+    const std::byte* data() const noexcept { return ptr; }
+
+    size_t size() const noexcept { return length; }
+
+    std::span<const std::byte> bytes() const noexcept { return {ptr, length}; }
+};
+
+}  // namespace wordle::util
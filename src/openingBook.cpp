@@ -0,0 +1,106 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "feedbackCache.hpp"
+#include "mappedFile.hpp"
+#include "openingBook.hpp"
+
+wordle::book::OpeningBook::OpeningBook(Mode mode, size_t beamCandidates, uint32_t maxDepth, uint64_t vocabChecksum) noexcept
+: header{
+    MAGIC,
+    FORMAT_VERSION,
+    static_cast<uint8_t>(mode),
+    static_cast<uint8_t>(sizeof(wordle::feedback::Encoding)),
+    static_cast<uint16_t>(wordle::config::WORD_LENGTH),
+    beamCandidates,
+    maxDepth,
+    vocabChecksum,
+    0,
+    0
+} {}
+
+bool wordle::book::OpeningBook::matches(Mode mode, size_t beamCandidates, const wordle::vocab::Vocab& vocab) const noexcept {
+    return !empty()
+        && this->mode() == mode
+        && this->beamCandidates() == beamCandidates
+        && header.vocabChecksum == wordle::feedback::cache::vocabChecksum(vocab);
+}
+
+bool wordle::book::writeOpeningBook(std::string_view path, const OpeningBook& book) {
+    const std::filesystem::path target{path};
+    std::filesystem::path temporary{target};
+    temporary += ".tmp";
+
+    // Step 1: Write header and the three arrays to a temporary file
+    {
+        std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+        if (!file) return false;
+
+        auto writeArray = [&file](const auto& array) {
+            file.write(reinterpret_cast<const char*>(array.data()), static_cast<std::streamsize>(array.size() * sizeof(array[0])));
+        };
+        file.write(reinterpret_cast<const char*>(&book.header), sizeof(Header));
+        writeArray(book.nodes);
+        writeArray(book.childFeedbacks);
+        writeArray(book.childNodes);
+        if (!file.flush()) {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+    }
+
+    // Step 2: Atomically replace any existing book
+    std::error_code ec;
+    std::filesystem::rename(temporary, target, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<wordle::book::OpeningBook> wordle::book::readOpeningBook(std::string_view path, const wordle::vocab::Vocab& vocab) {
+    const auto file = wordle::util::MappedFile::open(path);
+    if (!file.isOpen() || file.size() < sizeof(Header)) return std::nullopt;
+
+    OpeningBook book;
+    std::memcpy(&book.header, file.data(), sizeof(Header));
+
+    const Header& header = book.header;
+    const bool isValid = header.magic == MAGIC
+        && header.version == FORMAT_VERSION
+        && header.encodingSize == sizeof(wordle::feedback::Encoding)
+        && header.wordLength == wordle::config::WORD_LENGTH
+        && header.vocabChecksum == wordle::feedback::cache::vocabChecksum(vocab)
+        && header.numNodes > 0
+        && header.numNodes < OFF_TREE
+        && header.numChildren < OFF_TREE;
+    if (!isValid) return std::nullopt;
+
+    const size_t expectedSize = sizeof(Header)
+        + header.numNodes * sizeof(Node)
+        + header.numChildren * (sizeof(wordle::feedback::Encoding) + sizeof(uint32_t));
+    if (file.size() != expectedSize) return std::nullopt;
+
+    // Step 1: Copy the arrays out of the mapping (books are small, and this sidesteps alignment)
+    const std::byte* cursor = file.data() + sizeof(Header);
+    auto readArray = [&cursor](auto& array, size_t count) {
+        array.resize(count);
+        std::memcpy(array.data(), cursor, count * sizeof(array[0]));
+        cursor += count * sizeof(array[0]);
+    };
+    readArray(book.nodes, header.numNodes);
+    readArray(book.childFeedbacks, header.numChildren);
+    readArray(book.childNodes, header.numChildren);
+
+    // Step 2: Reject books whose edges point outside of them
+    for (const Node& node : book.nodes) {
+        if (node.guess >= wordle::config::NUM_WORDS || uint64_t{node.firstChild} + node.numChildren > header.numChildren) return std::nullopt;
+    }
+    for (uint32_t child : book.childNodes) {
+        if (child >= header.numNodes) return std::nullopt;
+    }
+    return book;
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "feedback.hpp"
+#include "feedbackCache.hpp"
+#include "guard.hpp"
+#include "vocab.hpp"
+
+/*
+Opening book: the bot's suggestion at every reachable node of the game tree, recorded once and served by lookup.
+
+A node is one game state (the history of guesses and feedbacks so far). It stores the suggestion made there and
+one child per feedback the suggested guess can receive from an alive target. Children of a node are contiguous and
+sorted by feedback, so following a feedback is a binary search over at most NUM_FEEDBACKS bytes.
+
+File layout (native endianness):
+    [Header][Node x numNodes][Encoding x numChildren][uint32_t x numChildren]
+A book is only valid for the mode, beam width and vocab it was built with.
+*/
+namespace wordle::book {
+
+    enum class Mode : uint8_t { EASY = 0, HARD };
+
+    constexpr inline std::array<char, 8> MAGIC{'W', 'R', 'D', 'L', 'B', 'O', 'O', 'K'};
+    constexpr inline uint32_t FORMAT_VERSION = 4;  // Bump whenever the bots' suggestions change (2: EasyBot bins no longer repeat targets, 3: ties go to the lowest index, 4: EasyBot's beam narrows to the alive targets)
+    constexpr inline uint32_t NO_DEPTH_LIMIT = std::numeric_limits<uint32_t>::max();
+    constexpr inline uint32_t OFF_TREE = std::numeric_limits<uint32_t>::max();
+    constexpr inline uint32_t ROOT = 0;
+    constexpr inline size_t SOLVER_BEAM = 0;  // Beam width recorded by solver strategies (see solver.hpp), which no bot has
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint8_t mode;
+        uint8_t encodingSize;
+        uint16_t wordLength;
+        uint64_t beamCandidates;
+        uint64_t maxDepth;
+        uint64_t vocabChecksum;
+        uint64_t numNodes;
+        uint64_t numChildren;
+    };
+
+    struct Node {
+        double entropy;       // Entropy reported by the suggestion
+        uint32_t firstChild;  // Index of the first child edge
+        uint16_t guess;       // Suggested guess (index into vocab)
+        uint16_t numChildren; // 0 at leaves: every alive target is solved by guess, or the depth limit was reached
+    };
+    static_assert(config::NUM_WORDS <= std::numeric_limits<uint16_t>::max());
+
+    class OpeningBook {
+        Header header{};
+        std::vector<Node> nodes;
+        std::vector<feedback::Encoding> childFeedbacks;  // Parallel to childNodes, sorted within each node
+        std::vector<uint32_t> childNodes;
+
+        template <typename Bot>
+        friend class Builder;
+        friend bool writeOpeningBook(std::string_view path, const OpeningBook& book);
+        friend std::optional<OpeningBook> readOpeningBook(std::string_view path, const vocab::Vocab& vocab);
+
+    public:
+        OpeningBook() noexcept = default;
+        OpeningBook(Mode mode, size_t beamCandidates, uint32_t maxDepth, uint64_t vocabChecksum) noexcept;
+
+        [[nodiscard]] Mode mode() const noexcept { return static_cast<Mode>(header.mode); }
+        [[nodiscard]] size_t beamCandidates() const noexcept { return header.beamCandidates; }
+        [[nodiscard]] uint32_t maxDepth() const noexcept { return static_cast<uint32_t>(header.maxDepth); }
+        [[nodiscard]] uint64_t vocabChecksum() const noexcept { return header.vocabChecksum; }
+        [[nodiscard]] size_t size() const noexcept { return nodes.size(); }
+        [[nodiscard]] bool empty() const noexcept { return nodes.empty(); }
+
+        [[nodiscard]] const Node& operator[](uint32_t node) const noexcept { return nodes[node]; }
+
+        // Node reached from node by feedback to its guess, or OFF_TREE if it was never recorded
+        [[nodiscard]] uint32_t child(uint32_t node, feedback::Encoding fbEncoding) const noexcept {
+            const Node& parent = nodes[node];
+            const auto first = childFeedbacks.begin() + parent.firstChild;
+            const auto last = first + parent.numChildren;
+            const auto it = std::lower_bound(first, last, fbEncoding);
+            if (it == last || *it != fbEncoding) return OFF_TREE;
+            return childNodes[parent.firstChild + std::distance(first, it)];
+        }
+
+        // Returns true if this book was built for the given bot configuration and vocab
+        [[nodiscard]] bool matches(Mode mode, size_t beamCandidates, const vocab::Vocab& vocab) const noexcept;
+    };
+
+    // Writes book to path (via a temporary file and rename). Returns false if the file could not be written.
+    bool writeOpeningBook(std::string_view path, const OpeningBook& book);
+
+    // Reads the book at path. Returns std::nullopt if it is missing, truncated or stale for vocab.
+    [[nodiscard]] std::optional<OpeningBook> readOpeningBook(std::string_view path, const vocab::Vocab& vocab);
+
+    /*
+    Position of one game in a book. Follows filter() calls while they stay on recorded nodes.
+    Once a guess differs from the recorded one, or a feedback was never recorded, the game is off the tree for good.
+    */
+    class Cursor {
+        const OpeningBook* book = nullptr;
+        uint32_t node = OFF_TREE;
+
+    public:
+        Cursor() noexcept = default;
+        explicit Cursor(const OpeningBook* _book) noexcept : book{_book}, node{_book && !_book->empty() ? ROOT : OFF_TREE} {}
+
+        void reset() noexcept {
+            node = book && !book->empty() ? ROOT : OFF_TREE;
+        }
+
+        void advance(size_t guessIndex, feedback::Encoding fbEncoding) noexcept {
+            if (node == OFF_TREE) return;
+            const Node& current = (*book)[node];
+            node = current.guess == guessIndex ? book->child(node, fbEncoding) : OFF_TREE;
+        }
+
+        // Recorded node for the current game state, or nullptr off the tree
+        [[nodiscard]] const Node* current() const noexcept {
+            return node == OFF_TREE ? nullptr : &(*book)[node];
+        }
+    };
+
+    /*
+    Walks the game tree of bot depth-first from the root and records bot.suggest() at every node.
+    Bot must provide reset(), filter(), suggest(), getAliveTargets(), getFMap(), getVocab(), getBeamCandidates(),
+    getLookahead() and BOOK_MODE. Books record the standard two-level search only.
+    Every node is reached by replaying its history from reset(), so the bot's own state is the only state.
+    */
+    template <typename Bot>
+    class Builder {
+        using History = std::vector<std::pair<size_t, feedback::Encoding>>;
+
+        Bot& bot;
+        OpeningBook book;
+        History history;
+
+        uint32_t visit(uint32_t depth) {
+            // Step 1: Restore the game state and record the suggestion
+            bot.reset();
+            for (const auto& [guessIndex, fbEncoding] : history) bot.filter(guessIndex, fbEncoding);
+
+            const auto suggestion = bot.suggest();
+            guard::hybridGuard(suggestion.isValid, "opening book reached a state without suggestions");
+
+            const auto nodeIndex = static_cast<uint32_t>(book.nodes.size());
+            book.nodes.push_back({suggestion.entropy, static_cast<uint32_t>(book.childFeedbacks.size()), static_cast<uint16_t>(suggestion.guessIndex), 0});
+            if (depth + 1 >= book.maxDepth()) return nodeIndex;
+
+            // Step 2: Collect every feedback an alive target can give, except the one that ends the game
+            std::array<bool, feedback::NUM_FEEDBACKS> seen{};
+            const auto& fMap = bot.getFMap();
+            for (auto targetIndex : bot.getAliveTargets()) {
+                if (targetIndex == suggestion.guessIndex) continue;
+                seen[fMap[targetIndex][suggestion.guessIndex]] = true;
+            }
+
+            std::vector<feedback::Encoding> feedbacks;
+            for (size_t fb = 0; fb < feedback::NUM_FEEDBACKS; ++fb) {
+                if (seen[fb]) feedbacks.push_back(static_cast<feedback::Encoding>(fb));
+            }
+
+            // Step 3: Reserve this node's contiguous child range, then fill it depth-first
+            const size_t firstChild = book.childFeedbacks.size();
+            book.nodes[nodeIndex].firstChild = static_cast<uint32_t>(firstChild);
+            book.nodes[nodeIndex].numChildren = static_cast<uint16_t>(feedbacks.size());
+            book.childFeedbacks.insert(book.childFeedbacks.end(), feedbacks.begin(), feedbacks.end());
+            book.childNodes.resize(book.childFeedbacks.size(), OFF_TREE);
+
+            for (size_t i = 0; i < feedbacks.size(); ++i) {
+                history.emplace_back(suggestion.guessIndex, feedbacks[i]);
+                const uint32_t child = visit(depth + 1);
+                book.childNodes[firstChild + i] = child;
+                history.pop_back();
+            }
+            return nodeIndex;
+        }
+
+    public:
+        explicit Builder(Bot& _bot, uint32_t maxDepth = NO_DEPTH_LIMIT)
+        : bot{_bot},
+          book{Bot::BOOK_MODE, _bot.getBeamCandidates(), maxDepth, feedback::cache::vocabChecksum(_bot.getVocab())} {
+            guard::hybridGuard<std::invalid_argument>(maxDepth > 0, "opening book depth must be at least 1");
+            guard::hybridGuard<std::invalid_argument>(_bot.getLookahead().isStandard(_bot.getBeamCandidates()), "opening books record the standard two-level search");
+        }
+
+        // Builds the book and leaves bot reset
+        OpeningBook build() && {
+            history.clear();
+            visit(0);
+            book.header.numNodes = book.nodes.size();
+            book.header.numChildren = book.childNodes.size();
+            bot.reset();
+            return std::move(book);
+        }
+    };
+
+}  // namespace wordle::book
@@ -1,48 +1,261 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
+#include "config.hpp"
 #include "guard.hpp"
+#include "topology.hpp"
 
 namespace wordle::parallel {
     template <typename Func, typename... Args>
     concept VoidCallable = std::is_invocable_r_v<void, Func, Args...>;
 
-    struct TaskQueue {    
+    using Task = std::function<void()>;
+
+    namespace __impl {
+        // Queued task plus the scope that forked it, so joins only help with their own work
+        struct ScopedTask {
+            Task run;
+            const void* owner = nullptr;
+        };
+    }
+
+    /*
+    Long-lived pool of worker threads with one deque per worker.
+    Workers pop their own deque LIFO and steal from the others FIFO; idle workers spin briefly, then sleep.
+    Tasks submitted from a worker land on that worker's deque, external submissions are spread round-robin.
+    */
+    class ThreadPool {
+    private:
+        struct alignas(config::CACHE_LINE_SIZE) WorkerQueue {
+            std::mutex mtx;
+            std::deque<__impl::ScopedTask> tasks;
+        };
+
+        static constexpr size_t SPIN_ROUNDS = 64;  // Polls before an idle worker goes to sleep
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> workers;
+        alignas(config::CACHE_LINE_SIZE) std::atomic_size_t queued = 0;
+        alignas(config::CACHE_LINE_SIZE) std::atomic_size_t nextQueue = 0;
+        std::mutex sleepMtx;
+        std::condition_variable sleepCv;
+        bool stopping = false;
+
+        // Identifies the pool (and deque) owned by the current thread, if it is a worker
+        static inline thread_local const ThreadPool* currentPool = nullptr;
+        static inline thread_local size_t currentIndex = 0;
+
+        bool popLocal(size_t index, Task& task) {
+            auto& queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            if (queue.tasks.empty()) return false;
+            task = std::move(queue.tasks.back().run);
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        bool steal(size_t thief, Task& task) {
+            const size_t n = queues.size();
+            for (size_t offset = 1; offset <= n; ++offset) {
+                auto& queue = *queues[(thief + offset) % n];
+                std::lock_guard<std::mutex> lock(queue.mtx);
+                if (queue.tasks.empty()) continue;
+                task = std::move(queue.tasks.front().run);
+                queue.tasks.pop_front();
+                return true;
+            }
+            return false;
+        }
+
+        // Takes the oldest task forked by owner from any deque
+        bool stealOwned(const void* owner, Task& task) {
+            for (auto& queue : queues) {
+                std::lock_guard<std::mutex> lock(queue->mtx);
+                auto it = std::find_if(queue->tasks.begin(), queue->tasks.end(), [owner](const __impl::ScopedTask& t) { return t.owner == owner; });
+                if (it == queue->tasks.end()) continue;
+                task = std::move(it->run);
+                queue->tasks.erase(it);
+                return true;
+            }
+            return false;
+        }
+
+        bool tryAcquire(size_t index, Task& task) {
+            if (queued.load(std::memory_order_acquire) == 0) return false;
+            if (!popLocal(index, task) && !steal(index, task)) return false;
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        void run(size_t index) {
+            currentPool = this;
+            currentIndex = index;
+
+            Task task;
+            while (true) {
+                bool found = false;
+                for (size_t spin = 0; spin < SPIN_ROUNDS && !found; ++spin) {
+                    found = tryAcquire(index, task);
+                    if (!found) std::this_thread::yield();
+                }
+
+                if (found) {
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(sleepMtx);
+                sleepCv.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+                if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+            }
+        }
+
+    public:
+        explicit ThreadPool(size_t numThreads = config::HARDWARE_CONCURRENCY) {
+            guard::hybridGuard<std::invalid_argument>(numThreads > 0, "ThreadPool requires at least one thread");
+            queues.reserve(numThreads);
+            for (size_t i = 0; i < numThreads; ++i) queues.push_back(std::make_unique<WorkerQueue>());
+
+            workers.reserve(numThreads);
+            for (size_t i = 0; i < numThreads; ++i) workers.emplace_back(&ThreadPool::run, this, i);
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Drains remaining tasks, then joins every worker
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(sleepMtx);
+                stopping = true;
+            }
+            sleepCv.notify_all();
+            for (auto& worker : workers) worker.join();
+        }
+
+        void submit(Task task, const void* owner = nullptr) {
+            const bool isOwnWorker = currentPool == this;
+            const size_t index = isOwnWorker ? currentIndex : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                auto& queue = *queues[index];
+                std::lock_guard<std::mutex> lock(queue.mtx);
+                queue.tasks.push_back({std::move(task), owner});
+            }
+            queued.fetch_add(1, std::memory_order_release);
+
+            // Taking sleepMtx orders the increment before any sleeper re-checks its predicate
+            { std::lock_guard<std::mutex> lock(sleepMtx); }
+            sleepCv.notify_one();
+        }
+
+        /*
+        Runs one queued task forked by owner on the calling thread. Returns false if none was available.
+        Restricting helpers to their own scope keeps a join from picking up unrelated (possibly blocking) work.
+        */
+        bool tryRunOne(const void* owner) {
+            if (queued.load(std::memory_order_acquire) == 0) return false;
+            Task task;
+            if (!stealOwned(owner, task)) return false;
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            return true;
+        }
+
+        /*
+        Pins worker i to cpuSets[i % cpuSets.size()]; Topology::spread() places workers round-robin across NUMA nodes.
+        Returns false if any worker could not be pinned.
+        */
+        bool pin(const std::vector<topology::CpuSet>& cpuSets) noexcept {
+            if (cpuSets.empty()) return false;
+            bool isPinned = true;
+            for (size_t i = 0; i < workers.size(); ++i) {
+                isPinned &= topology::pinThread(workers[i].native_handle(), cpuSets[i % cpuSets.size()]);
+            }
+            return isPinned;
+        }
+
+        // Returns number of worker threads
+        size_t size() const noexcept {
+            return workers.size();
+        }
+    };
+
+    /*
+    Fork/join scope over a ThreadPool: push() forks tasks, wait() joins every task pushed through this queue.
+    The waiting thread helps run queued tasks instead of blocking. Several queues may share one pool.
+    */
+    struct TaskQueue {
     private:
-        std::vector<std::thread> threadPool;
+        std::shared_ptr<ThreadPool> pool;
+        alignas(config::CACHE_LINE_SIZE) std::atomic_size_t pending = 0;
+        std::mutex waitMtx;
+        std::condition_variable waitCv;
 
     public:
-        TaskQueue() noexcept = default;
-        TaskQueue(std::size_t initialCapacity) noexcept {
-            threadPool.reserve(initialCapacity);
+        TaskQueue() : TaskQueue(config::HARDWARE_CONCURRENCY) {}
+
+        // Creates a private pool of numThreads workers
+        TaskQueue(std::size_t numThreads) : pool{std::make_shared<ThreadPool>(numThreads)} {}
+
+        // Joins an existing pool
+        TaskQueue(std::shared_ptr<ThreadPool> sharedPool) : pool{std::move(sharedPool)} {
+            guard::hybridGuard<std::invalid_argument>(pool != nullptr, "TaskQueue requires a pool");
         }
+
+        TaskQueue(const TaskQueue&) = delete;
+        TaskQueue& operator=(const TaskQueue&) = delete;
         ~TaskQueue() { wait(); }
 
         template <typename Func, typename... Args>
             requires VoidCallable<Func, Args...>
         void push(Func&& func, Args&&... args) {
-            threadPool.emplace_back(std::forward<Func>(func), std::forward<Args>(args)...);
+            pending.fetch_add(1, std::memory_order_relaxed);
+            pool->submit([this, task = std::forward<Func>(func), ...taskArgs = std::forward<Args>(args)]() mutable {
+                std::invoke(task, taskArgs...);
+
+                // Decrement under waitMtx so wait() can't return (and destroy us) mid-notify
+                std::lock_guard<std::mutex> lock(waitMtx);
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) waitCv.notify_all();
+            }, this);
         }
 
-        // Blocks local thread until all tasks finish
+        // Blocks local thread until all tasks pushed through this queue finish
         void wait() {
-            while (!threadPool.empty()) {
-                auto thread = std::move(threadPool.back());
-                threadPool.pop_back();
-                thread.join();
+            while (pending.load(std::memory_order_acquire) > 0) {
+                if (pool->tryRunOne(this)) continue;
+
+                std::unique_lock<std::mutex> lock(waitMtx);
+                waitCv.wait_for(lock, std::chrono::microseconds{50}, [this] { return pending.load(std::memory_order_acquire) == 0; });
             }
+
+            // The last task may still hold waitMtx while notifying
+            std::lock_guard<std::mutex> lock(waitMtx);
         }
 
-        // Returns number of threads in TaskQueue
+        // Returns number of tasks pushed but not yet finished
         size_t size() const noexcept {
-            return threadPool.size();
+            return pending.load(std::memory_order_acquire);
         }
 
-        // Returns capacity of threadPool
+        // Returns number of worker threads in the underlying pool
         size_t capacity() const noexcept {
-            return threadPool.capacity();
+            return pool->size();
+        }
+
+        // Returns the underlying pool so other queues can share it
+        const std::shared_ptr<ThreadPool>& threadPool() const noexcept {
+            return pool;
         }
     };
-}
\ No newline at end of file
+}
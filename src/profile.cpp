@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "profile.hpp"
+
+namespace {
+    using namespace wordle::profile;
+
+    std::atomic_bool countersRequested = false;
+
+#ifdef __linux__
+    constexpr std::array<uint64_t, NUM_COUNTERS> PERF_CONFIGS{
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    // Counts for this thread in user space only, read together through the group leader
+    int openCounter(Counter counter, int groupFd) noexcept {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_CONFIGS[static_cast<size_t>(counter)];
+        attr.disabled = groupFd == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+    }
+
+    void enableGroup(int leaderFd) noexcept {
+        ::ioctl(leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#else
+    // perf_event_open is Linux only, so counters are reported as unavailable elsewhere
+    int openCounter(Counter, int) noexcept { return -1; }
+
+    void enableGroup(int) noexcept {}
+#endif
+
+    // Single writer (the owning thread), so a relaxed load and store is enough for report() to read it
+    inline void add(std::atomic_uint64_t& total, uint64_t value) noexcept {
+        total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+struct wordle::profile::__impl::ThreadProfile {
+    std::array<std::atomic_uint64_t, NUM_PHASES> calls{};
+    std::array<std::atomic_uint64_t, NUM_PHASES> nanos{};
+    std::array<std::array<std::atomic_uint64_t, NUM_COUNTERS>, NUM_PHASES> counters{};
+    std::atomic_bool hasCounters = false;
+
+    std::array<int, NUM_COUNTERS> fds{-1, -1, -1};  // fds[0] leads the group
+    bool isOpened = false;                          // Opening was attempted
+
+    ~ThreadProfile() {
+        for (int fd : fds) if (fd >= 0) ::close(fd);
+    }
+
+    // Opens the counter group once, leaving every fd closed if any counter is unavailable
+    bool open() noexcept {
+        if (isOpened) return fds[0] >= 0;
+        isOpened = true;
+        for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+            fds[i] = openCounter(static_cast<Counter>(i), fds[0]);
+            if (fds[i] >= 0) continue;
+            for (int& fd : fds) {
+                if (fd >= 0) ::close(fd);
+                fd = -1;
+            }
+            return false;
+        }
+        enableGroup(fds[0]);
+        return true;
+    }
+
+    bool read(CounterValues& values) const noexcept {
+        struct { uint64_t count; uint64_t values[NUM_COUNTERS]; } group;
+        if (::read(fds[0], &group, sizeof(group)) != static_cast<ssize_t>(sizeof(group))) return false;
+        std::copy(std::begin(group.values), std::end(group.values), values.begin());
+        return true;
+    }
+};
+
+namespace {
+    // Profiles outlive their threads, so totals of finished threads stay in reports
+    std::mutex registryMtx;
+    std::vector<std::shared_ptr<wordle::profile::__impl::ThreadProfile>> registry;
+}
+
+wordle::profile::__impl::ThreadProfile& wordle::profile::__impl::threadProfile() {
+    thread_local const std::shared_ptr<ThreadProfile> profile = [] {
+        auto created = std::make_shared<ThreadProfile>();
+        std::lock_guard<std::mutex> lock(registryMtx);
+        registry.push_back(created);
+        return created;
+    }();
+    return *profile;
+}
+
+bool wordle::profile::__impl::readCounters(ThreadProfile& profile, CounterValues& values) noexcept {
+    if (!countersRequested.load(std::memory_order_relaxed) || !profile.open()) return false;
+    return profile.read(values);
+}
+
+void wordle::profile::__impl::record(ThreadProfile& profile, Phase phase, uint64_t nanos, const CounterValues* counters) noexcept {
+    const auto p = static_cast<size_t>(phase);
+    add(profile.calls[p], 1);
+    add(profile.nanos[p], nanos);
+    if (!counters) return;
+    for (size_t c = 0; c < NUM_COUNTERS; ++c) add(profile.counters[p][c], (*counters)[c]);
+    profile.hasCounters.store(true, std::memory_order_relaxed);
+}
+
+wordle::profile::Scope::Scope(Phase _phase) noexcept
+: profile{__impl::threadProfile()},
+  phase{_phase},
+  startCounters{},
+  hasCounters{__impl::readCounters(profile, startCounters)},
+  start{std::chrono::steady_clock::now()} {}
+
+wordle::profile::Scope::~Scope() {
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    CounterValues counters{};
+    const bool isCounted = hasCounters && profile.read(counters);
+    if (isCounted) {
+        for (size_t c = 0; c < NUM_COUNTERS; ++c) counters[c] -= startCounters[c];
+    }
+    __impl::record(profile, phase, static_cast<uint64_t>(nanos), isCounted ? &counters : nullptr);
+}
+
+bool wordle::profile::useHardwareCounters(bool enable) {
+    countersRequested.store(enable, std::memory_order_relaxed);
+    return enable && __impl::threadProfile().open();
+}
+
+wordle::profile::Report wordle::profile::report() {
+    Report result;
+    std::lock_guard<std::mutex> lock(registryMtx);
+    for (const auto& profile : registry) {
+        bool isUsed = false;
+        for (size_t p = 0; p < NUM_PHASES; ++p) {
+            auto& totals = result.phases[p];
+            totals.calls += profile->calls[p].load(std::memory_order_relaxed);
+            totals.nanos += profile->nanos[p].load(std::memory_order_relaxed);
+            for (size_t c = 0; c < NUM_COUNTERS; ++c) totals.counters[c] += profile->counters[p][c].load(std::memory_order_relaxed);
+            isUsed |= profile->calls[p].load(std::memory_order_relaxed) > 0;
+        }
+        result.threads += isUsed;
+        result.hasCounters |= profile->hasCounters.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void wordle::profile::reset() {
+    std::lock_guard<std::mutex> lock(registryMtx);
+    for (const auto& profile : registry) {
+        for (size_t p = 0; p < NUM_PHASES; ++p) {
+            profile->calls[p].store(0, std::memory_order_relaxed);
+            profile->nanos[p].store(0, std::memory_order_relaxed);
+            for (auto& counter : profile->counters[p]) counter.store(0, std::memory_order_relaxed);
+        }
+        profile->hasCounters.store(false, std::memory_order_relaxed);
+    }
+}
+
+std::string wordle::profile::Report::format() const {
+    std::string table = std::format("{:<16}{:>12}{:>12}{:>12}", "Phase", "Calls", "Total ms", "Mean us");
+    if (hasCounters) {
+        for (auto name : COUNTER_NAMES) table += std::format("{:>16}", std::string{name} + " (M)");
+    }
+    table += '\n';
+
+    for (size_t p = 0; p < NUM_PHASES; ++p) {
+        const auto& totals = phases[p];
+        if (!totals.calls) continue;
+        table += std::format("{:<16}{:>12}{:>12.1f}{:>12.1f}", PHASE_NAMES[p], totals.calls,
+                             static_cast<double>(totals.nanos) / 1e6, static_cast<double>(totals.nanos) / 1e3 / static_cast<double>(totals.calls));
+        if (hasCounters) {
+            for (uint64_t count : totals.counters) table += std::format("{:>16.2f}", static_cast<double>(count) / 1e6);
+        }
+        table += '\n';
+    }
+    table += std::format("{} threads; phases after search are summed over worker threads\n", threads);
+    return table;
+}
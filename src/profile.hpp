@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+Hot-path instrumentation for the phases of suggest(): scoped timers summed per thread, optionally carrying hardware
+counters (cycles, cache misses, branch misses) read through perf_event_open.
+
+WORDLE_PROFILE_SCOPE(phase) compiles to nothing unless the library is built with WORDLE_PROFILE (the CMake option of
+the same name), so the bots pay nothing by default. The API below exists either way and reports nothing recorded.
+Counters are opt-in at runtime, since reading them costs a syscall per scope, and stay off where the kernel doesn't
+permit perf events (see /proc/sys/kernel/perf_event_paranoid) or on platforms other than Linux.
+*/
+namespace wordle::profile {
+
+#ifdef WORDLE_PROFILE
+    constexpr inline bool ENABLED = true;
+#else
+    constexpr inline bool ENABLED = false;
+#endif
+
+    // SEARCH spans one whole search on the calling thread, the others are entered by each worker thread
+    enum class Phase : uint8_t { SEARCH = 0, FIRST_PASS, BARRIER, TOP_CANDIDATES, CANDIDATE_BINS, BIN_ENTROPY };
+    constexpr inline size_t NUM_PHASES = 6;
+    constexpr inline std::array<std::string_view, NUM_PHASES> PHASE_NAMES{
+        "search", "first pass", "barrier", "top candidates", "candidate bins", "bin entropy"
+    };
+
+    enum class Counter : uint8_t { CYCLES = 0, CACHE_MISSES, BRANCH_MISSES };
+    constexpr inline size_t NUM_COUNTERS = 3;
+    constexpr inline std::array<std::string_view, NUM_COUNTERS> COUNTER_NAMES{"cycles", "cache misses", "branch misses"};
+
+    using CounterValues = std::array<uint64_t, NUM_COUNTERS>;
+
+    struct PhaseTotals {
+        uint64_t calls = 0;
+        uint64_t nanos = 0;
+        CounterValues counters{};  // Only scopes measured with counters add to these
+    };
+
+    struct Report {
+        std::array<PhaseTotals, NUM_PHASES> phases{};
+        size_t threads = 0;        // Threads that entered a scope
+        bool hasCounters = false;  // Some scope was measured with hardware counters
+
+        [[nodiscard]] const PhaseTotals& operator[](Phase phase) const noexcept { return phases[static_cast<size_t>(phase)]; }
+
+        // Table with one row per phase entered
+        [[nodiscard]] std::string format() const;
+    };
+
+    // Reads hardware counters in scopes entered from now on (false stops). Returns whether they could be opened.
+    bool useHardwareCounters(bool enable);
+
+    // Totals of every thread since the last reset()
+    [[nodiscard]] Report report();
+
+    // Clears every thread's totals (call while no scope is open)
+    void reset();
+
+    namespace __impl {
+        struct ThreadProfile;
+
+        // This thread's totals, registered on first use
+        ThreadProfile& threadProfile();
+
+        // Reads this thread's counters into values, returning false when they aren't in use
+        bool readCounters(ThreadProfile& profile, CounterValues& values) noexcept;
+
+        void record(ThreadProfile& profile, Phase phase, uint64_t nanos, const CounterValues* counters) noexcept;
+    }
+
+    // Records its lifetime as one call of phase on this thread
+    class Scope {
+        __impl::ThreadProfile& profile;
+        Phase phase;
+        CounterValues startCounters;
+        bool hasCounters;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit Scope(Phase _phase) noexcept;
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+}  // namespace wordle::profile
+
+#ifdef WORDLE_PROFILE
+#define WORDLE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define WORDLE_PROFILE_CONCAT(a, b) WORDLE_PROFILE_CONCAT_IMPL(a, b)
+#define WORDLE_PROFILE_SCOPE(phase) const ::wordle::profile::Scope WORDLE_PROFILE_CONCAT(profileScope, __LINE__){::wordle::profile::Phase::phase}
+#else
+#define WORDLE_PROFILE_SCOPE(phase) static_cast<void>(0)
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "histogram.hpp"
+
+/*
+Top-k selection for the bots' first pass.
+
+Each search worker offers its scores to its own TopK as it computes them. The k best overall are then merged from the
+workers' sorted lists (k entries each), so no thread sorts every guess while the others wait. Entries are ordered by
+value, highest first, then by lowest index, which keeps the selection independent of how guesses were split up.
+*/
+namespace wordle::selection {
+
+    struct Entry {
+        double value;
+        histogram::WordIndex index;
+    };
+
+    // Higher values first, lower indices among equal values
+    constexpr bool isBetter(const Entry& a, const Entry& b) noexcept {
+        return a.value > b.value || (a.value == b.value && a.index < b.index);
+    }
+
+    class TopK {
+        std::vector<Entry> entries;  // Heap with the worst kept entry on top until finish() sorts it best first
+        size_t k = 0;
+        bool finished = false;
+
+    public:
+        // Empties the selection, which keeps the best _k entries from now on. The buffer is reused.
+        void reset(size_t _k) {
+            k = _k;
+            finished = false;
+            entries.clear();
+            entries.reserve(k);
+        }
+
+        void offer(double value, size_t index) {
+            const Entry entry{value, static_cast<histogram::WordIndex>(index)};
+            if (entries.size() < k) {
+                entries.push_back(entry);
+                std::push_heap(entries.begin(), entries.end(), isBetter);
+                return;
+            }
+            if (k == 0 || !isBetter(entry, entries.front())) return;
+            std::pop_heap(entries.begin(), entries.end(), isBetter);
+            entries.back() = entry;
+            std::push_heap(entries.begin(), entries.end(), isBetter);
+        }
+
+        // Sorts the kept entries best first. No more offers until reset().
+        void finish() {
+            std::sort_heap(entries.begin(), entries.end(), isBetter);
+            finished = true;
+        }
+
+        [[nodiscard]] bool isFinished() const noexcept { return finished; }
+
+        // Kept entries, best first once finished
+        [[nodiscard]] std::span<const Entry> sorted() const noexcept { return entries; }
+    };
+
+    /*
+    Visits the entries of the finished lists in merged order, best first, until limit entries were visited or visit
+    returns false. Unfinished lists are skipped.
+    */
+    template <typename Visit>
+    void visitMerged(std::span<const TopK> lists, size_t limit, Visit&& visit) {
+        std::vector<size_t> heads(lists.size(), 0);
+        for (size_t visited = 0; visited < limit; ++visited) {
+            const Entry* best = nullptr;
+            size_t bestList = 0;
+            for (size_t i = 0; i < lists.size(); ++i) {
+                if (!lists[i].isFinished() || heads[i] == lists[i].sorted().size()) continue;
+                const Entry& head = lists[i].sorted()[heads[i]];
+                if (!best || isBetter(head, *best)) {
+                    best = &head;
+                    bestList = i;
+                }
+            }
+            if (!best || !visit(*best)) return;
+            ++heads[bestList];
+        }
+    }
+
+    // Writes the indices of the best out.size() entries of the finished lists to out, best first. Returns how many.
+    inline size_t merge(std::span<const TopK> lists, std::span<histogram::WordIndex> out) {
+        size_t written = 0;
+        visitMerged(lists, out.size(), [&](const Entry& entry) {
+            out[written++] = entry.index;
+            return true;
+        });
+        return written;
+    }
+
+}  // namespace wordle::selection
@@ -0,0 +1,429 @@
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "server.hpp"
+
+namespace {
+    using Tokens = std::vector<std::string_view>;
+
+    Tokens tokenize(std::string_view line) {
+        Tokens tokens;
+        size_t start = line.find_first_not_of(" \t\r");
+        while (start != std::string_view::npos) {
+            const size_t stop = line.find_first_of(" \t\r", start);
+            tokens.push_back(line.substr(start, stop - start));
+            start = line.find_first_not_of(" \t\r", stop);
+        }
+        return tokens;
+    }
+
+    std::optional<wordle::server::SessionId> parseSession(const Tokens& tokens) {
+        if (tokens.size() < 2) return std::nullopt;
+        wordle::server::SessionId id = 0;
+        const auto [end, ec] = std::from_chars(tokens[1].data(), tokens[1].data() + tokens[1].size(), id);
+        if (ec != std::errc{} || end != tokens[1].data() + tokens[1].size()) return std::nullopt;
+        return id;
+    }
+
+    bool takesSession(std::string_view command) noexcept {
+        return command == "suggest" || command == "filter" || command == "reset" || command == "close";
+    }
+
+    std::string_view filterError(wordle::bot::FilterFlag flag) noexcept {
+        switch (flag) {
+            case wordle::bot::FilterFlag::INVALID_GUESS_AND_FEEDBACK : return "err invalid guess and feedback";
+            case wordle::bot::FilterFlag::INVALID_GUESS : return "err invalid guess";
+            case wordle::bot::FilterFlag::INVALID_FEEDBACK : return "err invalid feedback";
+            default : return "err";
+        }
+    }
+
+    // Writes all of bytes, without raising SIGPIPE if a socket peer went away. Returns false on failure.
+    bool writeAll(int fd, std::string_view bytes) {
+        while (!bytes.empty()) {
+            ssize_t written = ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+            if (written < 0 && errno == ENOTSOCK) written = ::write(fd, bytes.data(), bytes.size());
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            bytes.remove_prefix(static_cast<size_t>(written));
+        }
+        return true;
+    }
+}
+
+void wordle::server::LatencyHistogram::record(uint64_t micros) noexcept {
+    const size_t bucket = std::min<size_t>(std::bit_width(micros), NUM_BUCKETS - 1);
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = maxMicros.load(std::memory_order_relaxed);
+    while (micros > seen && !maxMicros.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {}
+}
+
+uint64_t wordle::server::LatencyHistogram::count() const noexcept {
+    uint64_t total = 0;
+    for (const auto& bucket : buckets) total += bucket.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t wordle::server::LatencyHistogram::percentile(double p) const noexcept {
+    const uint64_t total = count();
+    if (total == 0) return 0;
+
+    const auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total)));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+        seen += buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= std::max<uint64_t>(rank, 1)) return bucket == 0 ? 0 : (uint64_t{1} << bucket) - 1;
+    }
+    return max();
+}
+
+template <typename Bot>
+Bot& wordle::server::__impl::BotPool<Bot>::acquire() {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (idle.empty() && bots.size() < limit) {
+        auto& bot = *bots.emplace_back(std::make_unique<Bot>(context, suggestThreads));
+        if (openingBook) bot.useOpeningBook(openingBook);
+        bot.useSuggestionCache(suggestionCache);
+        return bot;
+    }
+    cv.wait(lock, [this] { return !idle.empty(); });
+    Bot* bot = idle.back();
+    idle.pop_back();
+    return *bot;
+}
+
+template <typename Bot>
+void wordle::server::__impl::BotPool<Bot>::release(Bot& bot) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        idle.push_back(&bot);
+    }
+    cv.notify_one();
+}
+
+wordle::server::Server::Server(Options _options, std::shared_ptr<const wordle::engine::Context> _context)
+: options{_options},
+  context{std::move(_context)},
+  hardBots{context, std::max<size_t>(1, _options.workers), std::max<size_t>(1, _options.suggestThreads)},
+  easyBots{context, std::max<size_t>(1, _options.workers), std::max<size_t>(1, _options.suggestThreads)},
+  workers{std::max<size_t>(1, _options.workers)} {
+    guard::hybridGuard<std::invalid_argument>(context != nullptr, "the server requires an engine context");
+    guard::hybridGuard<std::invalid_argument>(options.maxBatch > 0, "batches must hold at least one request");
+
+    const auto& vocab = context->vocab();
+    wordIndices.reserve(vocab.size());
+    for (size_t i = 0; i < vocab.size(); ++i) wordIndices.emplace(vocab[i], static_cast<bot::WordCountT>(i));
+
+    dispatcher = std::thread{[this] { dispatch(); }};
+}
+
+wordle::server::Server::~Server() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMtx);
+        closing = true;
+    }
+    pendingCv.notify_all();
+    dispatcher.join();
+    workers.wait();  // Drains use the sessions, which are destroyed before the workers
+}
+
+void wordle::server::Server::useOpeningBook(wordle::book::Mode mode, std::shared_ptr<const wordle::book::OpeningBook> book) {
+    if (mode == wordle::book::Mode::HARD) {
+        hardBots.useOpeningBook(std::move(book));
+    } else {
+        easyBots.useOpeningBook(std::move(book));
+    }
+}
+
+std::future<std::string> wordle::server::Server::submit(std::string line) {
+    Pending request{std::move(line), Clock::now(), {}};
+    auto future = request.reply.get_future();
+    {
+        std::lock_guard<std::mutex> lock(pendingMtx);
+        pending.push_back(std::move(request));
+    }
+    pendingCv.notify_one();
+    return future;
+}
+
+std::vector<std::string> wordle::server::Server::handleBatch(std::span<const std::string> lines) {
+    std::vector<Pending> batch;
+    batch.reserve(lines.size());
+    const auto received = Clock::now();
+    for (const auto& line : lines) batch.push_back({line, received, {}});
+
+    std::vector<std::future<std::string>> replies;
+    replies.reserve(batch.size());
+    for (auto& request : batch) replies.push_back(request.reply.get_future());
+
+    runBatch(batch);
+
+    std::vector<std::string> responses;
+    responses.reserve(replies.size());
+    for (auto& reply : replies) responses.push_back(reply.get());
+    return responses;
+}
+
+std::string wordle::server::Server::handle(std::string_view line) {
+    const std::string request{line};
+    return handleBatch({&request, 1}).front();
+}
+
+size_t wordle::server::Server::numSessions() {
+    std::lock_guard<std::mutex> lock(sessionMtx);
+    return sessions.size();
+}
+
+std::shared_ptr<wordle::server::Server::Session> wordle::server::Server::findSession(SessionId id) {
+    std::lock_guard<std::mutex> lock(sessionMtx);
+    auto it = sessions.find(id);
+    return it == sessions.end() ? nullptr : it->second;
+}
+
+void wordle::server::Server::reply(Pending& request, std::string response) {
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - request.received).count();
+    latencies.record(static_cast<uint64_t>(micros));
+    response += " us=";
+    response += std::to_string(micros);
+    request.reply.set_value(std::move(response));
+}
+
+std::string wordle::server::Server::serveStateless(std::string_view line) {
+    const auto tokens = tokenize(line);
+    if (tokens.empty()) return "err empty request";
+    const auto command = tokens.front();
+
+    if (command == "new" && tokens.size() == 2 && (tokens[1] == "hard" || tokens[1] == "easy")) {
+        const SessionId id = nextSession.fetch_add(1, std::memory_order_relaxed);
+        const auto mode = tokens[1] == "hard" ? wordle::book::Mode::HARD : wordle::book::Mode::EASY;
+        std::lock_guard<std::mutex> lock(sessionMtx);
+        sessions.emplace(id, std::make_shared<Session>(mode));
+        return "ok " + std::to_string(id);
+    }
+
+    if (command == "stats" && tokens.size() == 1) {
+        return std::format("ok sessions={} requests={} p50={} p99={} max={}", numSessions(), latencies.count(), latencies.percentile(50), latencies.percentile(99), latencies.max());
+    }
+
+    if (command == "shutdown" && tokens.size() == 1) {
+        stopping.store(true, std::memory_order_release);
+        return "ok";
+    }
+
+    if (command == "new") return "err expected: new <hard|easy>";
+    if (takesSession(command)) return "err invalid session";
+    return "err unknown command";
+}
+
+template <typename Bot>
+void wordle::server::Server::serveSession(Session& session, SessionId id, wordle::server::__impl::BotPool<Bot>& pool) {
+    // Step 1: Borrow a bot and bring it to the session's state
+    Bot& bot = pool.acquire();
+    bot.reset();
+    for (const auto& [guessIndex, fbEncoding] : session.history) bot.filter(guessIndex, fbEncoding);
+
+    // Step 2: Serve the queued requests in order, taking the ones that arrive meanwhile, until none are left
+    std::deque<Pending> requests;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(session.mtx);
+            if (session.queued.empty()) {
+                session.isServing = false;
+                break;
+            }
+            requests.swap(session.queued);
+        }
+
+        for (Pending& request : requests) {
+            if (session.isClosed) {  // Only this drain sets it
+                reply(request, "err unknown session");
+                continue;
+            }
+
+            const auto tokens = tokenize(request.line);
+            const auto command = tokens.front();
+            std::string response;
+            try {
+                if (command == "suggest" && tokens.size() == 2) {
+                    const auto suggestion = bot.suggest();
+                    response = suggestion.isValid ? std::format("ok {} {}", suggestion.guess, suggestion.entropy) : "err no suggestion";
+                } else if (command == "filter" && tokens.size() == 4) {
+                    const auto flag = bot.tryFilter(tokens[2], tokens[3]);
+                    if (flag == bot::FilterFlag::VALID) {
+                        session.history.emplace_back(wordIndices.at(tokens[2]), feedback::encodeFeedbackString(tokens[3]));
+                        response = "ok " + std::to_string(bot.getAliveTargets().size());
+                    } else {
+                        response = filterError(flag);
+                    }
+                } else if (command == "reset" && tokens.size() == 2) {
+                    session.history.clear();
+                    bot.reset();
+                    response = "ok";
+                } else if (command == "close" && tokens.size() == 2) {
+                    {
+                        std::lock_guard<std::mutex> lock(sessionMtx);
+                        sessions.erase(id);
+                    }
+                    std::lock_guard<std::mutex> lock(session.mtx);
+                    session.isClosed = true;
+                    response = "ok";
+                } else {
+                    response = "err wrong number of arguments";
+                }
+            } catch (const std::exception& e) {
+                response = std::string{"err "} + e.what();
+            }
+            reply(request, std::move(response));
+        }
+        requests.clear();
+    }
+    pool.release(bot);
+}
+
+void wordle::server::Server::enqueue(const std::shared_ptr<Session>& session, SessionId id, Pending request) {
+    bool isOpen = false;
+    {
+        std::lock_guard<std::mutex> lock(session->mtx);
+        isOpen = !session->isClosed;
+        if (isOpen) {
+            session->queued.push_back(std::move(request));
+            if (session->isServing) return;
+            session->isServing = true;
+        }
+    }
+    if (!isOpen) return reply(request, "err unknown session");
+
+    // The drain owns a reference, so a close (or the next batch) can't free the session under it
+    workers.push([this, session, id]() {
+        if (session->mode == wordle::book::Mode::HARD) {
+            serveSession(*session, id, hardBots);
+        } else {
+            serveSession(*session, id, easyBots);
+        }
+    });
+}
+
+void wordle::server::Server::runBatch(std::span<Pending> batch) {
+    // Requests without a session are answered inline, the rest join their session's queue in arrival order
+    for (auto& request : batch) {
+        const auto tokens = tokenize(request.line);
+        const auto id = tokens.empty() || !takesSession(tokens.front()) ? std::nullopt : parseSession(tokens);
+        if (!id) {
+            reply(request, serveStateless(request.line));
+            continue;
+        }
+
+        const auto session = findSession(*id);
+        if (!session) {
+            reply(request, "err unknown session");
+            continue;
+        }
+        enqueue(session, *id, std::move(request));
+    }
+}
+
+void wordle::server::Server::dispatch() {
+    while (true) {
+        std::vector<Pending> batch;
+        {
+            std::unique_lock<std::mutex> lock(pendingMtx);
+            pendingCv.wait(lock, [this] { return closing || !pending.empty(); });
+            if (pending.empty()) return;
+
+            // Take everything that arrived while the last batch ran, up to maxBatch
+            const size_t size = std::min(options.maxBatch, pending.size());
+            batch.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                batch.push_back(std::move(pending.front()));
+                pending.pop_front();
+            }
+        }
+        runBatch(batch);
+    }
+}
+
+void wordle::server::serveStream(Server& server, int inFd, int outFd) {
+    std::string buffer;
+    std::array<char, 1 << 16> chunk;
+
+    while (!server.isStopping()) {
+        const ssize_t n = ::read(inFd, chunk.data(), chunk.size());
+        if (n < 0 && errno == EINTR) continue;
+        const bool isEnd = n <= 0;
+        if (!isEnd) buffer.append(chunk.data(), static_cast<size_t>(n));
+
+        // Step 1: Submit every complete line read so far (and a final unterminated one), so they share batches
+        std::vector<std::future<std::string>> replies;
+        auto submitLine = [&](std::string_view line) {
+            if (line.find_first_not_of(" \t\r") != std::string_view::npos) replies.push_back(server.submit(std::string{line}));
+        };
+        size_t start = 0;
+        for (size_t newline; (newline = buffer.find('\n', start)) != std::string::npos; start = newline + 1) {
+            submitLine(std::string_view{buffer}.substr(start, newline - start));
+        }
+        buffer.erase(0, start);
+        if (isEnd) submitLine(buffer);
+
+        // Step 2: Answer them in order
+        std::string responses;
+        for (auto& reply : replies) {
+            responses += reply.get();
+            responses += '\n';
+        }
+        if (!writeAll(outFd, responses) || isEnd) return;
+    }
+}
+
+void wordle::server::serveSocket(Server& server, std::string_view path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    guard::runtimeGuard(path.size() < sizeof(address.sun_path), "socket path {} is too long", path);
+    std::memcpy(address.sun_path, path.data(), path.size());
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    guard::runtimeGuard(listener >= 0, "failed to create a socket for {}", path);
+    ::unlink(address.sun_path);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, SOMAXCONN) != 0) {
+        ::close(listener);
+        guard::formatError("failed to listen on {}", path);
+    }
+
+    // Open connections, so shutdown can wake the ones blocked in read()
+    std::vector<int> connections;
+    std::mutex connectionMtx;
+    std::condition_variable connectionCv;
+
+    // Step 1: Accept until shutdown, checking for it between polls
+    while (!server.isStopping()) {
+        pollfd poller{listener, POLLIN, 0};
+        if (::poll(&poller, 1, 100) <= 0) continue;
+        const int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) continue;
+
+        std::lock_guard<std::mutex> lock(connectionMtx);
+        connections.push_back(fd);
+        std::thread{[&server, &connections, &connectionMtx, &connectionCv, fd]() {
+            serveStream(server, fd, fd);
+            std::lock_guard<std::mutex> lock(connectionMtx);
+            connections.erase(std::find(connections.begin(), connections.end(), fd));
+            ::close(fd);
+            connectionCv.notify_all();
+        }}.detach();
+    }
+
+    // Step 2: Hang up on idle connections and wait for every connection to finish
+    std::unique_lock<std::mutex> lock(connectionMtx);
+    for (int fd : connections) ::shutdown(fd, SHUT_RD);
+    connectionCv.wait(lock, [&connections] { return connections.empty(); });
+    ::close(listener);
+    ::unlink(address.sun_path);
+}
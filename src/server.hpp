@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "easyBot.hpp"
+#include "engineContext.hpp"
+#include "hardBot.hpp"
+#include "openingBook.hpp"
+#include "parallelTaskQueue.hpp"
+#include "suggestionCache.hpp"
+#include "topology.hpp"
+
+/*
+Long-running solver server: one resident engine context serving any number of independent game sessions.
+
+Protocol: one request per line, one response per request, in request order on each connection.
+    new <hard|easy>                     ok <session>
+    suggest <session>                   ok <guess> <entropy>
+    filter <session> <guess> <feedback> ok <alive targets>     (as bots' tryFilter, feedback as in encodeFeedbackString)
+    reset <session>                     ok
+    close <session>                     ok
+    stats                               ok sessions=<n> requests=<n> p50=<us> p99=<us> max=<us>
+    shutdown                            ok
+Every response ends with " us=<latency>", the microseconds from the request's arrival to its response. Failures are
+answered with "err <reason>" and leave the session unchanged.
+
+Sessions only record their mode and guess history, so they cost a few bytes each. Requests are gathered into batches
+and queued on their sessions: the requests of one session run in order, different sessions run concurrently on the
+worker pool, each borrowing a pooled bot that replays the session's history before serving it. There is no lock across
+sessions, so a slow search holds up nobody else. Bots of a mode share one suggestion cache (and
+opening book), so a state searched for one session is free for all of them.
+*/
+namespace wordle::server {
+
+    using SessionId = uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        size_t workers = topology::hardwareConcurrency();  // Sessions served at once, and the most bots pooled per mode
+        size_t suggestThreads = 1;                      // Threads each pooled bot searches with
+        size_t maxBatch = 1024;                         // Most requests gathered into one batch
+    };
+
+    // Lock-free log2 histogram of latencies in microseconds
+    class LatencyHistogram {
+        static constexpr size_t NUM_BUCKETS = 40;  // Bucket b holds latencies in [2^(b-1), 2^b)
+        std::array<std::atomic_uint64_t, NUM_BUCKETS> buckets{};
+        std::atomic_uint64_t maxMicros = 0;
+
+    public:
+        void record(uint64_t micros) noexcept;
+
+        [[nodiscard]] uint64_t count() const noexcept;
+
+        // Upper bound of the bucket holding the p-th percentile (0 when empty)
+        [[nodiscard]] uint64_t percentile(double p) const noexcept;
+
+        [[nodiscard]] uint64_t max() const noexcept { return maxMicros.load(std::memory_order_relaxed); }
+    };
+
+    namespace __impl {
+        // Bots of one mode, created on demand up to a limit and lent out one session at a time
+        template <typename Bot>
+        class BotPool {
+            std::shared_ptr<const engine::Context> context;
+            std::shared_ptr<const book::OpeningBook> openingBook;
+            std::shared_ptr<cache::SuggestionCache> suggestionCache = std::make_shared<cache::SuggestionCache>();
+            size_t limit;
+            size_t suggestThreads;
+            std::vector<std::unique_ptr<Bot>> bots;
+            std::vector<Bot*> idle;
+            std::mutex mtx;
+            std::condition_variable cv;
+
+        public:
+            BotPool(std::shared_ptr<const engine::Context> _context, size_t _limit, size_t _suggestThreads)
+            : context{std::move(_context)},
+              limit{_limit},
+              suggestThreads{_suggestThreads} {}
+
+            // Serves from book in every bot created afterwards (set before serving)
+            void useOpeningBook(std::shared_ptr<const book::OpeningBook> book) { openingBook = std::move(book); }
+
+            Bot& acquire();
+            void release(Bot& bot);
+        };
+    }
+
+    class Server {
+        struct Pending {
+            std::string line;
+            Clock::time_point received;
+            std::promise<std::string> reply;
+        };
+
+        // Only the worker draining a session touches its history; mtx guards the queue and flags
+        struct Session {
+            book::Mode mode;
+            std::vector<std::pair<bot::WordCountT, feedback::Encoding>> history;  // Guesses and feedbacks filtered so far
+            std::mutex mtx;
+            std::deque<Pending> queued;  // Requests waiting for the session, in arrival order
+            bool isServing = false;      // A worker is draining queued
+            bool isClosed = false;       // Set by close; later requests are answered "err unknown session"
+
+            explicit Session(book::Mode _mode) noexcept : mode{_mode} {}
+        };
+
+        Options options;
+        std::shared_ptr<const engine::Context> context;
+        std::unordered_map<std::string_view, bot::WordCountT> wordIndices;
+        __impl::BotPool<bot::HardBot> hardBots;
+        __impl::BotPool<bot::EasyBot> easyBots;
+        parallel::TaskQueue workers;
+
+        std::unordered_map<SessionId, std::shared_ptr<Session>> sessions;  // Drains keep closed sessions alive until they finish
+        std::mutex sessionMtx;
+        std::atomic<SessionId> nextSession = 1;
+        LatencyHistogram latencies;
+        std::atomic_bool stopping = false;  // Set by a shutdown request
+
+        // Requests submitted by connections, batched by the dispatcher thread
+        std::deque<Pending> pending;
+        std::mutex pendingMtx;
+        std::condition_variable pendingCv;
+        bool closing = false;  // Set by the destructor
+        std::thread dispatcher;
+
+        std::shared_ptr<Session> findSession(SessionId id);
+
+        // Queues request on its session, starting a drain on the workers unless one is running
+        void enqueue(const std::shared_ptr<Session>& session, SessionId id, Pending request);
+
+        // Serves the session's queued requests in order on a bot borrowed from pool, until the queue is empty
+        template <typename Bot>
+        void serveSession(Session& session, SessionId id, __impl::BotPool<Bot>& pool);
+
+        std::string serveStateless(std::string_view line);
+
+        // Answers stateless requests and queues the others on their sessions. Sessions are served concurrently and
+        // independently, so a slow request only delays later requests of its own session.
+        void runBatch(std::span<Pending> batch);
+
+        void reply(Pending& request, std::string response);
+
+        void dispatch();
+
+    public:
+        explicit Server(Options _options = {}, std::shared_ptr<const engine::Context> _context = engine::Context::shared());
+        ~Server();
+
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        // Serves from book in mode's bots while games stay on it (set before serving)
+        void useOpeningBook(book::Mode mode, std::shared_ptr<const book::OpeningBook> book);
+
+        // Queues one request line. The future holds its response.
+        std::future<std::string> submit(std::string line);
+
+        // Answers lines as one batch, in order (bypasses the dispatcher)
+        std::vector<std::string> handleBatch(std::span<const std::string> lines);
+
+        std::string handle(std::string_view line);
+
+        [[nodiscard]] size_t numSessions();
+
+        [[nodiscard]] const LatencyHistogram& getLatencies() const noexcept { return latencies; }
+
+        // Returns true once a shutdown request was served
+        [[nodiscard]] bool isStopping() const noexcept { return stopping.load(std::memory_order_acquire); }
+    };
+
+    // Answers request lines read from inFd on outFd until end of input or shutdown. Lines read together are batched.
+    void serveStream(Server& server, int inFd, int outFd);
+
+    // Accepts connections on a Unix domain socket at path, each served as by serveStream, until shutdown
+    void serveSocket(Server& server, std::string_view path);
+
+}  // namespace wordle::server
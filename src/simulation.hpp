@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include "config.hpp"
+#include "guard.hpp"
+#include "lookahead.hpp"
+#include "openingBook.hpp"
+#include "parallelTaskQueue.hpp"
+#include "suggestionCache.hpp"
+#include "topology.hpp"
+
+/*
+Whole-corpus simulation: plays every target as the solution and reports how many guesses each game took.
+
+Games run concurrently, one bot per game worker. Every bot borrows the same engine context (vocab and matrix), so
+a worker only adds its mutable state (alive set, entropies, scratch). Workers pull solutions from a shared counter,
+which keeps the tail of the run balanced. They share the opening book and suggestion cache, so a state searched by
+one game is free for all the others.
+*/
+namespace wordle::simulation {
+
+    constexpr inline size_t MAX_GUESSES = 100;  // Games still unsolved after this many guesses are reported as errors
+
+    /*
+    Split of the available threads between games and suggest() calls.
+    Most suggest() calls in a simulation are small late-game searches that don't scale, so threads go to games first
+    and every game bot searches on one thread. The opening search runs before any game starts, on all gameWorkers.
+    Game workers default to the CPUs this process may use; on NUMA machines they are spread across the nodes.
+    */
+    struct ThreadPlan {
+        size_t gameWorkers = topology::hardwareConcurrency();
+        size_t suggestThreads = 1;
+        bool placeOnNodes = true;  // With several nodes, pins game workers across them and has bots read their node's matrix replica
+
+        // Every thread runs games, whatever the bot
+        static ThreadPlan forThreads(size_t totalThreads = topology::hardwareConcurrency()) {
+            return {std::max<size_t>(1, totalThreads), 1};
+        }
+    };
+
+    struct Report {
+        std::vector<size_t> guesses;       // Guesses taken with each target as the solution
+        std::chrono::milliseconds duration{};
+        ThreadPlan plan{};
+
+        [[nodiscard]] double meanGuesses() const noexcept {
+            return std::accumulate(guesses.begin(), guesses.end(), 0.0) / static_cast<double>(guesses.size());
+        }
+
+        [[nodiscard]] size_t gamesWon() const noexcept {
+            return std::count_if(guesses.begin(), guesses.end(), [](size_t g) noexcept { return g <= 6; });
+        }
+
+        [[nodiscard]] double gamesPerSecond() const noexcept {
+            const double seconds = std::chrono::duration<double>(duration).count();
+            return seconds > 0 ? static_cast<double>(guesses.size()) / seconds : 0.0;
+        }
+    };
+
+    /*
+    Plays one game from the first suggestion. Returns the number of guesses, or MAX_GUESSES if the bot gave up.
+    Feedbacks are read as fMap[solution][guess], the same convention filter() uses.
+    */
+    template <typename Bot, typename Suggestion>
+    size_t playGame(Bot& bot, size_t solutionIndex, const Suggestion& firstSuggestion) {
+        bot.reset();
+        size_t guesses = 1;
+        Suggestion suggestion = firstSuggestion;
+        const auto& fMapSlice = bot.getFMap()[solutionIndex];
+
+        for (; suggestion.isValid && suggestion.guessIndex != solutionIndex && guesses < MAX_GUESSES; ++guesses) {
+            auto fbEncoding = fMapSlice[suggestion.guessIndex];
+            bot.filter(suggestion.guessIndex, fbEncoding);
+            suggestion = bot.suggest();
+        }
+        return suggestion.isValid ? guesses : MAX_GUESSES;
+    }
+
+    /*
+    Plays every target as the solution with plan.gameWorkers games in flight, searching with lookaheadPlan if given.
+    Results are identical to playing the games one after another: every game is independent and bots are deterministic.
+    Throws if any game could not be solved.
+    */
+    template <typename Bot>
+    Report simulate(
+        ThreadPlan plan = ThreadPlan::forThreads(),
+        std::shared_ptr<const book::OpeningBook> openingBook = nullptr,
+        std::shared_ptr<cache::SuggestionCache> suggestionCache = nullptr,
+        size_t beamCandidates = config::HARDWARE_CONCURRENCY,
+        std::optional<lookahead::Plan> lookaheadPlan = std::nullopt
+    ) {
+        guard::hybridGuard<std::invalid_argument>(plan.gameWorkers > 0 && plan.suggestThreads > 0, "simulation requires at least one thread per level");
+
+        Report report{std::vector<size_t>(config::NUM_TARGETS, 0), {}, plan};
+        const bool isPlaced = plan.placeOnNodes && topology::Topology::system().numNodes() > 1;
+        std::atomic_size_t nextSolution = 0;
+        std::exception_ptr failure = nullptr;
+        std::mutex failureMtx;
+
+        auto configure = [&](Bot& bot) {
+            if (lookaheadPlan) bot.setLookahead(*lookaheadPlan);
+            if (openingBook) bot.useOpeningBook(openingBook);
+            if (suggestionCache) bot.useSuggestionCache(suggestionCache);
+        };
+
+        // Step 1: The opening suggestion is shared by every game. It is the costliest search and the game workers are
+        // still idle, so it gets all of their threads.
+        Bot firstBot{plan.gameWorkers, beamCandidates};
+        configure(firstBot);
+        const auto firstSuggestion = firstBot.suggest();
+        guard::hybridGuard(firstSuggestion.isValid, "Unable to retrieve first guess");
+
+        // Step 2: Each worker owns a bot and pulls solutions until none are left
+        auto worker = [&]() {
+            try {
+                Bot bot{firstBot.getContext(), plan.suggestThreads, beamCandidates};
+                configure(bot);
+                if (isPlaced) {
+                    if (auto node = topology::currentNode()) bot.placeOnNode(*node);
+                }
+                for (size_t solutionIndex = nextSolution.fetch_add(1, std::memory_order_relaxed); solutionIndex < config::NUM_TARGETS;
+                     solutionIndex = nextSolution.fetch_add(1, std::memory_order_relaxed)) {
+                    report.guesses[solutionIndex] = playGame(bot, solutionIndex, firstSuggestion);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMtx);
+                if (!failure) failure = std::current_exception();
+                nextSolution.store(config::NUM_TARGETS, std::memory_order_relaxed);  // Stop the other workers early
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            parallel::TaskQueue games{plan.gameWorkers};
+            if (isPlaced) games.threadPool()->pin(topology::Topology::system().spread());
+            for (size_t w = 0; w < plan.gameWorkers; ++w) games.push(worker);
+            games.wait();
+        }
+        report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        if (failure) std::rethrow_exception(failure);
+        for (size_t solutionIndex = 0; solutionIndex < config::NUM_TARGETS; ++solutionIndex) {
+            guard::runtimeGuard(report.guesses[solutionIndex] < MAX_GUESSES, "Failed to find {} within {} guesses", firstBot.getVocab()[solutionIndex], MAX_GUESSES);
+        }
+        return report;
+    }
+}
@@ -0,0 +1,83 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "feedbackCache.hpp"
+#include "mappedFile.hpp"
+#include "solver.hpp"
+
+namespace {
+    wordle::solver::MemoHeader makeHeader(wordle::book::Mode mode, const wordle::solver::Options& options, const wordle::vocab::Vocab& vocab, size_t numEntries) noexcept {
+        return {
+            wordle::solver::MAGIC,
+            wordle::solver::FORMAT_VERSION,
+            static_cast<uint8_t>(mode),
+            static_cast<uint8_t>(options.objective),
+            static_cast<uint16_t>(wordle::config::WORD_LENGTH),
+            options.candidateLimit,
+            wordle::feedback::cache::vocabChecksum(vocab),
+            numEntries
+        };
+    }
+}
+
+bool wordle::solver::writeMemo(std::string_view path, wordle::book::Mode mode, const Options& options, const wordle::vocab::Vocab& vocab, const Memo& memo) {
+    const std::filesystem::path target{path};
+    std::filesystem::path temporary{target};
+    temporary += ".tmp";
+
+    // Step 1: Sort records by key, so equal memos make equal files
+    std::vector<MemoRecord> records;
+    records.reserve(memo.size());
+    for (const auto& [key, entry] : memo) records.push_back({key, entry});
+    std::sort(records.begin(), records.end(), [](const MemoRecord& a, const MemoRecord& b) { return a.key < b.key; });
+
+    // Step 2: Write header and records to a temporary file
+    {
+        std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+        if (!file) return false;
+
+        const MemoHeader header = makeHeader(mode, options, vocab, records.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(MemoHeader));
+        file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(MemoRecord)));
+        if (!file.flush()) {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+    }
+
+    // Step 3: Atomically replace any existing memo
+    std::error_code ec;
+    std::filesystem::rename(temporary, target, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<wordle::solver::Memo> wordle::solver::readMemo(std::string_view path, wordle::book::Mode mode, const Options& options, const wordle::vocab::Vocab& vocab) {
+    const auto file = wordle::util::MappedFile::open(path);
+    if (!file.isOpen() || file.size() < sizeof(MemoHeader)) return std::nullopt;
+
+    MemoHeader header;
+    std::memcpy(&header, file.data(), sizeof(MemoHeader));
+
+    const MemoHeader expected = makeHeader(mode, options, vocab, header.numEntries);
+    const bool isValid = std::memcmp(&header, &expected, sizeof(MemoHeader)) == 0
+        && file.size() == sizeof(MemoHeader) + header.numEntries * sizeof(MemoRecord);
+    if (!isValid) return std::nullopt;
+
+    // Records are copied out one by one, which sidesteps the mapping's alignment
+    Memo memo;
+    memo.reserve(header.numEntries);
+    const std::byte* cursor = file.data() + sizeof(MemoHeader);
+    for (uint64_t i = 0; i < header.numEntries; ++i, cursor += sizeof(MemoRecord)) {
+        MemoRecord record;
+        std::memcpy(&record, cursor, sizeof(MemoRecord));
+        if (record.entry.isSolved() && record.entry.guess >= wordle::config::NUM_WORDS) return std::nullopt;
+        memo.emplace(record.key, record.entry);
+    }
+    return memo;
+}
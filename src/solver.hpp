@@ -0,0 +1,608 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "botBase.hpp"
+#include "config.hpp"
+#include "engineContext.hpp"
+#include "entropy.hpp"
+#include "feedback.hpp"
+#include "fingerprint.hpp"
+#include "guard.hpp"
+#include "lookahead.hpp"
+#include "openingBook.hpp"
+#include "parallelTaskQueue.hpp"
+#include "vocab.hpp"
+
+/*
+Exact solver: the strategy that needs the fewest guesses over the alive targets, instead of the one that gains the
+most information per guess.
+
+The cost of a game state with alive targets S counts the guesses needed to solve every target of S from there
+(their expected number is the total over |S|) and the most any single target needs:
+    cost(S, g) = |S| guesses now, plus cost(S_b) for every bin b of g except the solved one
+    cost(S)    = min over guesses g of cost(S, g), by total first and worst case among equal totals
+States are solved within a budget of guesses, which every target of the chosen strategy must be solved within.
+Objective::EXPECTED leaves it unlimited. Objective::WORST_CASE, which is what hard mode needs (a guess it was forced
+into can't be undone by a free probe later), finds the smallest budget the whole state can be solved within, then
+the lowest total within it. Budgets split exactly (every bin of a guess gets one guess less), which the worst case
+compared lexicographically would not.
+
+States are solved recursively and memoized by the fingerprint of their alive words and budget, so a state reached
+through different histories is solved once. Each state ranks its guesses by a lower bound on their cost and
+searches the first candidateLimit of them; a candidate is abandoned once its solved bins plus the bounds of the
+others already cost more than the best one. With ALL_CANDIDATES every guess is searched and the result is the true
+optimum, which is practical for mid-game states only. Root candidates run as tasks on the thread pool and share one
+memo.
+
+Bins follow the game (fMap[solution][guess], as filter() and book::Builder read it), so a recorded strategy plays
+exactly as solved. Memos persist through writeMemo() and readMemo(). strategy() records the solved game tree in
+opening book format, with beam width book::SOLVER_BEAM and the expected remaining guesses in place of entropies.
+*/
+namespace wordle::solver {
+    using WordIndex = histogram::WordIndex;
+
+    constexpr inline size_t ALL_CANDIDATES = 0;            // candidateLimit that searches every guess
+    constexpr inline size_t DEFAULT_CANDIDATE_LIMIT = 16;  // Guesses searched per state by default
+    constexpr inline uint32_t UNLIMITED = std::numeric_limits<uint32_t>::max();  // Budget of Objective::EXPECTED
+    constexpr inline uint32_t NO_GUESS = std::numeric_limits<uint32_t>::max();   // Guess of a state its budget can't solve
+    constexpr inline feedback::Encoding SOLVED = feedback::__impl::encodeAsCorrect();
+
+    enum class Objective : uint8_t { EXPECTED = 0, WORST_CASE };
+
+    struct Cost {
+        uint32_t totalGuesses = 0;  // Summed over the state's targets
+        uint32_t worstCase = 0;     // Most guesses any one target needs
+
+        // Adds a bin searched after this state's guess
+        void addBin(const Cost& bin) noexcept {
+            totalGuesses += bin.totalGuesses;
+            worstCase = std::max(worstCase, bin.worstCase + 1);
+        }
+
+        bool operator==(const Cost&) const noexcept = default;
+    };
+
+    // Returns true if a is strictly better than b: fewer guesses in total, or as many with a better worst case
+    [[nodiscard]] constexpr bool better(const Cost& a, const Cost& b) noexcept {
+        return std::tie(a.totalGuesses, a.worstCase) < std::tie(b.totalGuesses, b.worstCase);
+    }
+
+    /*
+    Cost no strategy can beat over n targets. Each guess solves at most one target, and only histories of feedbacks
+    other than SOLVED go on, so at most (NUM_FEEDBACKS - 1)^(k - 1) targets are solved by the k-th guess.
+    */
+    [[nodiscard]] constexpr Cost lowerBound(size_t n) noexcept {
+        Cost bound{};
+        size_t solvable = 1;
+        for (uint32_t guesses = 1; n > 0; ++guesses) {
+            const size_t solved = std::min(n, solvable);
+            bound.totalGuesses += static_cast<uint32_t>(solved * guesses);
+            bound.worstCase = guesses;
+            n -= solved;
+            solvable *= feedback::NUM_FEEDBACKS - 1;
+        }
+        return bound;
+    }
+
+    struct Options {
+        Objective objective = Objective::EXPECTED;
+        size_t candidateLimit = DEFAULT_CANDIDATE_LIMIT;
+
+        // Expected guesses for easy mode, worst case first for hard mode
+        static Options forMode(book::Mode mode) noexcept {
+            return {mode == book::Mode::HARD ? Objective::WORST_CASE : Objective::EXPECTED, DEFAULT_CANDIDATE_LIMIT};
+        }
+    };
+
+    // Solution of one state within a budget
+    struct Entry {
+        Cost cost;
+        uint32_t numAlive;  // Alive words of the state, a cheap guard against fingerprint collisions
+        uint32_t guess;     // NO_GUESS if the budget can't solve the state
+
+        [[nodiscard]] bool isSolved() const noexcept { return guess != NO_GUESS; }
+    };
+
+    using Memo = std::unordered_map<fingerprint::Fingerprint, Entry>;
+
+    // Search work, summed over solve() calls
+    struct SolveStats {
+        size_t states = 0;            // States solved by searching their candidates
+        size_t memoHits = 0;          // States answered by the memo
+        size_t candidates = 0;        // Candidates searched
+        size_t candidatesPruned = 0;  // Of those, abandoned on their bound
+
+        SolveStats& operator+=(const SolveStats& other) noexcept {
+            states += other.states;
+            memoHits += other.memoHits;
+            candidates += other.candidates;
+            candidatesPruned += other.candidatesPruned;
+            return *this;
+        }
+    };
+
+    constexpr inline std::array<char, 8> MAGIC{'W', 'R', 'D', 'L', 'S', 'O', 'L', 'V'};
+    constexpr inline uint32_t FORMAT_VERSION = 1;
+
+    /*
+    File layout (native endianness): [MemoHeader][MemoRecord x numEntries], records sorted by key.
+    A memo is only valid for the mode, objective, candidate limit and vocab it was solved with.
+    */
+    struct MemoHeader {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint8_t mode;
+        uint8_t objective;
+        uint16_t wordLength;
+        uint64_t candidateLimit;
+        uint64_t vocabChecksum;
+        uint64_t numEntries;
+    };
+
+    struct MemoRecord {
+        fingerprint::Fingerprint key;
+        Entry entry;
+    };
+
+    // Writes memo to path (via a temporary file and rename). Returns false if the file could not be written.
+    bool writeMemo(std::string_view path, book::Mode mode, const Options& options, const vocab::Vocab& vocab, const Memo& memo);
+
+    // Reads the memo at path. Returns std::nullopt if it is missing, truncated or was solved for another configuration.
+    [[nodiscard]] std::optional<Memo> readMemo(std::string_view path, book::Mode mode, const Options& options, const vocab::Vocab& vocab);
+
+    /*
+    Exact solver for one mode. In HardMode only alive words (targets, then fillers) are guesses and fillers are split
+    along with targets; otherwise every word is a guess and states are their targets alone.
+    */
+    template <bool HardMode>
+    class Solver {
+        using Words = std::vector<WordIndex>;
+
+        struct State {
+            Words targets;
+            Words fillers;  // Always empty unless HardMode
+        };
+
+        struct Candidate {
+            Cost bound;
+            entropy::Fixed fixedSum;  // Breaks ties in favour of higher entropy
+            WordIndex guess;
+        };
+
+        std::shared_ptr<const engine::Context> context;
+        feedback::FeedbackMatrixView fMap;
+        Options options;
+        parallel::TaskQueue taskQueue;
+        mutable std::shared_mutex memoMtx;
+        Memo memo;
+        mutable std::mutex statsMtx;
+        SolveStats totals{};
+
+        static std::shared_ptr<const engine::Context> requireContext(std::shared_ptr<const engine::Context> context) {
+            guard::hybridGuard<std::invalid_argument>(context != nullptr, "the solver requires an engine context");
+            return context;
+        }
+
+        // Every target alive and, in HardMode, every filler
+        static State wholeGame() {
+            State state{Words(config::NUM_TARGETS), Words(HardMode ? config::NUM_FILLERS : 0)};
+            std::iota(state.targets.begin(), state.targets.end(), 0);
+            std::iota(state.fillers.begin(), state.fillers.end(), config::NUM_TARGETS);
+            return state;
+        }
+
+        // Memo key of state solved within budget
+        static fingerprint::Fingerprint keyOf(const State& state, uint32_t budget) noexcept {
+            const auto words = fingerprint::of(state.targets.begin(), state.targets.end()) ^ fingerprint::of(state.fillers.begin(), state.fillers.end());
+            return fingerprint::salted(words, budget);
+        }
+
+        static uint32_t aliveOf(const State& state) noexcept {
+            return static_cast<uint32_t>(state.targets.size() + state.fillers.size());
+        }
+
+        // Budget left for the bins of a guess made within budget
+        static uint32_t remaining(uint32_t budget) noexcept {
+            return budget == UNLIMITED ? UNLIMITED : budget - 1;
+        }
+
+        static Entry unsolved(const State& state) noexcept {
+            return {{}, aliveOf(state), NO_GUESS};
+        }
+
+        // States of one or two targets: guess the first, and the second (if any) next
+        static Entry trivial(const State& state, uint32_t budget) noexcept {
+            const auto n = static_cast<uint32_t>(state.targets.size());
+            if (budget < n) return unsolved(state);
+            return {n == 1 ? Cost{1, 1} : Cost{3, 2}, aliveOf(state), state.targets.front()};
+        }
+
+        std::optional<Entry> lookup(fingerprint::Fingerprint key, uint32_t numAlive) const {
+            std::shared_lock<std::shared_mutex> lock(memoMtx);
+            const auto it = memo.find(key);
+            if (it == memo.end() || it->second.numAlive != numAlive) return std::nullopt;
+            return it->second;
+        }
+
+        void remember(fingerprint::Fingerprint key, const Entry& entry) {
+            std::unique_lock<std::shared_mutex> lock(memoMtx);
+            memo.insert_or_assign(key, entry);
+        }
+
+        void record(const SolveStats& local) {
+            std::lock_guard<std::mutex> lock(statsMtx);
+            totals += local;
+        }
+
+        /*
+        The guesses worth searching at state within budget, best bound first (then higher entropy, then lower index).
+        Guesses that leave every target in one unsolved bin make no progress and are never candidates.
+        */
+        std::vector<Candidate> rank(const State& state, uint32_t budget) const {
+            const size_t n = state.targets.size();
+            std::vector<const feedback::Encoding*> rows(n);
+            for (size_t i = 0; i < n; ++i) rows[i] = fMap.row(state.targets[i]);
+
+            const auto& table = entropy::cLogCTable();
+            std::array<WordIndex, feedback::NUM_FEEDBACKS> counts{};
+            std::array<feedback::Encoding, feedback::NUM_FEEDBACKS + 1> touched{};
+            std::vector<Candidate> candidates;
+
+            auto consider = [&](WordIndex guess) {
+                size_t numTouched = 0;
+                for (const auto* row : rows) {
+                    const feedback::Encoding bin = row[guess];
+                    touched[numTouched] = bin;
+                    numTouched += counts[bin]++ == 0;
+                }
+
+                Cost bound{static_cast<uint32_t>(n), 1};
+                entropy::Fixed sum = 0;
+                bool progresses = true;
+                for (size_t i = 0; i < numTouched; ++i) {
+                    const size_t count = std::exchange(counts[touched[i]], 0);
+                    sum += table[count];
+                    if (touched[i] == SOLVED) continue;
+                    progresses = progresses && count < n;
+                    bound.addBin(lowerBound(count));
+                }
+                if (progresses && bound.worstCase <= budget) candidates.push_back({bound, sum, guess});
+            };
+
+            if constexpr (HardMode) {
+                for (WordIndex guess : state.targets) consider(guess);
+                for (WordIndex guess : state.fillers) consider(guess);
+            } else {
+                for (size_t guess = 0; guess < config::NUM_WORDS; ++guess) consider(static_cast<WordIndex>(guess));
+            }
+
+            auto order = [](const Candidate& a, const Candidate& b) {
+                if (better(a.bound, b.bound)) return true;
+                if (better(b.bound, a.bound)) return false;
+                return std::tie(a.fixedSum, a.guess) < std::tie(b.fixedSum, b.guess);
+            };
+            const size_t limit = options.candidateLimit == ALL_CANDIDATES ? candidates.size() : std::min(options.candidateLimit, candidates.size());
+            std::partial_sort(candidates.begin(), candidates.begin() + limit, candidates.end(), order);
+            candidates.resize(limit);
+            return candidates;
+        }
+
+        // States guess leads to, except the solved one, most targets first
+        std::vector<State> split(const State& state, WordIndex guess) const {
+            auto tag = [this, guess](const Words& words) {
+                std::vector<std::pair<feedback::Encoding, WordIndex>> tagged(words.size());
+                for (size_t i = 0; i < words.size(); ++i) tagged[i] = {fMap.row(words[i])[guess], words[i]};
+                std::sort(tagged.begin(), tagged.end());
+                return tagged;
+            };
+            const auto targets = tag(state.targets);
+            const auto fillers = tag(state.fillers);
+
+            std::vector<State> bins;
+            auto filler = fillers.begin();
+            for (auto target = targets.begin(); target != targets.end();) {
+                const feedback::Encoding bin = target->first;
+                State next;
+                for (; target != targets.end() && target->first == bin; ++target) next.targets.push_back(target->second);
+                for (; filler != fillers.end() && filler->first < bin; ++filler) {}
+                for (; filler != fillers.end() && filler->first == bin; ++filler) next.fillers.push_back(filler->second);
+                if (bin != SOLVED) bins.push_back(std::move(next));
+            }
+            std::stable_sort(bins.begin(), bins.end(), [](const State& a, const State& b) { return a.targets.size() > b.targets.size(); });
+            return bins;
+        }
+
+        /*
+        Cost of guess at state within budget. std::nullopt if a bin can't be solved within what is left of it, or once
+        best() (the best cost known so far, if any) is strictly better than the solved bins plus the bounds of the rest.
+        Equal costs are always finished, so ties resolve by rank alone.
+        */
+        template <typename Best>
+        std::optional<Cost> evaluate(const State& state, WordIndex guess, uint32_t budget, Best&& best, SolveStats& stats) {
+            const auto bins = split(state, guess);
+
+            // Bounds of bins [i, end), as the cost they add after this state's guess
+            std::vector<Cost> rest(bins.size() + 1);
+            for (size_t i = bins.size(); i-- > 0;) {
+                rest[i] = rest[i + 1];
+                rest[i].addBin(lowerBound(bins[i].targets.size()));
+            }
+
+            Cost cost{static_cast<uint32_t>(state.targets.size()), 1};
+            ++stats.candidates;
+            for (size_t i = 0; i < bins.size(); ++i) {
+                const Cost optimistic{cost.totalGuesses + rest[i].totalGuesses, std::max(cost.worstCase, rest[i].worstCase)};
+                if (const std::optional<Cost> bar = best(); bar && better(*bar, optimistic)) {
+                    ++stats.candidatesPruned;
+                    return std::nullopt;
+                }
+
+                const Entry bin = solveState(bins[i], remaining(budget), stats);
+                if (!bin.isSolved()) return std::nullopt;
+                cost.addBin(bin.cost);
+            }
+            return cost;
+        }
+
+        // Solves state within budget serially, through the memo
+        Entry solveState(const State& state, uint32_t budget, SolveStats& stats) {
+            const size_t n = state.targets.size();
+            if (n <= 2) return trivial(state, budget);
+
+            const Cost floor = lowerBound(n);
+            if (floor.worstCase > budget) return unsolved(state);
+
+            const auto key = keyOf(state, budget);
+            if (auto known = lookup(key, aliveOf(state))) {
+                ++stats.memoHits;
+                return *known;
+            }
+            ++stats.states;
+
+            // Candidates come best bound first: once the best cost beats a bound, it beats every later one
+            Entry solution = unsolved(state);
+            auto best = [&solution]() -> std::optional<Cost> { return solution.isSolved() ? std::optional<Cost>{solution.cost} : std::nullopt; };
+            for (const Candidate& candidate : rank(state, budget)) {
+                if (solution.isSolved() && (better(solution.cost, candidate.bound) || solution.cost == floor)) break;
+                const auto cost = evaluate(state, candidate.guess, budget, best, stats);
+                if (cost && (!solution.isSolved() || better(*cost, solution.cost))) solution = {*cost, aliveOf(state), candidate.guess};
+            }
+
+            remember(key, solution);
+            return solution;
+        }
+
+        // Solves state within budget with its candidates spread over the task queue, first among equal costs by rank
+        Entry solveRoot(const State& state, uint32_t budget) {
+            const size_t n = state.targets.size();
+            if (n <= 2) return trivial(state, budget);
+            if (lowerBound(n).worstCase > budget) return unsolved(state);
+
+            const auto key = keyOf(state, budget);
+            if (auto known = lookup(key, aliveOf(state))) {
+                record({.memoHits = 1});
+                return *known;
+            }
+
+            const auto candidates = rank(state, budget);
+            std::vector<std::optional<Cost>> costs(candidates.size());
+            std::mutex bestMtx;
+            std::optional<Cost> bestCost;
+            auto best = [&]() -> std::optional<Cost> {
+                std::lock_guard<std::mutex> lock(bestMtx);
+                return bestCost;
+            };
+
+            for (size_t k = 0; k < candidates.size(); ++k) {
+                taskQueue.push([&, k]() {
+                    SolveStats local{};
+                    costs[k] = evaluate(state, candidates[k].guess, budget, best, local);
+                    record(local);
+
+                    std::lock_guard<std::mutex> lock(bestMtx);
+                    if (costs[k] && (!bestCost || better(*costs[k], *bestCost))) bestCost = costs[k];
+                });
+            }
+            taskQueue.wait();
+            record({.states = 1});
+
+            Entry solution = unsolved(state);
+            for (size_t k = 0; k < candidates.size(); ++k) {
+                if (costs[k] && (!solution.isSolved() || better(*costs[k], solution.cost))) solution = {*costs[k], aliveOf(state), candidates[k].guess};
+            }
+
+            remember(key, solution);
+            return solution;
+        }
+
+        static State stateOf(std::span<const WordIndex> targets, std::span<const WordIndex> fillers) {
+            guard::hybridGuard<std::invalid_argument>(!targets.empty(), "the solver requires at least one alive target");
+            guard::hybridGuard<std::invalid_argument>(HardMode || fillers.empty(), "easy mode states have no fillers");
+            return {Words(targets.begin(), targets.end()), Words(fillers.begin(), fillers.end())};
+        }
+
+        // Best solution of state under the objective
+        Entry solveFor(const State& state) {
+            if (options.objective == Objective::EXPECTED) return solveRoot(state, UNLIMITED);
+
+            // The unlimited solution's worst case is a budget that solves the state, so the search ends by then
+            const uint32_t feasible = solveRoot(state, UNLIMITED).cost.worstCase;
+            for (uint32_t budget = lowerBound(state.targets.size()).worstCase; budget < feasible; ++budget) {
+                if (const Entry entry = solveRoot(state, budget); entry.isSolved()) return entry;
+            }
+            return solveRoot(state, feasible);
+        }
+
+    public:
+        static constexpr book::Mode BOOK_MODE = HardMode ? book::Mode::HARD : book::Mode::EASY;
+
+        explicit Solver(
+            std::shared_ptr<const engine::Context> _context = engine::Context::shared(),
+            Options _options = Options::forMode(BOOK_MODE),
+            size_t maxThreads = config::HARDWARE_CONCURRENCY
+        )
+        : context{requireContext(std::move(_context))},
+          fMap{context->view()},
+          options{_options},
+          taskQueue{maxThreads} {}
+
+        /*
+        Solves the state with alive targets and (in HardMode) alive fillers, which must be distinct indices of the
+        right kind. Returns the best guess there under the objective and the cost of playing on optimally.
+        */
+        Entry solve(std::span<const WordIndex> targets, std::span<const WordIndex> fillers = {}) {
+            return solveFor(stateOf(targets, fillers));
+        }
+
+        // Solves the whole game
+        Entry solve() {
+            return solveFor(wholeGame());
+        }
+
+        // Best solution of the state that solves every target within maxGuesses guesses (unsolved if there is none)
+        Entry solveWithin(std::span<const WordIndex> targets, std::span<const WordIndex> fillers, uint32_t maxGuesses) {
+            return solveRoot(stateOf(targets, fillers), maxGuesses);
+        }
+
+        // Game tree of the solved strategy from the given state (solving any state the memo lacks)
+        book::OpeningBook strategy(std::span<const WordIndex> targets, std::span<const WordIndex> fillers = {});
+
+        // Game tree of the solved strategy for the whole game
+        book::OpeningBook strategy();
+
+        // Replaces the memo with the one at path, if it was solved for this configuration
+        bool load(std::string_view path) {
+            auto loaded = readMemo(path, BOOK_MODE, options, context->vocab());
+            if (!loaded) return false;
+            std::unique_lock<std::shared_mutex> lock(memoMtx);
+            memo = std::move(*loaded);
+            return true;
+        }
+
+        bool save(std::string_view path) const {
+            std::shared_lock<std::shared_mutex> lock(memoMtx);
+            return writeMemo(path, BOOK_MODE, options, context->vocab(), memo);
+        }
+
+        size_t memoSize() const {
+            std::shared_lock<std::shared_mutex> lock(memoMtx);
+            return memo.size();
+        }
+
+        SolveStats getStats() const {
+            std::lock_guard<std::mutex> lock(statsMtx);
+            return totals;
+        }
+
+        const Options& getOptions() const noexcept {
+            return options;
+        }
+
+        const feedback::FeedbackMatrixView& getFMap() const noexcept {
+            return fMap;
+        }
+
+        const vocab::Vocab& getVocab() const noexcept {
+            return context->vocab();
+        }
+    };
+
+    /*
+    The solved strategy behind the interface book::Builder records, starting from a given state.
+    Every guess leaves the next state one guess less of the root's budget. Suggestions carry the expected remaining
+    guesses where bots report entropy.
+    */
+    template <bool HardMode>
+    class StrategyReplay {
+        using Words = std::vector<WordIndex>;
+
+        Solver<HardMode>& solver;
+        const Words rootTargets;
+        const Words rootFillers;
+        const uint32_t rootBudget;
+        Words targets;
+        Words fillers;
+        uint32_t budget = UNLIMITED;
+
+    public:
+        static constexpr book::Mode BOOK_MODE = Solver<HardMode>::BOOK_MODE;
+
+        StrategyReplay(Solver<HardMode>& _solver, std::span<const WordIndex> _targets, std::span<const WordIndex> _fillers)
+        : solver{_solver},
+          rootTargets(_targets.begin(), _targets.end()),
+          rootFillers(_fillers.begin(), _fillers.end()),
+          rootBudget{_solver.getOptions().objective == Objective::EXPECTED ? UNLIMITED : _solver.solve(_targets, _fillers).cost.worstCase} {
+            reset();
+        }
+
+        void reset() {
+            targets = rootTargets;
+            fillers = rootFillers;
+            budget = rootBudget;
+        }
+
+        void filter(size_t guessIndex, feedback::Encoding fbEncoding) {
+            auto mismatch = [&](WordIndex w) { return solver.getFMap()[w][guessIndex] != fbEncoding; };
+            std::erase_if(targets, mismatch);
+            std::erase_if(fillers, mismatch);
+            if (budget != UNLIMITED) --budget;
+        }
+
+        bot::Suggestion suggest() {
+            if (targets.empty()) return {};
+            const Entry entry = solver.solveWithin(targets, fillers, budget);
+            if (!entry.isSolved()) return {};
+            const double expected = static_cast<double>(entry.cost.totalGuesses) / static_cast<double>(targets.size());
+            return {expected, solver.getVocab()[entry.guess], entry.guess, true};
+        }
+
+        std::span<const WordIndex> getAliveTargets() const noexcept {
+            return targets;
+        }
+
+        const feedback::FeedbackMatrixView& getFMap() const noexcept {
+            return solver.getFMap();
+        }
+
+        const vocab::Vocab& getVocab() const noexcept {
+            return solver.getVocab();
+        }
+
+        size_t getBeamCandidates() const noexcept {
+            return book::SOLVER_BEAM;
+        }
+
+        // Strategies are not searches; this only satisfies Builder, which records nothing but standard plans
+        const lookahead::Plan& getLookahead() const noexcept {
+            static const lookahead::Plan plan = lookahead::Plan::standard(book::SOLVER_BEAM);
+            return plan;
+        }
+    };
+
+    template <bool HardMode>
+    book::OpeningBook Solver<HardMode>::strategy(std::span<const WordIndex> targets, std::span<const WordIndex> fillers) {
+        StrategyReplay<HardMode> replay{*this, targets, fillers};
+        return book::Builder<StrategyReplay<HardMode>>{replay}.build();
+    }
+
+    template <bool HardMode>
+    book::OpeningBook Solver<HardMode>::strategy() {
+        const State game = wholeGame();
+        return strategy(game.targets, game.fillers);
+    }
+}
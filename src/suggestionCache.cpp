@@ -0,0 +1,52 @@
+#include "guard.hpp"
+#include "suggestionCache.hpp"
+
+wordle::cache::SuggestionCache::SuggestionCache(size_t _capacity) : capacity{_capacity} {
+    guard::hybridGuard<std::invalid_argument>(capacity > 0, "SuggestionCache requires a positive capacity");
+    index.reserve(capacity);
+}
+
+std::optional<wordle::cache::CachedSuggestion> wordle::cache::SuggestionCache::find(wordle::fingerprint::Fingerprint key, size_t numAlive) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = index.find(key);
+    if (it == index.end() || it->second->second.numAlive != numAlive) {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    recency.splice(recency.begin(), recency, it->second);
+    hitCount.fetch_add(1, std::memory_order_relaxed);
+    return it->second->second;
+}
+
+void wordle::cache::SuggestionCache::insert(wordle::fingerprint::Fingerprint key, const CachedSuggestion& suggestion) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Step 1: Refresh an existing entry (another thread may have searched the same set)
+    if (auto it = index.find(key); it != index.end()) {
+        it->second->second = suggestion;
+        recency.splice(recency.begin(), recency, it->second);
+        return;
+    }
+
+    // Step 2: Evict the least recently used entry, then insert at the front
+    if (recency.size() >= capacity) {
+        index.erase(recency.back().first);
+        recency.pop_back();
+    }
+    recency.emplace_front(key, suggestion);
+    index.emplace(key, recency.begin());
+}
+
+void wordle::cache::SuggestionCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    recency.clear();
+    index.clear();
+    hitCount.store(0, std::memory_order_relaxed);
+    missCount.store(0, std::memory_order_relaxed);
+}
+
+size_t wordle::cache::SuggestionCache::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return recency.size();
+}
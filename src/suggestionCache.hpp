@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "config.hpp"
+#include "fingerprint.hpp"
+
+/*
+Transposition cache for suggest(): remembers the suggestion made for an alive set, keyed by its (salted) fingerprint.
+Bounded by capacity with least-recently-used eviction, safe to share between threads and bots.
+Entries store the guess index rather than a string_view, so they outlive the bot that made them.
+*/
+namespace wordle::cache {
+
+    struct CachedSuggestion {
+        double entropy;
+        uint32_t guessIndex;
+        uint32_t numAlive;  // Cheap guard against fingerprint collisions
+    };
+
+    class SuggestionCache {
+        using Entry = std::pair<fingerprint::Fingerprint, CachedSuggestion>;
+
+        const size_t capacity;
+        mutable std::mutex mtx;
+        std::list<Entry> recency;  // Most recently used first
+        std::unordered_map<fingerprint::Fingerprint, std::list<Entry>::iterator> index;
+        alignas(config::CACHE_LINE_SIZE) std::atomic_size_t hitCount = 0;
+        alignas(config::CACHE_LINE_SIZE) std::atomic_size_t missCount = 0;
+
+    public:
+        explicit SuggestionCache(size_t _capacity = DEFAULT_CAPACITY);
+
+        static constexpr size_t DEFAULT_CAPACITY = 1ul << 16;
+
+        SuggestionCache(const SuggestionCache&) = delete;
+        SuggestionCache& operator=(const SuggestionCache&) = delete;
+
+        // Returns the suggestion cached for key (and marks it recently used), counting a hit or a miss
+        [[nodiscard]] std::optional<CachedSuggestion> find(fingerprint::Fingerprint key, size_t numAlive);
+
+        // Caches suggestion under key, evicting the least recently used entry when full
+        void insert(fingerprint::Fingerprint key, const CachedSuggestion& suggestion);
+
+        void clear();
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t maxSize() const noexcept { return capacity; }
+        [[nodiscard]] size_t hits() const noexcept { return hitCount.load(std::memory_order_relaxed); }
+        [[nodiscard]] size_t misses() const noexcept { return missCount.load(std::memory_order_relaxed); }
+    };
+
+}  // namespace wordle::cache
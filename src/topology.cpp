@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "topology.hpp"
+
+namespace {
+    std::optional<int> parseInt(std::string_view text) {
+        int value = 0;
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{} || end != text.data() + text.size() || value < 0) return std::nullopt;
+        return value;
+    }
+}
+
+wordle::topology::CpuSet wordle::topology::parseCpuList(std::string_view text) {
+    while (!text.empty() && (text.back() == '\n' || text.back() == ' ')) text.remove_suffix(1);
+
+    CpuSet cpus;
+    while (!text.empty()) {
+        const size_t comma = std::min(text.find(','), text.size());
+        const auto range = text.substr(0, comma);
+        text.remove_prefix(std::min(comma + 1, text.size()));
+
+        const size_t dash = range.find('-');
+        const auto first = parseInt(range.substr(0, dash));
+        const auto last = dash == std::string_view::npos ? first : parseInt(range.substr(dash + 1));
+        if (!first || !last || *last < *first) return {};
+        for (int cpu = *first; cpu <= *last; ++cpu) cpus.push_back(cpu);
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+wordle::topology::CpuSet wordle::topology::allowedCpus() {
+    CpuSet cpus;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (::sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+    }
+#endif
+    if (cpus.empty()) {
+        for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+size_t wordle::topology::hardwareConcurrency() {
+    static const size_t count = allowedCpus().size();
+    return count;
+}
+
+wordle::topology::Topology wordle::topology::Topology::fromSysfs(std::string_view sysfsRoot, const CpuSet& allowed) {
+    Topology topology;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path{sysfsRoot}, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (!name.starts_with("node")) continue;
+        const auto id = parseInt(std::string_view{name}.substr(4));
+        if (!id) continue;
+
+        std::ifstream file{entry.path() / "cpulist"};
+        std::string line;
+        if (!std::getline(file, line)) continue;
+
+        Node node{static_cast<size_t>(*id), {}};
+        for (int cpu : parseCpuList(line)) {
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu)) node.cpus.push_back(cpu);
+        }
+        if (!node.cpus.empty()) topology.nodeList.push_back(std::move(node));
+    }
+    std::sort(topology.nodeList.begin(), topology.nodeList.end(), [](const Node& a, const Node& b) { return a.id < b.id; });
+    return topology;
+}
+
+const wordle::topology::Topology& wordle::topology::Topology::system() {
+    static const Topology topology = [] {
+        const auto allowed = allowedCpus();
+#ifdef __linux__
+        auto detected = fromSysfs("/sys/devices/system/node", allowed);
+#else
+        Topology detected;
+#endif
+        if (detected.numNodes() == 0) detected.nodeList.push_back({0, allowed});
+        return detected;
+    }();
+    return topology;
+}
+
+size_t wordle::topology::Topology::numCpus() const noexcept {
+    size_t count = 0;
+    for (const auto& node : nodeList) count += node.cpus.size();
+    return count;
+}
+
+std::optional<size_t> wordle::topology::Topology::nodeOfCpu(int cpu) const noexcept {
+    for (size_t i = 0; i < nodeList.size(); ++i) {
+        if (std::binary_search(nodeList[i].cpus.begin(), nodeList[i].cpus.end(), cpu)) return i;
+    }
+    return std::nullopt;
+}
+
+std::vector<wordle::topology::CpuSet> wordle::topology::Topology::spread() const {
+    std::vector<CpuSet> sets;
+    sets.reserve(nodeList.size());
+    for (const auto& node : nodeList) sets.push_back(node.cpus);
+    return sets;
+}
+
+bool wordle::topology::pinThread(std::thread::native_handle_type thread, const CpuSet& cpus) noexcept {
+#ifdef __linux__
+    if (cpus.empty()) return false;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int cpu : cpus) if (cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+    return ::pthread_setaffinity_np(thread, sizeof(mask), &mask) == 0;
+#else
+    static_cast<void>(thread);
+    static_cast<void>(cpus);
+    return false;
+#endif
+}
+
+std::optional<int> wordle::topology::currentCpu() noexcept {
+#ifdef __linux__
+    const int cpu = ::sched_getcpu();
+    if (cpu >= 0) return cpu;
+#endif
+    return std::nullopt;
+}
+
+std::optional<size_t> wordle::topology::currentNode() noexcept {
+    const auto cpu = currentCpu();
+    if (!cpu) return std::nullopt;
+    return Topology::system().nodeOfCpu(*cpu);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/*
+Runtime CPU and NUMA topology, read from /sys/devices/system/node and restricted to the CPUs this process may run on
+(taskset, cgroups). Machines without NUMA information are one node holding every allowed CPU. Affinity and node
+detection are Linux only: elsewhere the system is one node of std::thread::hardware_concurrency() CPUs and threads
+can't be pinned.
+
+config::HARDWARE_CONCURRENCY stays the compile-time default thread count and beam width: the beam decides which
+suggestions the bots make and which opening books they accept, so it can't follow the machine. hardwareConcurrency()
+is what thread pools and simulations should size themselves by.
+*/
+namespace wordle::topology {
+
+    using CpuSet = std::vector<int>;
+
+    struct Node {
+        size_t id;    // Kernel node number
+        CpuSet cpus;  // Allowed CPUs of the node, ascending
+    };
+
+    class Topology {
+        std::vector<Node> nodeList;
+
+    public:
+        // Nodes listed in sysfsRoot ("node<N>/cpulist" files), keeping only CPUs in allowed and nodes left with any
+        static Topology fromSysfs(std::string_view sysfsRoot, const CpuSet& allowed);
+
+        // This machine's topology, detected once
+        static const Topology& system();
+
+        [[nodiscard]] size_t numNodes() const noexcept { return nodeList.size(); }
+
+        [[nodiscard]] size_t numCpus() const noexcept;
+
+        [[nodiscard]] const Node& node(size_t index) const noexcept { return nodeList[index]; }
+
+        [[nodiscard]] const std::vector<Node>& nodes() const noexcept { return nodeList; }
+
+        // Index (into nodes()) of the node holding cpu, if any
+        [[nodiscard]] std::optional<size_t> nodeOfCpu(int cpu) const noexcept;
+
+        // One CPU set per node, for pinning workers round-robin across nodes
+        [[nodiscard]] std::vector<CpuSet> spread() const;
+    };
+
+    // Parses a kernel CPU list such as "0-3,8,10-11". Returns an empty set if text is malformed.
+    CpuSet parseCpuList(std::string_view text);
+
+    // CPUs the calling process may run on
+    CpuSet allowedCpus();
+
+    // Number of CPUs this process may run on (at least 1)
+    size_t hardwareConcurrency();
+
+    // Restricts thread to cpus. Returns false if the kernel refused (cpus empty or not allowed) or pinning is unsupported.
+    bool pinThread(std::thread::native_handle_type thread, const CpuSet& cpus) noexcept;
+
+    // CPU the calling thread is running on, if the platform tells
+    std::optional<int> currentCpu() noexcept;
+
+    // Index (into Topology::system().nodes()) of the node the calling thread is running on
+    std::optional<size_t> currentNode() noexcept;
+
+}  // namespace wordle::topology
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <iomanip>
 #include <iostream>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -34,6 +35,36 @@ constexpr inline R constexprPow(T base, T power) {
     return static_cast<R>(base) * constexprPow(base, power - 1);
 }
 
+/*
+Allocator returning Alignment-aligned storage, e.g. so std::vector rows start on a cache line.
+*/
+template <typename T, size_t Alignment>
+requires (std::has_single_bit(Alignment) && Alignment >= alignof(T))
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        ::operator delete(ptr, n * sizeof(T), std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
 inline void showProgressBar(size_t current, size_t total, size_t barWidth = 50) {
     double progress = static_cast<double>(current) / total;
     size_t pos = static_cast<size_t>(barWidth * progress);
@@ -1,45 +1,173 @@
 #pragma once
 
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <thread>
+#include <array>
+#include <compare>
+#include <cstring>
+#include <filesystem>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <vector>
 
 #include "config.hpp"
 #include "guard.hpp"
+#include "mappedFile.hpp"
 
 namespace wordle::vocab {
 
-using Vocab = std::vector<std::string>;
+/*
+Fixed-width word list: every word is WordLength letters stored back to back in one contiguous char[size()][WordLength]
+buffer, so hot loops reading vocab[i] touch one array instead of thousands of scattered heap strings.
+Words are read as std::string_views into that buffer, which stay valid for the vocab's lifetime.
+*/
+template <size_t WordLength>
+class BasicVocab {
+public:
+    using Word = std::array<char, WordLength>;
+    static_assert(sizeof(Word) == WordLength, "words must pack back to back");
+
+private:
+    std::vector<Word> words;
+
+public:
+    // Random access over the words as std::string_views
+    class Iterator {
+        const Word* word = nullptr;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+        using pointer = void;
+
+        constexpr Iterator() noexcept = default;
+        constexpr explicit Iterator(const Word* _word) noexcept : word{_word} {}
+
+        constexpr std::string_view operator*() const noexcept { return {word->data(), WordLength}; }
+        constexpr std::string_view operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        constexpr Iterator& operator++() noexcept { ++word; return *this; }
+        constexpr Iterator operator++(int) noexcept { return Iterator{word++}; }
+        constexpr Iterator& operator--() noexcept { --word; return *this; }
+        constexpr Iterator operator--(int) noexcept { return Iterator{word--}; }
+        constexpr Iterator& operator+=(difference_type n) noexcept { word += n; return *this; }
+        constexpr Iterator& operator-=(difference_type n) noexcept { word -= n; return *this; }
+
+        friend constexpr Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+        friend constexpr Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+        friend constexpr Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+        friend constexpr difference_type operator-(Iterator a, Iterator b) noexcept { return a.word - b.word; }
+        friend constexpr bool operator==(Iterator a, Iterator b) noexcept = default;
+        friend constexpr std::strong_ordering operator<=>(Iterator a, Iterator b) noexcept { return a.word <=> b.word; }
+    };
+
+    BasicVocab() noexcept = default;
+
+    BasicVocab(std::initializer_list<std::string_view> list) {
+        reserve(list.size());
+        for (std::string_view word : list) push_back(word);
+    }
+
+    // Words packed as by letters(). Throws if letters isn't a whole number of words.
+    static BasicVocab fromLetters(std::span<const char> letters) {
+        guard::hybridGuard<std::invalid_argument>(letters.size() % WordLength == 0, "packed letters must hold whole words");
+        BasicVocab vocab;
+        vocab.words.resize(letters.size() / WordLength);
+        std::memcpy(vocab.words.data(), letters.data(), letters.size());
+        return vocab;
+    }
+
+    void reserve(size_t numWords) { words.reserve(numWords); }
+
+    // Appends word, which must have WORD_LENGTH letters
+    void push_back(std::string_view word) {
+        guard::hybridGuard<std::invalid_argument>(word.size() == WordLength, "vocab words must have WORD_LENGTH letters");
+        Word& slot = words.emplace_back();
+        std::memcpy(slot.data(), word.data(), WordLength);
+    }
+
+    // Exchanges the words at two indices
+    void swap(size_t first, size_t second) noexcept { std::swap(words[first], words[second]); }
+
+    void append(const BasicVocab& other) { words.insert(words.end(), other.words.begin(), other.words.end()); }
+
+    // Lowercases every ASCII letter in one branch-free pass over the packed letters (vectorized by the compiler)
+    void lowercase() noexcept {
+        char* letters = reinterpret_cast<char*>(words.data());
+        const size_t numLetters = words.size() * WordLength;
+        for (size_t i = 0; i < numLetters; ++i) {
+            const char c = letters[i];
+            letters[i] = static_cast<char>(c + (static_cast<char>(static_cast<unsigned char>(c - 'A') < 26) << 5));
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return words.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return words.empty(); }
+
+    [[nodiscard]] std::string_view operator[](size_t index) const noexcept { return {words[index].data(), WordLength}; }
+
+    [[nodiscard]] Iterator begin() const noexcept { return Iterator{words.data()}; }
+
+    [[nodiscard]] Iterator end() const noexcept { return Iterator{words.data() + words.size()}; }
+
+    // Contiguous char[size()][WORD_LENGTH]
+    [[nodiscard]] const Word* data() const noexcept { return words.data(); }
+
+    // Every letter, word after word, with no separators
+    [[nodiscard]] std::span<const char> letters() const noexcept {
+        return {reinterpret_cast<const char*>(words.data()), words.size() * WordLength};
+    }
+
+    friend bool operator==(const BasicVocab& a, const BasicVocab& b) noexcept = default;
+};
+
+using Vocab = BasicVocab<config::WORD_LENGTH>;
+using Word = Vocab::Word;
 
 namespace __impl {
-    inline Vocab processFile(std::string_view fileName, size_t numWords) {
-    // Open file
-    std::ifstream file{fileName};
-    if (!file) guard::formatError("failed to open {}", fileName);
-
-    // Reserve space for words
-    Vocab words;
-    words.reserve(numWords);
-
-    // Add processed words from file
-    std::string buff;
-    while (std::getline(file, buff)) {
-        // Trim in-place
-        auto first = buff.find_first_not_of(" \t\r\n");
-        auto last = buff.find_last_not_of(" \t\r\n");
-        if (first == std::string::npos || last == std::string::npos) continue;
-        buff = buff.substr(first, last - first + 1);
-
-        // Lowercase in-place
-        for (char& c : buff) {
-            char letter = c;
-            if ('A' <= letter && letter <= 'Z') c += ('a' - 'A');
+    constexpr inline bool isBlank(char c) noexcept {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    // Maps fileName and parses it in one pass: one word per line, surrounding whitespace and blank lines ignored
+    template <size_t WordLength = config::WORD_LENGTH>
+    inline BasicVocab<WordLength> processFile(std::string_view fileName, size_t numWords) {
+        // Step 1: Map the file (an empty file maps to nothing and holds no words)
+        const auto file = util::MappedFile::open(fileName);
+        if (!file.isOpen()) {
+            guard::runtimeGuard(std::filesystem::is_regular_file(fileName), "failed to open {}", fileName);
+            return {};
+        }
+
+        // Step 2: Trim each line and copy it into the next fixed-width slot
+        BasicVocab<WordLength> words;
+        words.reserve(numWords);
+        const char* cursor = reinterpret_cast<const char*>(file.data());
+        const char* const end = cursor + file.size();
+        while (cursor < end) {
+            const auto* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+            const char* lineEnd = newline ? newline : end;
+
+            const char* first = cursor;
+            const char* last = lineEnd;
+            while (first < last && isBlank(*first)) ++first;
+            while (last > first && isBlank(last[-1])) --last;
+            if (first < last) {
+                const std::string_view word{first, static_cast<size_t>(last - first)};
+                guard::runtimeGuard(word.size() == WordLength, "{}: \"{}\" is not a {}-letter word", fileName, word, WordLength);
+                words.push_back(word);
+            }
+            cursor = lineEnd + 1;
         }
-        words.push_back(std::move(buff));
+
+        // Step 3: Lowercase all the words at once
+        words.lowercase();
+        return words;
     }
-    return words;
-}
 }
 
 
@@ -51,10 +179,9 @@ inline Vocab constructVocab() {
     // Form result
     Vocab vocab;
     vocab.reserve(targets.size() + fillers.size());
-
-    vocab.insert(vocab.end(), std::make_move_iterator(targets.begin()), std::make_move_iterator(targets.end()));
-    vocab.insert(vocab.end(), std::make_move_iterator(fillers.begin()), std::make_move_iterator(fillers.end()));
+    vocab.append(targets);
+    vocab.append(fillers);
     return vocab;
 }
 
-}
\ No newline at end of file
+}
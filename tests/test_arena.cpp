@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "../src/arena.hpp"
+#include "../src/feedback.hpp"
+
+using namespace wordle;
+
+namespace {
+    using Table = std::vector<uint8_t, util::ArenaAllocator<uint8_t>>;
+
+    // Restores the default policy when a test ends
+    struct PolicyScope {
+        explicit PolicyScope(util::arena::Policy policy) noexcept { util::arena::setPolicy(policy); }
+        ~PolicyScope() { util::arena::setPolicy(util::arena::Policy::TRANSPARENT); }
+    };
+}
+
+TEST_CASE("Arena: small tables stay on the aligned heap", "[arena]") {
+    const auto before = util::arena::stats();
+    Table small(1000, 7);
+    REQUIRE(reinterpret_cast<uintptr_t>(small.data()) % config::CACHE_LINE_SIZE == 0);
+    REQUIRE(util::arena::stats().arenas == before.arenas);
+}
+
+TEST_CASE("Arena: large tables get their own zeroed, huge page aligned mapping", "[arena]") {
+    const auto before = util::arena::stats();
+    {
+        Table large(3 * util::arena::HUGE_PAGE_SIZE + 5);
+        REQUIRE(reinterpret_cast<uintptr_t>(large.data()) % util::arena::HUGE_PAGE_SIZE == 0);
+        REQUIRE(large.front() == 0);
+        REQUIRE(large.back() == 0);
+
+        const auto during = util::arena::stats();
+        REQUIRE(during.arenas == before.arenas + 1);
+        REQUIRE(during.total() == before.total() + 4 * util::arena::HUGE_PAGE_SIZE);
+
+        // Growing moves to a new arena and releases the old one
+        large.resize(5 * util::arena::HUGE_PAGE_SIZE, 1);
+        REQUIRE(large[3 * util::arena::HUGE_PAGE_SIZE] == 0);
+        REQUIRE(large.back() == 1);
+        REQUIRE(util::arena::stats().arenas == before.arenas + 1);
+
+        // Whatever the kernel gave us, it never exceeds the table
+        REQUIRE(util::arena::hugePageBytes(large.data(), large.size()) <= large.size());
+    }
+    REQUIRE(util::arena::stats().arenas == before.arenas);
+}
+
+TEST_CASE("Arena: policies fall back gracefully", "[arena]") {
+    SECTION("Off") {
+        PolicyScope scope{util::arena::Policy::OFF};
+        Table table(util::arena::HUGE_PAGE_SIZE, 3);
+        REQUIRE(util::arena::backingOf(table.data()) == util::arena::Backing::NONE);
+        REQUIRE(util::arena::hugePageBytes(table.data(), table.size()) == 0);
+    }
+
+    SECTION("Hugetlbfs, or transparent huge pages when the pool is empty") {
+        PolicyScope scope{util::arena::Policy::HUGETLB};
+        Table table(util::arena::HUGE_PAGE_SIZE, 3);
+        REQUIRE(table[util::arena::HUGE_PAGE_SIZE - 1] == 3);
+        const auto backing = util::arena::backingOf(table.data());
+        REQUIRE((backing != util::arena::Backing::NONE || !util::arena::isSupported(util::arena::Backing::TRANSPARENT)));
+        if (backing == util::arena::Backing::HUGETLB) REQUIRE(util::arena::hugePageBytes(table.data(), table.size()) == table.size());
+    }
+
+    SECTION("Unknown pointers") {
+        int local = 0;
+        REQUIRE(util::arena::backingOf(&local) == util::arena::Backing::NONE);
+        REQUIRE(util::arena::hugePageBytes(&local, sizeof(local)) == 0);
+    }
+}
+
+TEST_CASE("Arena: flat feedback maps live in an arena", "[arena]") {
+    feedback::FlatFeedbackMap rows(config::NUM_WORDS * feedback::FLAT_STRIDE);
+    REQUIRE(reinterpret_cast<uintptr_t>(rows.data()) % util::arena::HUGE_PAGE_SIZE == 0);
+    if (util::arena::isSupported(util::arena::Backing::TRANSPARENT)) {
+        REQUIRE(util::arena::backingOf(rows.data()) == util::arena::Backing::TRANSPARENT);
+    }
+}
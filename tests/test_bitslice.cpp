@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "../src/bitSlice.hpp"
+#include "../src/engineContext.hpp"
+#include "../src/hardBot.hpp"
+
+using namespace wordle;
+
+namespace {
+    std::vector<histogram::WordIndex> randomTargets(std::mt19937& rng, size_t size) {
+        std::vector<histogram::WordIndex> targets(config::NUM_TARGETS);
+        std::iota(targets.begin(), targets.end(), 0);
+        std::shuffle(targets.begin(), targets.end(), rng);
+        targets.resize(size);
+        std::sort(targets.begin(), targets.end());
+        return targets;
+    }
+}
+
+TEST_CASE("Bit Slice: countBins matches the gather path", "[bitslice][slow]") {
+    const auto context = engine::Context::shared();
+    const auto& planes = context->planes();
+    REQUIRE(&planes == &context->planes());
+    REQUIRE(planes.bytes() == config::NUM_WORDS * bitslice::PLANES_PER_GUESS * bitslice::TARGET_WORDS * sizeof(bitslice::Word));
+
+    std::mt19937 rng{7};
+    entropy::SparseHistogram gathered;
+    entropy::SparseHistogram sliced;
+    bitslice::AliveSet alive;
+    std::uniform_int_distribution<size_t> guessDist(0, config::NUM_WORDS - 1);
+
+    // Sizes straddle SHORTCUT_COUNT and histogram::SMALL_INPUT; the full set covers every target word
+    for (size_t size : {0ul, 1ul, 3ul, 4ul, 5ul, 37ul, 300ul, config::NUM_TARGETS}) {
+        const auto targets = randomTargets(rng, size);
+        alive.assign(targets.cbegin(), targets.cend());
+        REQUIRE(alive.size() == size);
+
+        for (size_t trial = 0; trial < 50; ++trial) {
+            const size_t guessIndex = trial == 0 ? config::NUM_WORDS - 1 : guessDist(rng);
+            const auto* row = context->view().row(guessIndex);
+            gathered.count(row, targets.cbegin(), targets.cend());
+            bitslice::countBins(planes, guessIndex, row, alive, sliced);
+
+            REQUIRE(sliced.binCounts() == gathered.binCounts());
+            REQUIRE(sliced.touchedBins() == gathered.touchedBins());
+            if (size > 0) REQUIRE(sliced.exactEntropy(size) == gathered.exactEntropy(size));
+        }
+    }
+}
+
+TEST_CASE("Bit Slice: bots suggest the same with either counting", "[bitslice][slow]") {
+    bot::HardBot gatherBot{1, 4};
+    bot::HardBot slicedBot{gatherBot.getContext(), 1, 4};
+    slicedBot.setCounting(bitslice::Counting::BITSLICED);
+    REQUIRE(slicedBot.getCounting() == bitslice::Counting::BITSLICED);
+
+    // Play one game as far as it goes, comparing every suggestion
+    const size_t solutionIndex = 123;
+    const auto& fMapSlice = gatherBot.getFMap()[solutionIndex];
+    for (size_t turn = 0; turn < 6; ++turn) {
+        const auto expected = gatherBot.suggest();
+        const auto actual = slicedBot.suggest();
+        REQUIRE(actual.isValid == expected.isValid);
+        REQUIRE(actual.guessIndex == expected.guessIndex);
+        REQUIRE(actual.entropy == expected.entropy);
+        if (expected.guessIndex == solutionIndex) break;
+        gatherBot.filter(expected.guessIndex, fMapSlice[expected.guessIndex]);
+        slicedBot.filter(actual.guessIndex, fMapSlice[actual.guessIndex]);
+    }
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/embeddedMatrix.hpp"
+#include "../src/engineContext.hpp"
+#include "../src/feedbackCache.hpp"
+#include "../src/parallelTaskQueue.hpp"
+
+using namespace wordle::feedback;
+
+TEST_CASE("Embedded Matrix: matches the runtime vocab and constructFeedbackMap", "[feedback][embedded][slow]") {
+    if (!embedded::available()) {
+        // Builds without WORDLE_EMBED_MATRIX embed nothing and fall back to the word lists
+        REQUIRE(embedded::vocabImage().empty());
+        REQUIRE(embedded::matrixImage().empty());
+        REQUIRE_FALSE(embedded::loadVocab().has_value());
+        REQUIRE_FALSE(embedded::loadMatrix(wordle::vocab::constructVocab()).has_value());
+        return;
+    }
+
+    const auto vocab = wordle::vocab::constructVocab();
+    const auto embeddedVocab = embedded::loadVocab();
+    REQUIRE(embeddedVocab.has_value());
+    REQUIRE(*embeddedVocab == vocab);
+
+    const auto matrix = embedded::loadMatrix(vocab);
+    REQUIRE(matrix.has_value());
+    REQUIRE(matrix->layout() == Layout::FLAT);
+    REQUIRE(reinterpret_cast<uintptr_t>(matrix->data()) % wordle::config::CACHE_LINE_SIZE == 0);
+
+    wordle::parallel::TaskQueue queue(wordle::config::HARDWARE_CONCURRENCY);
+    const auto reference = constructFeedbackMap(vocab, queue, wordle::config::HARDWARE_CONCURRENCY);
+    size_t mismatchedRows = 0;
+    for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+        const auto row = (*matrix)[guessIndex];
+        mismatchedRows += !std::equal(row.begin(), row.end(), reference[guessIndex].begin());
+    }
+    REQUIRE(mismatchedRows == 0);
+
+    // Other word lists don't get the embedded rows
+    auto swapped = vocab;
+    swapped.swap(0, 1);
+    REQUIRE_FALSE(embedded::loadMatrix(swapped).has_value());
+
+    // Contexts are served straight from the binary
+    const auto context = wordle::engine::Context::create(Layout::FLAT, 1);
+    REQUIRE_FALSE(context->isMapped());
+    REQUIRE(context->view().data() == reinterpret_cast<const Encoding*>(embedded::matrixImage().data() + cache::PAYLOAD_OFFSET));
+    REQUIRE(context->vocab() == vocab);
+}
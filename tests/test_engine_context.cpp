@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/easyBot.hpp"
+#include "../src/engineContext.hpp"
+#include "../src/hardBot.hpp"
+
+using namespace wordle;
+
+TEST_CASE("Engine Context: bots borrow one shared context", "[engine][slow]") {
+    bot::HardBot hard{1};
+    bot::EasyBot easy{1, 1};
+    REQUIRE(hard.getContext() == easy.getContext());
+    REQUIRE(hard.getContext() == engine::Context::shared());
+    REQUIRE(&hard.getVocab() == &easy.getVocab());
+    REQUIRE(hard.getFMap().row(0) == easy.getFMap().row(0));
+
+    // A private context is only shared by the bots it is handed to
+    const auto context = engine::Context::create(feedback::Layout::NESTED, 1);
+    bot::HardBot first{context, 1};
+    bot::HardBot second{context, 1};
+    REQUIRE(first.getContext() == context);
+    REQUIRE(&first.getVocab() == &second.getVocab());
+    REQUIRE(first.getContext() != hard.getContext());
+    REQUIRE(context->layout() == feedback::Layout::NESTED);
+    REQUIRE(context.use_count() == 3);
+
+    REQUIRE_THROWS_AS(bot::HardBot(std::shared_ptr<const engine::Context>{}, 1), std::invalid_argument);
+}
+
+TEST_CASE("Engine Context: bots are dispatched on the word length", "[engine][slow]") {
+    const auto context = engine::Context::shared();
+    bot::HardBot direct{context, 1, 2};
+    direct.filter(0, direct.getFMap()[7][0]);
+
+    const auto suggestion = spec::dispatchWordLength(config::WORD_LENGTH, [&context]<typename Spec>(std::type_identity<Spec>) {
+        STATIC_REQUIRE(std::is_same_v<bot::BasicHardBot<Spec>, bot::HardBot>);
+        bot::BasicHardBot<Spec> bot{context, 1, 2};
+        bot.filter(0, bot.getFMap()[7][0]);
+        return bot.suggest();
+    });
+    REQUIRE(suggestion.guessIndex == direct.suggest().guessIndex);
+}
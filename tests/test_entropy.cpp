@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include "../src/entropy.hpp"
+
+using namespace wordle::entropy;
+
+namespace {
+    // The per-bin log2 loop the engines used before table-driven scoring
+    double referenceEntropy(const wordle::histogram::BinCounts& binCounts, size_t n) {
+        double entropy = 0;
+        for (double count : binCounts) {
+            if (!count) continue;
+            double prob = count / n;
+            entropy -= prob * std::log2(prob);
+        }
+        return entropy;
+    }
+
+    std::vector<wordle::feedback::Encoding> randomRow(std::mt19937& rng, size_t numBins) {
+        std::vector<wordle::feedback::Encoding> row(wordle::config::NUM_WORDS + wordle::feedback::ROW_PADDING);
+        std::uniform_int_distribution<size_t> encodingDist(0, numBins - 1);
+        for (auto& encoding : row) encoding = static_cast<wordle::feedback::Encoding>(encodingDist(rng));
+        return row;
+    }
+}
+
+TEST_CASE("Entropy: cLogCTable() matches c * log2(c)", "[entropy]") {
+    const auto& table = cLogCTable();
+    REQUIRE(table[0] == 0);
+    REQUIRE(table[1] == 0);
+    REQUIRE(table[2] == Fixed{2} << FIXED_BITS);
+    for (size_t c : {3ul, 100ul, wordle::config::NUM_TARGETS, MAX_COUNT}) {
+        const double expected = static_cast<double>(c) * std::log2(static_cast<double>(c));
+        REQUIRE(std::abs(std::ldexp(static_cast<double>(table[c]), -FIXED_BITS) - expected) < 1e-9);
+    }
+}
+
+TEST_CASE("Entropy: SparseHistogram is bit for bit the per-bin loop", "[entropy]") {
+    std::mt19937 rng{11};
+    std::vector<wordle::histogram::WordIndex> indices(wordle::config::NUM_TARGETS);
+    std::iota(indices.begin(), indices.end(), 0);
+    SparseHistogram histogram;
+
+    // Few bins make repeated counts, many bins make sparse ones; sizes straddle histogram::SMALL_INPUT
+    for (size_t numBins : {3ul, 40ul, wordle::feedback::NUM_FEEDBACKS}) {
+        const auto row = randomRow(rng, numBins);
+        for (size_t n : {3ul, 17ul, 255ul, 256ul, 1000ul, wordle::config::NUM_TARGETS}) {
+            std::shuffle(indices.begin(), indices.end(), rng);
+            wordle::histogram::BinCounts expected{};
+            for (size_t i = 0; i < n; ++i) ++expected[row[indices[i]]];
+
+            histogram.count(row.data(), indices.cbegin(), indices.cbegin() + n);
+            REQUIRE(histogram.binCounts() == expected);
+            REQUIRE(histogram.exactEntropy(n) == referenceEntropy(expected, n));
+            REQUIRE(histogram.exactEntropy(ProbabilityTable{n}) == referenceEntropy(expected, n));
+        }
+    }
+}
+
+TEST_CASE("Entropy: EntropyMaximizer returns the exact maximum", "[entropy]") {
+    std::mt19937 rng{5};
+    std::vector<wordle::histogram::WordIndex> indices(64);
+    std::iota(indices.begin(), indices.end(), 0);
+    SparseHistogram histogram;
+
+    EntropyMaximizer maximizer{indices.size()};
+    double expected = std::numeric_limits<double>::min();
+    for (size_t guess = 0; guess < 500; ++guess) {
+        const auto row = randomRow(rng, 1 + guess % 60);
+        histogram.count(row.data(), indices.cbegin(), indices.cend());
+        maximizer.consider(histogram);
+        expected = std::max(expected, referenceEntropy(histogram.binCounts(), indices.size()));
+    }
+    REQUIRE(maximizer.value() == expected);
+}
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <map>
+#include <random>
 
 #include "../src/feedback.hpp"
 #include "../src/parallelTaskQueue.hpp"
@@ -52,6 +53,7 @@ TEST_CASE("Feedback: Test encodeFeedbackString()", "[feedback]") {
         REQUIRE_NOTHROW(__impl::encodeFeedbackString(std::string_view{fbString.begin(), wordle::config::WORD_LENGTH}));
         Encoding actual = __impl::encodeFeedbackString(std::string_view{fbString.begin(), wordle::config::WORD_LENGTH});
         REQUIRE(encoding == actual);
+        REQUIRE(decodeFeedbackString(encoding) == std::string_view{fbString.begin(), wordle::config::WORD_LENGTH});
     }
 }
 
@@ -127,3 +129,95 @@ TEST_CASE("Feedback: Test ArrEncoder on all words", "[feedback][slow]") {
 
     REQUIRE(passes);
 }
+
+TEST_CASE("Feedback: BatchEncoder matches ArrEncoder on all words", "[feedback][slow]") {
+    const auto vocab = wordle::vocab::constructVocab();
+    const BatchEncoder batch{vocab};
+    REQUIRE(batch.size() == wordle::config::NUM_WORDS);
+
+    // Guard bytes past the row catch stores beyond size()
+    constexpr Encoding GUARD = 0xAB;
+    std::vector<Encoding> row(wordle::config::NUM_WORDS + BatchEncoder::LANES, GUARD);
+    Encoder scalar{};
+    size_t mismatches = 0;
+    for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+        std::string_view guess = vocab[guessIndex];
+        batch(guess, row.data());
+        for (size_t solutionIndex = 0; solutionIndex < wordle::config::NUM_WORDS; ++solutionIndex) {
+            mismatches += row[solutionIndex] != scalar(guess, vocab[solutionIndex]);
+        }
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(std::all_of(row.begin() + wordle::config::NUM_WORDS, row.end(), [](Encoding e) { return e == GUARD; }));
+
+    // Repeated letters in guess and solution
+    const wordle::vocab::Vocab tricky{"speed", "abide", "erase", "eerie", "geese", "llama"};
+    const BatchEncoder small{tricky};
+    std::vector<Encoding> smallRow(tricky.size());
+    for (const auto& guess : tricky) {
+        small(guess, smallRow.data());
+        for (size_t i = 0; i < tricky.size(); ++i) REQUIRE(smallRow[i] == scalar(guess, tricky[i]));
+    }
+}
+
+TEST_CASE("Feedback: encodings widen with the word length", "[feedback]") {
+    using Six = wordle::spec::GameSpec<6, 1, 1>;
+    STATIC_REQUIRE(std::is_same_v<wordle::spec::EncodingFor<4>, uint8_t>);
+    STATIC_REQUIRE(std::is_same_v<wordle::spec::Standard::Encoding, Encoding>);
+    STATIC_REQUIRE(std::is_same_v<Six::Encoding, uint16_t>);
+    STATIC_REQUIRE(std::is_same_v<wordle::spec::EncodingFor<7>, uint16_t>);
+    STATIC_REQUIRE(wordle::spec::Standard::NUM_FEEDBACKS == NUM_FEEDBACKS);
+    STATIC_REQUIRE(__impl::encodeAsCorrect<Six>() == Six::NUM_FEEDBACKS - 1);
+    STATIC_REQUIRE(__impl::encodeAsCorrect() == __impl::encodeAsCorrect<wordle::spec::Standard>());
+    REQUIRE(__impl::encodeFeedbackString<Six>("XXXXXX") == __impl::encodeAsCorrect<Six>());
+    REQUIRE(__impl::decodeFeedbackString<Six>(__impl::encodeFeedbackString<Six>("_xX_xX")) == "_xX_xX");
+    REQUIRE_FALSE(isValidFeedbackString<Six>("XXXXX"));
+
+    // Only the standard spec is instantiated
+    const auto length = wordle::spec::dispatchWordLength(wordle::config::WORD_LENGTH, [](auto spec) { return decltype(spec)::type::WORD_LENGTH; });
+    REQUIRE(length == wordle::config::WORD_LENGTH);
+    REQUIRE_THROWS_AS(wordle::spec::dispatchWordLength(6, [](auto spec) { return decltype(spec)::type::WORD_LENGTH; }), std::invalid_argument);
+}
+
+TEST_CASE("Feedback: the scalar encoder follows the rules for every word length", "[feedback]") {
+    // Position by position, straight from the rules
+    auto reference = [](std::string_view guess, std::string_view solution) {
+        std::array<size_t, wordle::config::ALPHABET_SIZE> unmatched{};
+        for (size_t i = 0; i < guess.size(); ++i) unmatched[solution[i] - 'a'] += guess[i] != solution[i];
+
+        size_t encoding = 0;
+        size_t multiplier = 1;
+        for (size_t i = 0; i < guess.size(); ++i, multiplier *= __impl::BASE) {
+            if (guess[i] == solution[i]) {
+                encoding += __impl::CORRECT * multiplier;
+            } else if (unmatched[guess[i] - 'a'] > 0) {
+                --unmatched[guess[i] - 'a'];
+                encoding += __impl::WRONG_POSITION * multiplier;
+            }
+        }
+        return encoding;
+    };
+
+    // Few distinct letters, so repeats are common
+    auto mismatches = [&reference]<typename Spec>(std::type_identity<Spec>) {
+        std::mt19937 rng{static_cast<uint32_t>(Spec::WORD_LENGTH)};
+        std::uniform_int_distribution<int> letter{'a', 'e'};
+        typename Spec::Vocab words;
+        for (size_t w = 0; w < 100; ++w) {
+            std::string word(Spec::WORD_LENGTH, 'a');
+            for (char& c : word) c = static_cast<char>(letter(rng));
+            words.push_back(word);
+        }
+
+        BasicEncoder<Spec> scalar{};
+        size_t count = 0;
+        for (std::string_view guess : words) {
+            for (std::string_view solution : words) count += scalar(guess, solution) != reference(guess, solution);
+        }
+        return count;
+    };
+    REQUIRE(mismatches(std::type_identity<wordle::spec::GameSpec<4, 1, 1>>{}) == 0);
+    REQUIRE(mismatches(std::type_identity<wordle::spec::Standard>{}) == 0);
+    REQUIRE(mismatches(std::type_identity<wordle::spec::GameSpec<6, 1, 1>>{}) == 0);
+    REQUIRE(mismatches(std::type_identity<wordle::spec::GameSpec<7, 1, 1>>{}) == 0);
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../src/feedbackCache.hpp"
+#include "../src/parallelTaskQueue.hpp"
+#include "../src/vocab.hpp"
+
+using namespace wordle::feedback;
+
+namespace {
+    bool matchesFlatMap(const FeedbackMatrix& matrix, const FlatFeedbackMap& flatMap) {
+        for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+            auto row = matrix[guessIndex];
+            if (!std::equal(row.begin(), row.end(), flatMap.begin() + guessIndex * FLAT_STRIDE)) return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Feedback Cache: vocabChecksum() detects changed vocab", "[feedback][cache]") {
+    const auto vocab = wordle::vocab::constructVocab();
+    auto swapped = vocab;
+    swapped.swap(0, 1);
+
+    REQUIRE(cache::vocabChecksum(vocab) == cache::vocabChecksum(wordle::vocab::constructVocab()));
+    REQUIRE(cache::vocabChecksum(vocab) != cache::vocabChecksum(swapped));
+}
+
+TEST_CASE("Feedback Cache: write, map and validate", "[feedback][cache][slow]") {
+    constexpr auto path = "test_feedback_cache.bin";
+    wordle::parallel::TaskQueue queue(wordle::config::HARDWARE_CONCURRENCY);
+    const auto vocab = wordle::vocab::constructVocab();
+    const auto flatMap = constructFlatFeedbackMap(vocab, queue, wordle::config::HARDWARE_CONCURRENCY);
+    std::remove(path);
+
+    SECTION("Missing file is rejected") {
+        REQUIRE_FALSE(cache::openFeedbackCache(path, vocab).has_value());
+    }
+
+    SECTION("Round trip is zero-copy and exact") {
+        REQUIRE(cache::writeFeedbackCache(path, vocab, flatMap));
+        auto matrix = cache::openFeedbackCache(path, vocab);
+        REQUIRE(matrix.has_value());
+        REQUIRE(matrix->isMapped());
+        REQUIRE(reinterpret_cast<uintptr_t>(matrix->data()) % wordle::config::CACHE_LINE_SIZE == 0);
+        REQUIRE(matchesFlatMap(*matrix, flatMap));
+    }
+
+    SECTION("Stale vocab is rejected") {
+        REQUIRE(cache::writeFeedbackCache(path, vocab, flatMap));
+        auto swapped = vocab;
+        swapped.swap(0, 1);
+        REQUIRE_FALSE(cache::openFeedbackCache(path, swapped).has_value());
+    }
+
+    SECTION("Truncated file is rejected") {
+        std::ofstream{path, std::ios::binary} << "WRDLFBM";
+        REQUIRE_FALSE(cache::openFeedbackCache(path, vocab).has_value());
+    }
+
+    SECTION("loadFeedbackMatrix() rebuilds and persists a missing cache") {
+        auto matrix = cache::loadFeedbackMatrix(vocab, queue, wordle::config::HARDWARE_CONCURRENCY, path);
+        REQUIRE(matchesFlatMap(matrix, flatMap));
+        REQUIRE(cache::openFeedbackCache(path, vocab).has_value());
+    }
+
+    std::remove(path);
+}
+
+TEST_CASE("Feedback Matrix: flat and nested layouts expose identical rows", "[feedback][matrix][slow]") {
+    wordle::parallel::TaskQueue queue(wordle::config::HARDWARE_CONCURRENCY);
+    const auto vocab = wordle::vocab::constructVocab();
+    const FeedbackMatrix flat{constructFlatFeedbackMap(vocab, queue, wordle::config::HARDWARE_CONCURRENCY)};
+    const FeedbackMatrix nested{constructFeedbackMap(vocab, queue, wordle::config::HARDWARE_CONCURRENCY)};
+
+    REQUIRE(flat.layout() == Layout::FLAT);
+    REQUIRE(nested.layout() == Layout::NESTED);
+    REQUIRE(flat.stride() == FLAT_STRIDE);
+    REQUIRE(nested.stride() == 0);
+
+    const auto flatView = flat.view();
+    const auto nestedView = nested.view();
+    bool identical = true;
+    for (size_t guessIndex = 0; guessIndex < wordle::config::NUM_WORDS; ++guessIndex) {
+        identical = identical && reinterpret_cast<uintptr_t>(flatView.row(guessIndex)) % FeedbackMatrixView::ROW_ALIGNMENT == 0;
+        auto flatRow = flatView[guessIndex];
+        auto nestedRow = nestedView[guessIndex];
+        identical = identical && std::equal(flatRow.begin(), flatRow.end(), nestedRow.begin(), nestedRow.end());
+    }
+    REQUIRE(identical);
+}
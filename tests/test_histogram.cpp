@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <random>
+
+#include "../src/feedback.hpp"
+#include "../src/histogram.hpp"
+
+using namespace wordle::histogram;
+
+TEST_CASE("Histogram: every supported kernel matches a naive count", "[histogram]") {
+    // Random padded row, like one row of the feedback matrix
+    std::mt19937 rng{7};
+    std::vector<wordle::feedback::Encoding> row(wordle::config::NUM_WORDS + wordle::feedback::ROW_PADDING);
+    std::uniform_int_distribution<unsigned> encodingDist(0, wordle::feedback::NUM_FEEDBACKS - 1);
+    for (auto& encoding : row) encoding = static_cast<wordle::feedback::Encoding>(encodingDist(rng));
+
+    // A heavily repeated bin exercises the interleaved sub-histograms
+    std::fill(row.begin(), row.begin() + 200, wordle::feedback::Encoding{5});
+
+    std::vector<WordIndex> indices(wordle::config::NUM_WORDS);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::shuffle(indices.begin(), indices.end(), rng);
+
+    for (Kernel kernel : {Kernel::SCALAR, Kernel::AVX2, Kernel::AVX512}) {
+        if (!isSupported(kernel)) continue;
+        for (size_t n : {0ul, 1ul, 15ul, 16ul, 31ul, 33ul, 200ul, 2315ul, wordle::config::NUM_WORDS}) {
+            BinCounts expected{};
+            for (size_t i = 0; i < n; ++i) ++expected[row[indices[i]]];
+
+            BinCounts actual{};
+            actual.fill(1);  // Kernels must overwrite stale counts
+            countBinsWith(kernel, row.data(), indices.data(), n, actual, row.data());
+            REQUIRE(actual == expected);
+
+            actual.fill(1);
+            countBins(row.data(), indices.data(), n, actual);
+            REQUIRE(actual == expected);
+        }
+    }
+}
+
+TEST_CASE("Histogram: kernel selection", "[histogram]") {
+    REQUIRE(isSupported(Kernel::SCALAR));
+    REQUIRE(isSupported(bestSupportedKernel()));
+    REQUIRE(isSupported(calibrateKernel()));
+
+    const Kernel original = activeKernel();
+    REQUIRE_NOTHROW(setKernel(Kernel::SCALAR));
+    REQUIRE(activeKernel() == Kernel::SCALAR);
+    REQUIRE_NOTHROW(setKernel(original));
+    REQUIRE(activeKernel() == original);
+}
+
+TEST_CASE("Histogram: bin partitions group words by feedback", "[histogram]") {
+    std::mt19937 rng{11};
+    std::vector<wordle::feedback::Encoding> row(wordle::config::NUM_WORDS + wordle::feedback::ROW_PADDING);
+    std::uniform_int_distribution<unsigned> encodingDist(0, wordle::feedback::NUM_FEEDBACKS - 1);
+    for (auto& encoding : row) encoding = static_cast<wordle::feedback::Encoding>(encodingDist(rng));
+
+    std::vector<WordIndex> words(wordle::config::NUM_WORDS);
+    std::iota(words.begin(), words.end(), 0);
+    std::shuffle(words.begin(), words.end(), rng);
+
+    BinPartition partition;
+    for (size_t n : {0ul, 3ul, 300ul, 2315ul, 40ul}) {
+        BinCounts binCounts{};
+        partition.partition(row.data(), words.data(), n, binCounts);
+        REQUIRE(partition.size() == n);
+
+        // Every bin holds its words in input order, and nothing else
+        for (size_t bin = 0; bin < wordle::feedback::NUM_FEEDBACKS; ++bin) {
+            std::vector<WordIndex> expected;
+            for (size_t i = 0; i < n; ++i) if (row[words[i]] == bin) expected.push_back(words[i]);
+
+            const auto actual = partition.bin(bin);
+            REQUIRE(partition.binSize(bin) == binCounts[bin]);
+            REQUIRE(std::vector<WordIndex>(actual.begin(), actual.end()) == expected);
+        }
+    }
+
+    // Smaller inputs reuse the buffer sized by the largest one
+    REQUIRE(partition.capacity() == 2315);
+}
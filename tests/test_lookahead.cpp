@@ -0,0 +1,210 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <numeric>
+
+#include "../src/easyBot.hpp"
+#include "../src/hardBot.hpp"
+#include "../src/lookahead.hpp"
+
+using namespace wordle;
+
+namespace {
+    // Plays toward solutionIndex for a few guesses to reach a mid-game state
+    template <typename Bot>
+    void advance(Bot& bot, size_t solutionIndex, size_t guesses) {
+        bot.reset();
+        const auto& fMapSlice = bot.getFMap()[solutionIndex];
+        for (size_t g = 0; g < guesses; ++g) {
+            const auto suggestion = bot.suggest();
+            if (suggestion.guessIndex == solutionIndex) return;
+            bot.filter(suggestion.guessIndex, fMapSlice[suggestion.guessIndex]);
+        }
+    }
+}
+
+TEST_CASE("Lookahead: plans", "[lookahead]") {
+    const auto standard = lookahead::Plan::standard(8);
+    REQUIRE(standard.depth == 2);
+    REQUIRE(standard.widths[2] == 8);
+    REQUIRE(standard.isStandard(8));
+    REQUIRE_FALSE(standard.isStandard(4));
+    REQUIRE_FALSE(lookahead::Plan::ofDepth(3, 8).isStandard(8));
+    REQUIRE(standard.salt() != lookahead::Plan::ofDepth(3, 8).salt());
+
+    REQUIRE_NOTHROW(lookahead::validate(lookahead::Plan::ofDepth(1, 8)));
+    REQUIRE_NOTHROW(lookahead::validate(lookahead::Plan::ofDepth(lookahead::MAX_DEPTH, 8)));
+    REQUIRE_THROWS_AS(lookahead::validate(lookahead::Plan::ofDepth(0, 8)), std::invalid_argument);
+    REQUIRE_THROWS_AS(lookahead::validate(lookahead::Plan::ofDepth(lookahead::MAX_DEPTH + 1, 8)), std::invalid_argument);
+    REQUIRE_THROWS_AS(lookahead::validate(lookahead::Plan::ofDepth(2, 0)), std::invalid_argument);
+
+    // Deeper searches can't expect more than the log2 of the words left
+    REQUIRE(entropy::entropyBound(1000, 1) < entropy::entropyBound(1000, 2));
+    REQUIRE(entropy::entropyBound(1000, 2) == entropy::entropyBound(1000, 3));
+}
+
+TEST_CASE("Lookahead: depth 2 engine is HardBot's built-in search", "[lookahead][slow]") {
+    bot::HardBot bot{1, 8};
+    parallel::TaskQueue queue{1};
+    const auto plan = lookahead::Plan::standard(8);
+
+    for (size_t solutionIndex : {7ul, 900ul, 2000ul}) {
+        advance(bot, solutionIndex, 1);
+        if (bot.getAliveTargets().size() <= 2) continue;
+
+        lookahead::PruneStats stats{};
+        const auto expected = bot.suggest();
+        const auto actual = lookahead::Engine<true>{bot.getFMap(), plan, true}.search(bot.getAliveTargets(), bot.getAliveFillers(), queue, stats);
+        REQUIRE(actual.guessIndex == expected.guessIndex);
+        REQUIRE(actual.value == expected.entropy);
+    }
+}
+
+TEST_CASE("Lookahead: depth 2 engine is EasyBot's built-in search", "[lookahead][slow]") {
+    bot::EasyBot bot{4, 4};
+    parallel::TaskQueue queue{1};
+    const auto plan = lookahead::Plan::standard(4);
+    const size_t opening = 0;  // Fixed first guess, so no full first search is needed
+
+    for (size_t solutionIndex : {7ul, 900ul, 2000ul}) {
+        bot.reset();
+        bot.filter(opening, bot.getFMap()[solutionIndex][opening]);
+        if (bot.getAliveTargets().size() <= 2) continue;
+
+        lookahead::PruneStats stats{};
+        const auto expected = bot.suggest();
+        const auto actual = lookahead::Engine<false>{bot.getFMap(), plan, true}.search(bot.getAliveTargets(), {}, queue, stats);
+        REQUIRE(actual.guessIndex == expected.guessIndex);
+        REQUIRE(actual.value == expected.entropy);
+    }
+}
+
+TEST_CASE("Lookahead: EasyBot's beam narrows to the alive targets", "[lookahead][slow]") {
+    constexpr size_t beam = 16;
+    bot::EasyBot bot{1, beam};
+    parallel::TaskQueue queue{1};
+    const auto plan = lookahead::Plan::standard(beam);
+
+    // Two fixed guesses leave fewer targets than the beam, so both searches expand only n candidates
+    size_t checked = 0;
+    for (size_t solutionIndex = 0; solutionIndex < config::NUM_TARGETS && checked < 4; ++solutionIndex) {
+        bot.reset();
+        for (size_t guessIndex : {0ul, 1ul}) bot.filter(guessIndex, bot.getFMap()[solutionIndex][guessIndex]);
+        const size_t n = bot.getAliveTargets().size();
+        if (n < 3 || n >= beam) continue;
+
+        lookahead::PruneStats stats{};
+        const auto expected = bot.suggest();
+        const auto actual = lookahead::Engine<false>{bot.getFMap(), plan, true}.search(bot.getAliveTargets(), {}, queue, stats);
+        REQUIRE(actual.guessIndex == expected.guessIndex);
+        REQUIRE(actual.value == expected.entropy);
+        ++checked;
+    }
+    REQUIRE(checked == 4);
+    REQUIRE(bot.getPruneStats().candidates < 4 * beam);
+}
+
+TEST_CASE("Lookahead: EasyBot's beam is independent of its thread count", "[lookahead][slow]") {
+    bot::EasyBot single{1, 8};
+    bot::EasyBot few{single.getContext(), 3, 8};
+    parallel::TaskQueue queue{1};
+    const auto plan = lookahead::Plan::standard(8);
+    const size_t opening = 0;
+
+    for (size_t solutionIndex : {42ul, 1500ul}) {
+        for (auto* bot : {&single, &few}) {
+            bot->reset();
+            bot->filter(opening, bot->getFMap()[solutionIndex][opening]);
+        }
+
+        lookahead::PruneStats stats{};
+        const auto expected = lookahead::Engine<false>{single.getFMap(), plan, true}.search(single.getAliveTargets(), {}, queue, stats);
+        const auto fromSingle = single.suggest();
+        const auto fromFew = few.suggest();
+        REQUIRE(fromSingle.guessIndex == expected.guessIndex);
+        REQUIRE(fromSingle.entropy == expected.value);
+        REQUIRE(fromFew.guessIndex == expected.guessIndex);
+        REQUIRE(fromFew.entropy == expected.value);
+    }
+    REQUIRE(single.getPruneStats().candidates == 16);
+}
+
+TEST_CASE("Lookahead: HardBot's handoff is independent of its thread count", "[lookahead][slow]") {
+    bot::HardBot single{1, 8};
+    bot::HardBot few{single.getContext(), 3, 8};
+    parallel::TaskQueue queue{1};
+    const auto plan = lookahead::Plan::standard(8);
+
+    for (size_t solutionIndex : {7ul, 900ul, 2000ul}) {
+        advance(single, solutionIndex, 1);
+        advance(few, solutionIndex, 1);
+        if (single.getAliveTargets().size() <= 2) continue;
+
+        lookahead::PruneStats stats{};
+        const auto expected = lookahead::Engine<true>{single.getFMap(), plan, true}.search(single.getAliveTargets(), single.getAliveFillers(), queue, stats);
+        const auto fromSingle = single.suggest();
+        const auto fromFew = few.suggest();
+        REQUIRE(fromSingle.guessIndex == expected.guessIndex);
+        REQUIRE(fromSingle.entropy == expected.value);
+        REQUIRE(fromFew.guessIndex == expected.guessIndex);
+        REQUIRE(fromFew.entropy == expected.value);
+    }
+}
+
+TEST_CASE("Lookahead: deeper searches are exact under pruning", "[lookahead][slow]") {
+    bot::HardBot pruned{1, 4};
+    bot::HardBot exhaustive{pruned.getContext(), 1, 4};
+    pruned.setLookahead(lookahead::Plan::ofDepth(3, 4));
+    exhaustive.setLookahead(lookahead::Plan::ofDepth(3, 4));
+    exhaustive.setPruning(false);
+
+    advance(pruned, 321, 1);
+    advance(exhaustive, 321, 1);
+    REQUIRE(pruned.getAliveTargets().size() > 2);
+    const auto expected = exhaustive.suggest();
+    const auto actual = pruned.suggest();
+    REQUIRE(actual.isValid);
+    REQUIRE(actual.guessIndex == expected.guessIndex);
+    REQUIRE(actual.entropy == expected.entropy);
+
+    // Three guesses can't expect more information than there is left
+    REQUIRE(actual.entropy <= entropy::entropyBound(pruned.getAliveTargets().size(), 3));
+}
+
+TEST_CASE("Lookahead: depth 1 picks the best single guess", "[lookahead][slow]") {
+    bot::HardBot bot{1, 4};
+    advance(bot, 55, 1);
+    const auto targets = bot.getAliveTargets();
+    REQUIRE(targets.size() > 2);
+    bot.setLookahead(lookahead::Plan::ofDepth(1, 4));
+    const auto suggestion = bot.suggest();
+
+    // Same as scanning every alive word by hand
+    entropy::SparseHistogram histogram;
+    double best = std::numeric_limits<double>::min();
+    for (auto words : {bot.getAliveTargets(), bot.getAliveFillers()}) {
+        for (auto guessIndex : words) {
+            histogram.count(bot.getFMap().row(guessIndex), targets.begin(), targets.end());
+            best = std::max(best, histogram.exactEntropy(targets.size()));
+        }
+    }
+    REQUIRE(suggestion.entropy == best);
+}
+
+TEST_CASE("Lookahead: plans other than the standard one own their cache entries", "[lookahead][slow]") {
+    bot::HardBot bot{1, 4};
+    auto cache = std::make_shared<cache::SuggestionCache>();
+    bot.useSuggestionCache(cache);
+    advance(bot, 1500, 1);
+    const auto standard = bot.suggest();
+    REQUIRE(cache->hits() == 0);
+
+    bot.setLookahead(lookahead::Plan::ofDepth(1, 4));
+    const auto shallow = bot.suggest();
+    REQUIRE(cache->hits() == 0);
+    REQUIRE(shallow.entropy <= standard.entropy);
+
+    bot.setLookahead(lookahead::Plan::standard(4));
+    REQUIRE(bot.suggest().guessIndex == standard.guessIndex);
+    REQUIRE(cache->hits() == 1);
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+#include "../src/hardBot.hpp"
+#include "../src/openingBook.hpp"
+
+using namespace wordle;
+
+namespace {
+    // Plays solutionIndex to the end and returns every suggestion made
+    std::vector<bot::Suggestion> play(bot::HardBot& bot, size_t solutionIndex) {
+        std::vector<bot::Suggestion> suggestions;
+        bot.reset();
+        const auto& fMapSlice = bot.getFMap()[solutionIndex];
+        for (auto suggestion = bot.suggest(); suggestion.isValid && suggestions.size() < 10; suggestion = bot.suggest()) {
+            suggestions.push_back(suggestion);
+            if (suggestion.guessIndex == solutionIndex) break;
+            bot.filter(suggestion.guessIndex, fMapSlice[suggestion.guessIndex]);
+        }
+        return suggestions;
+    }
+}
+
+TEST_CASE("Opening Book: book answers match live search", "[book][slow]") {
+    constexpr auto path = "test_opening_book.bin";
+    bot::HardBot bot{};
+    std::remove(path);
+
+    const auto built = book::Builder<bot::HardBot>{bot, 2}.build();
+    REQUIRE(built.size() > 1);
+    REQUIRE(static_cast<size_t>(built[book::ROOT].numChildren) + 1 == built.size());
+    REQUIRE(built.matches(book::Mode::HARD, bot.getBeamCandidates(), bot.getVocab()));
+    REQUIRE_FALSE(built.matches(book::Mode::EASY, bot.getBeamCandidates(), bot.getVocab()));
+
+    SECTION("Round trip") {
+        REQUIRE(book::writeOpeningBook(path, built));
+        const auto loaded = book::readOpeningBook(path, bot.getVocab());
+        REQUIRE(loaded.has_value());
+        REQUIRE(loaded->size() == built.size());
+        REQUIRE(loaded->maxDepth() == 2);
+        for (uint32_t node = 0; node < built.size(); ++node) {
+            REQUIRE((*loaded)[node].guess == built[node].guess);
+            REQUIRE((*loaded)[node].entropy == built[node].entropy);
+        }
+    }
+
+    SECTION("Truncated and foreign files are rejected") {
+        REQUIRE(book::writeOpeningBook(path, built));
+        std::ofstream{path, std::ios::binary | std::ios::app} << 'x';
+        REQUIRE_FALSE(book::readOpeningBook(path, bot.getVocab()).has_value());
+
+        std::ofstream{path, std::ios::binary} << "WRDLBOOK";
+        REQUIRE_FALSE(book::readOpeningBook(path, bot.getVocab()).has_value());
+    }
+
+    SECTION("Edges that wrap past the end are rejected") {
+        REQUIRE(book::writeOpeningBook(path, built));
+        book::Node root = built[book::ROOT];
+        root.firstChild = 0xFFFFFFFF;
+        root.numChildren = 1;
+        {
+            std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+            file.seekp(sizeof(book::Header));
+            file.write(reinterpret_cast<const char*>(&root), sizeof(root));
+        }
+        REQUIRE(book::readOpeningBook(path, bot.getVocab()) == std::nullopt);
+    }
+
+    SECTION("Games on and off the book play identically") {
+        std::vector<std::vector<bot::Suggestion>> live;
+        for (size_t solutionIndex : {0ul, 1000ul, 2314ul}) live.push_back(play(bot, solutionIndex));
+
+        bot.useOpeningBook(std::make_shared<const book::OpeningBook>(built));
+        size_t game = 0;
+        for (size_t solutionIndex : {0ul, 1000ul, 2314ul}) {
+            const auto booked = play(bot, solutionIndex);
+            REQUIRE(booked.size() == live[game].size());
+            for (size_t i = 0; i < booked.size(); ++i) {
+                REQUIRE(booked[i].guessIndex == live[game][i].guessIndex);
+                REQUIRE(booked[i].entropy == live[game][i].entropy);
+            }
+            ++game;
+        }
+        bot.useOpeningBook(nullptr);
+    }
+
+    std::remove(path);
+}
@@ -81,4 +81,59 @@ TEST_CASE("Parallel Task Queue: pushFor() works with extreme thread contention",
     queue.wait();
     REQUIRE(numThreadsRan == expectedThreadsRan);
     REQUIRE(counter == expectedCounterValue);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Parallel Task Queue: wait() can be reused across many fork/join rounds", "[parallelTaskQueue][parallel]") {
+    wordle::parallel::TaskQueue queue(wordle::config::HARDWARE_CONCURRENCY);
+    std::atomic<size_t> x = 0;
+
+    constexpr size_t rounds = 1000;
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < queue.capacity(); ++i) {
+            queue.push([&x]() { x.fetch_add(1); });
+        }
+        queue.wait();
+        REQUIRE(queue.size() == 0);
+    }
+    REQUIRE(x == rounds * queue.capacity());
+}
+
+TEST_CASE("Parallel Task Queue: tasks pushed from workers are stolen and joined", "[parallelTaskQueue][parallel]") {
+    wordle::parallel::TaskQueue outer(wordle::config::HARDWARE_CONCURRENCY);
+    std::atomic<size_t> leaves = 0;
+    constexpr size_t fanOut = 64;
+
+    for (size_t i = 0; i < outer.capacity(); ++i) {
+        outer.push([&outer, &leaves]() {
+            // Nested scope on the same pool; its tasks land on this worker's deque
+            wordle::parallel::TaskQueue inner(outer.threadPool());
+            for (size_t j = 0; j < fanOut; ++j) {
+                inner.push([&leaves]() { leaves.fetch_add(1); });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    REQUIRE(leaves == fanOut * outer.capacity());
+}
+
+TEST_CASE("Parallel Task Queue: queues sharing a pool wait independently", "[parallelTaskQueue][parallel]") {
+    auto pool = std::make_shared<wordle::parallel::ThreadPool>(wordle::config::HARDWARE_CONCURRENCY);
+    wordle::parallel::TaskQueue slow(pool);
+    wordle::parallel::TaskQueue fast(pool);
+    std::atomic_bool release = false;
+    std::atomic<size_t> fastDone = 0;
+
+    slow.push([&release]() { while (!release.load()) std::this_thread::yield(); });
+    for (size_t i = 0; i < 16; ++i) {
+        fast.push([&fastDone]() { fastDone.fetch_add(1); });
+    }
+    fast.wait();
+    REQUIRE(fastDone == 16);
+    REQUIRE(slow.size() == 1);
+
+    release.store(true);
+    slow.wait();
+    REQUIRE(slow.size() == 0);
+    REQUIRE(slow.capacity() == fast.capacity());
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "../src/hardBot.hpp"
+#include "../src/profile.hpp"
+
+using namespace wordle;
+
+TEST_CASE("Profile: scopes add up per phase across threads", "[profile]") {
+    profile::reset();
+    {
+        const profile::Scope scope{profile::Phase::FIRST_PASS};
+    }
+    std::thread worker([] {
+        for (size_t i = 0; i < 3; ++i) const profile::Scope scope{profile::Phase::FIRST_PASS};
+        const profile::Scope scope{profile::Phase::BIN_ENTROPY};
+    });
+    worker.join();
+
+    // Totals of the finished thread are kept
+    const auto report = profile::report();
+    REQUIRE(report[profile::Phase::FIRST_PASS].calls == 4);
+    REQUIRE(report[profile::Phase::BIN_ENTROPY].calls == 1);
+    REQUIRE(report[profile::Phase::BARRIER].calls == 0);
+    REQUIRE(report.threads >= 2);
+
+    const auto table = report.format();
+    REQUIRE(table.find("first pass") != std::string::npos);
+    REQUIRE(table.find("barrier") == std::string::npos);
+
+    profile::reset();
+    REQUIRE(profile::report()[profile::Phase::FIRST_PASS].calls == 0);
+}
+
+TEST_CASE("Profile: hardware counters are optional", "[profile]") {
+    profile::reset();
+    const bool hasCounters = profile::useHardwareCounters(true);
+    {
+        const profile::Scope scope{profile::Phase::SEARCH};
+    }
+    profile::useHardwareCounters(false);
+
+    const auto report = profile::report();
+    REQUIRE(report[profile::Phase::SEARCH].calls == 1);
+    REQUIRE(report.hasCounters == hasCounters);
+    if (hasCounters) REQUIRE(report[profile::Phase::SEARCH].counters[static_cast<size_t>(profile::Counter::CYCLES)] > 0);
+    profile::reset();
+}
+
+TEST_CASE("Profile: suggest() enters every phase when compiled in", "[profile][slow]") {
+    bot::HardBot bot{engine::Context::shared(), 2, 4};
+    const size_t guessIndex = 0;
+    bot.filter(guessIndex, bot.getFMap()[100][guessIndex]);
+
+    profile::reset();
+    bot.suggest();
+    const auto report = profile::report();
+
+    for (size_t phase = 0; phase < profile::NUM_PHASES; ++phase) {
+        if constexpr (profile::ENABLED) {
+            REQUIRE(report.phases[phase].calls > 0);
+        } else {
+            REQUIRE(report.phases[phase].calls == 0);
+        }
+    }
+}
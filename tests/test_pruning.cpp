@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/easyBot.hpp"
+#include "../src/hardBot.hpp"
+
+using namespace wordle;
+
+namespace {
+    // Plays solutionIndex with a pruning and an exhaustive bot side by side, comparing every suggestion
+    template <typename Bot>
+    void requireSameGame(Bot& pruned, Bot& exhaustive, size_t solutionIndex) {
+        pruned.reset();
+        exhaustive.reset();
+        const auto& fMapSlice = pruned.getFMap()[solutionIndex];
+        for (size_t turn = 0; turn < 6; ++turn) {
+            const auto expected = exhaustive.suggest();
+            const auto actual = pruned.suggest();
+            REQUIRE(actual.isValid == expected.isValid);
+            REQUIRE(actual.guessIndex == expected.guessIndex);
+            REQUIRE(actual.entropy == expected.entropy);
+            if (!expected.isValid || expected.guessIndex == solutionIndex) return;
+            pruned.filter(expected.guessIndex, fMapSlice[expected.guessIndex]);
+            exhaustive.filter(expected.guessIndex, fMapSlice[expected.guessIndex]);
+        }
+    }
+}
+
+TEST_CASE("Pruning: entropy bounds", "[prune]") {
+    REQUIRE(entropy::entropyBound(0) == 0.0);
+    REQUIRE(entropy::entropyBound(1) == 0.0);
+    REQUIRE(entropy::entropyBound(2) > 1.0);
+    REQUIRE(entropy::entropyBound(feedback::NUM_FEEDBACKS) == entropy::entropyBound(config::NUM_TARGETS));
+
+    // All singletons saturate; anything else doesn't
+    entropy::SparseHistogram histogram;
+    entropy::EntropyMaximizer best{4};
+    histogram.add(3, 2);
+    histogram.add(7, 2);
+    best.consider(histogram);
+    REQUIRE_FALSE(best.isSaturated());
+    histogram.clear();
+    for (feedback::Encoding bin : {1, 5, 9, 20}) histogram.add(bin, 1);
+    best.consider(histogram);
+    REQUIRE(best.isSaturated());
+    REQUIRE(best.value() <= entropy::entropyBound(4));
+}
+
+TEST_CASE("Pruning: HardBot suggests exactly what the exhaustive search does", "[prune][slow]") {
+    bot::HardBot pruned{1, 8};
+    bot::HardBot exhaustive{pruned.getContext(), 1, 8};
+    exhaustive.setPruning(false);
+
+    for (size_t solutionIndex : {0ul, 500ul, 1234ul, config::NUM_TARGETS - 1}) requireSameGame(pruned, exhaustive, solutionIndex);
+
+    const auto stats = pruned.getPruneStats();
+    REQUIRE(stats.candidates > 0);
+    REQUIRE(stats.candidatesPruned > 0);
+    REQUIRE(stats.binScansCut > 0);
+    REQUIRE(exhaustive.getPruneStats().candidatesPruned == 0);
+    REQUIRE(exhaustive.getPruneStats().binScansCut == 0);
+}
+
+TEST_CASE("Pruning: EasyBot suggests exactly what the exhaustive search does", "[prune][slow]") {
+    bot::EasyBot pruned{2, 2};
+    bot::EasyBot exhaustive{pruned.getContext(), 2, 2};
+    exhaustive.setPruning(false);
+
+    // Skip the opening search, which takes seconds per bot
+    const auto& fMapSlice = pruned.getFMap()[42];
+    pruned.filter(0, fMapSlice[0]);
+    exhaustive.filter(0, fMapSlice[0]);
+    const auto expected = exhaustive.suggest();
+    const auto actual = pruned.suggest();
+    REQUIRE(actual.guessIndex == expected.guessIndex);
+    REQUIRE(actual.entropy == expected.entropy);
+    REQUIRE(pruned.getPruneStats().candidates == 2);
+}
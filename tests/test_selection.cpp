@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../src/selection.hpp"
+
+using namespace wordle::selection;
+using wordle::histogram::WordIndex;
+
+TEST_CASE("Selection: merged per-worker lists match a full sort", "[selection]") {
+    // Few distinct values, so ties between workers are common
+    std::mt19937 rng{11};
+    std::uniform_int_distribution<int> valueDist(0, 40);
+    std::vector<double> values(3000);
+    for (auto& value : values) value = valueDist(rng) / 8.0;
+
+    std::vector<WordIndex> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](WordIndex i, WordIndex j) { return isBetter({values[i], i}, {values[j], j}); });
+
+    for (size_t numLists : {1ul, 3ul, 8ul}) {
+        for (size_t k : {0ul, 1ul, 16ul, 200ul}) {
+            // Contiguous slices, like the bots' split of the guesses
+            std::vector<TopK> lists(numLists);
+            for (size_t t = 0; t < numLists; ++t) {
+                lists[t].reset(k);
+                for (size_t i = values.size() * t / numLists; i < values.size() * (t + 1) / numLists; ++i) lists[t].offer(values[i], i);
+                lists[t].finish();
+                REQUIRE(lists[t].sorted().size() == std::min(k, values.size() / numLists));
+            }
+
+            std::vector<WordIndex> merged(k);
+            REQUIRE(merge(lists, merged) == k);
+            REQUIRE(std::equal(merged.begin(), merged.end(), order.begin()));
+        }
+    }
+}
+
+TEST_CASE("Selection: unfinished lists are left out of the merge", "[selection]") {
+    std::vector<TopK> lists(2);
+    lists[0].reset(2);
+    lists[1].reset(2);
+    lists[0].offer(1.0, 4);
+    lists[0].offer(3.0, 5);
+    lists[0].offer(2.0, 6);
+    lists[1].offer(9.0, 7);
+    lists[0].finish();
+    REQUIRE(!lists[1].isFinished());
+
+    std::vector<WordIndex> visited;
+    visitMerged(std::span<const TopK>{lists}, 4, [&](const Entry& entry) {
+        visited.push_back(entry.index);
+        return true;
+    });
+    REQUIRE(visited == std::vector<WordIndex>{5, 6});
+
+    // Visits stop once visit returns false, and a reset list is reused
+    lists[1].finish();
+    visited.clear();
+    visitMerged(std::span<const TopK>{lists}, 4, [&](const Entry& entry) {
+        visited.push_back(entry.index);
+        return visited.size() < 2;
+    });
+    REQUIRE(visited == std::vector<WordIndex>{7, 5});
+
+    lists[0].reset(1);
+    lists[0].offer(0.5, 1);
+    lists[0].offer(0.5, 0);
+    lists[0].finish();
+    REQUIRE(lists[0].sorted().size() == 1);
+    REQUIRE(lists[0].sorted()[0].index == 0);
+}
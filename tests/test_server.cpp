@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <format>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../src/hardBot.hpp"
+#include "../src/server.hpp"
+
+using namespace wordle;
+
+namespace {
+    // Response without its " us=<latency>" suffix
+    std::string body(const std::string& response) {
+        return response.substr(0, response.rfind(" us="));
+    }
+
+    std::string openSession(server::Server& solver, std::string_view mode) {
+        const auto response = body(solver.handle(std::format("new {}", mode)));
+        REQUIRE(response.starts_with("ok "));
+        return response.substr(3);
+    }
+}
+
+TEST_CASE("Server: latency histogram percentiles", "[server]") {
+    server::LatencyHistogram latencies;
+    REQUIRE(latencies.percentile(50) == 0);
+
+    for (uint64_t micros = 1; micros <= 100; ++micros) latencies.record(micros);
+    REQUIRE(latencies.count() == 100);
+    REQUIRE(latencies.max() == 100);
+    REQUIRE(latencies.percentile(50) >= 50);
+    REQUIRE(latencies.percentile(50) < 64);
+    REQUIRE(latencies.percentile(99) >= 99);
+}
+
+TEST_CASE("Server: requests and errors", "[server][slow]") {
+    server::Server solver{{2, 64}};
+    const auto id = openSession(solver, "hard");
+    REQUIRE(solver.numSessions() == 1);
+
+    // Every response reports its latency
+    const auto suggestion = solver.handle("suggest " + id);
+    REQUIRE(suggestion.starts_with("ok "));
+    REQUIRE(suggestion.find(" us=") != std::string::npos);
+
+    REQUIRE(body(solver.handle("filter " + id + " slate bbbbb")) == "err invalid feedback");
+    REQUIRE(body(solver.handle("filter " + id + " zzzzz _____")) == "err invalid guess");
+    REQUIRE(body(solver.handle("filter " + id + " slate")) == "err wrong number of arguments");
+    REQUIRE(body(solver.handle("suggest 999999")) == "err unknown session");
+    REQUIRE(body(solver.handle("suggest abc")) == "err invalid session");
+    REQUIRE(body(solver.handle("new medium")) == "err expected: new <hard|easy>");
+    REQUIRE(body(solver.handle("guess")) == "err unknown command");
+
+    const auto filtered = body(solver.handle("filter " + id + " slate _____"));
+    REQUIRE(filtered.starts_with("ok "));
+    REQUIRE(std::stoul(filtered.substr(3)) < config::NUM_TARGETS);
+    REQUIRE(body(solver.handle("reset " + id)) == "ok");
+    REQUIRE(body(solver.handle("suggest " + id)) == body(suggestion));
+
+    REQUIRE(body(solver.handle("close " + id)) == "ok");
+    REQUIRE(body(solver.handle("suggest " + id)) == "err unknown session");
+    REQUIRE(solver.numSessions() == 0);
+    REQUIRE(body(solver.handle("stats")).starts_with("ok sessions=0 requests="));
+}
+
+TEST_CASE("Server: interleaved sessions play as their own bots", "[server][slow]") {
+    server::Server solver{{2, 64}};
+    const auto context = engine::Context::shared();
+    const auto& fMap = context->view();
+    const std::vector<size_t> solutions{0, 1, 2, 3};
+
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < solutions.size(); ++i) ids.push_back(openSession(solver, "hard"));
+
+    // Play all games in lockstep through batches, sessions sharing two pooled bots
+    std::vector<std::vector<std::string>> played(solutions.size());
+    std::vector<bool> isOver(solutions.size(), false);
+    for (size_t round = 0; round < 10; ++round) {
+        std::vector<std::string> requests;
+        for (size_t i = 0; i < solutions.size(); ++i) if (!isOver[i]) requests.push_back("suggest " + ids[i]);
+        if (requests.empty()) break;
+        const auto suggestions = solver.handleBatch(requests);
+
+        requests.clear();
+        for (size_t i = 0, next = 0; i < solutions.size(); ++i) {
+            if (isOver[i]) continue;
+            const auto response = body(suggestions[next++]);
+            REQUIRE(response.starts_with("ok "));
+            const auto guess = response.substr(3, config::WORD_LENGTH);
+            played[i].push_back(guess);
+
+            const auto guessIndex = std::find(context->vocab().begin(), context->vocab().end(), guess) - context->vocab().begin();
+            if (static_cast<size_t>(guessIndex) == solutions[i]) {
+                isOver[i] = true;
+                continue;
+            }
+            const auto fbString = feedback::decodeFeedbackString(fMap[solutions[i]][guessIndex]);
+            requests.push_back(std::format("filter {} {} {}", ids[i], guess, fbString));
+        }
+        for (const auto& response : solver.handleBatch(requests)) REQUIRE(response.starts_with("ok "));
+    }
+
+    // Each game matches one played by a dedicated bot
+    bot::HardBot direct{context, 1};
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        REQUIRE(isOver[i]);
+        direct.reset();
+        for (const auto& guess : played[i]) {
+            const auto suggestion = direct.suggest();
+            REQUIRE(suggestion.guess == guess);
+            direct.filter(suggestion.guessIndex, fMap[solutions[i]][suggestion.guessIndex]);
+        }
+    }
+}
+
+TEST_CASE("Server: streams answer in request order", "[server][slow]") {
+    server::Server solver{{2, 64}};
+    int requestPipe[2];
+    int responsePipe[2];
+    REQUIRE(::pipe(requestPipe) == 0);
+    REQUIRE(::pipe(responsePipe) == 0);
+
+    const std::string requests = "new easy\nnew hard\n\nsuggest 1\nfilter 2 slate _____\nbogus\nstats";
+    REQUIRE(::write(requestPipe[1], requests.data(), requests.size()) == static_cast<ssize_t>(requests.size()));
+    ::close(requestPipe[1]);
+
+    server::serveStream(solver, requestPipe[0], responsePipe[1]);
+    ::close(requestPipe[0]);
+    ::close(responsePipe[1]);
+
+    std::string output;
+    char chunk[4096];
+    for (ssize_t n; (n = ::read(responsePipe[0], chunk, sizeof(chunk))) > 0;) output.append(chunk, static_cast<size_t>(n));
+    ::close(responsePipe[0]);
+
+    std::vector<std::string> lines;
+    for (size_t start = 0, newline; (newline = output.find('\n', start)) != std::string::npos; start = newline + 1) {
+        lines.push_back(body(output.substr(start, newline - start)));
+    }
+    REQUIRE(lines.size() == 6);
+    REQUIRE(lines[0] == "ok 1");
+    REQUIRE(lines[1] == "ok 2");
+    REQUIRE(lines[2].starts_with("ok "));
+    REQUIRE(lines[3].starts_with("ok "));
+    REQUIRE(lines[4] == "err unknown command");
+    REQUIRE(lines[5].starts_with("ok sessions=2"));
+}
+
+TEST_CASE("Server: a slow session doesn't hold up the others", "[server][slow]") {
+    server::Server solver{{2, 64}};
+    const auto slowId = openSession(solver, "easy");
+    const auto fastId = openSession(solver, "hard");
+
+    // A cold easy-mode opening search takes seconds, a filter next to nothing
+    auto slow = solver.submit("suggest " + slowId);
+    auto fast = solver.submit(std::format("filter {} slate _____", fastId));
+    REQUIRE(body(fast.get()).starts_with("ok "));
+    REQUIRE(slow.wait_for(std::chrono::seconds{0}) == std::future_status::timeout);
+    REQUIRE(body(slow.get()).starts_with("ok "));
+
+    // Requests of one session still run in order
+    auto filtered = solver.submit(std::format("filter {} slate _____", slowId));
+    auto closed = solver.submit("close " + slowId);
+    auto late = solver.submit("suggest " + slowId);
+    REQUIRE(body(filtered.get()).starts_with("ok "));
+    REQUIRE(body(closed.get()) == "ok");
+    REQUIRE(body(late.get()) == "err unknown session");
+}
@@ -0,0 +1,24 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+#include "../src/easyBot.hpp"
+#include "../src/hardBot.hpp"
+#include "../src/simulation.hpp"
+
+using namespace wordle;
+
+TEST_CASE("Simulation: parallel games match sequential games", "[simulation][slow]") {
+    const auto sequential = simulation::simulate<bot::HardBot>({1, 1}, nullptr, std::make_shared<cache::SuggestionCache>());
+    REQUIRE(sequential.guesses.size() == config::NUM_TARGETS);
+
+    // Games spread over workers, and searches spread over threads within each game
+    for (const simulation::ThreadPlan plan : {simulation::ThreadPlan{4, 1}, simulation::ThreadPlan{2, 3}}) {
+        const auto parallel = simulation::simulate<bot::HardBot>(plan, nullptr, std::make_shared<cache::SuggestionCache>());
+        REQUIRE(parallel.guesses == sequential.guesses);
+        REQUIRE(parallel.plan.gameWorkers == plan.gameWorkers);
+        REQUIRE(parallel.plan.suggestThreads == plan.suggestThreads);
+        REQUIRE(parallel.gamesPerSecond() > 0);
+        REQUIRE(sequential.gamesWon() == parallel.gamesWon());
+    }
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "../src/solver.hpp"
+
+using namespace wordle;
+
+namespace {
+    using Words = std::vector<solver::WordIndex>;
+
+    size_t indexOf(const vocab::Vocab& vocab, std::string_view word) {
+        return std::distance(vocab.begin(), std::find(vocab.begin(), vocab.end(), word));
+    }
+
+    // Words by the feedback they give guess, as games read it
+    std::map<feedback::Encoding, Words> binsOf(const feedback::FeedbackMatrixView& fMap, size_t guessIndex, size_t first, size_t last) {
+        std::map<feedback::Encoding, Words> bins;
+        for (size_t w = first; w < last; ++w) bins[fMap[w][guessIndex]].push_back(static_cast<solver::WordIndex>(w));
+        return bins;
+    }
+
+    // Alive targets and fillers after guessing word, for the first feedback that leaves between min and max targets
+    std::pair<Words, Words> stateAfter(const engine::Context& context, std::string_view word, size_t min, size_t max) {
+        const size_t guessIndex = indexOf(context.vocab(), word);
+        const auto targetBins = binsOf(context.view(), guessIndex, 0, config::NUM_TARGETS);
+        auto fillerBins = binsOf(context.view(), guessIndex, config::NUM_TARGETS, config::NUM_WORDS);
+        for (const auto& [fb, targets] : targetBins) {
+            if (targets.size() >= min && targets.size() <= max) return {targets, fillerBins[fb]};
+        }
+        FAIL("no feedback leaves the requested number of targets");
+        return {};
+    }
+
+    // Every guess, every bin, no memo and no pruning
+    template <bool HardMode>
+    std::optional<solver::Cost> bruteForce(const feedback::FeedbackMatrixView& fMap, const Words& targets, const Words& fillers, uint32_t budget) {
+        const size_t n = targets.size();
+        if (n <= 2) {
+            const auto cost = solver::lowerBound(n);
+            return cost.worstCase <= budget ? std::optional{cost} : std::nullopt;
+        }
+        if (budget <= 1) return std::nullopt;
+
+        Words guesses;
+        if constexpr (HardMode) {
+            guesses = targets;
+            guesses.insert(guesses.end(), fillers.begin(), fillers.end());
+        } else {
+            guesses.resize(config::NUM_WORDS);
+            std::iota(guesses.begin(), guesses.end(), 0);
+        }
+
+        std::optional<solver::Cost> best;
+        for (auto guess : guesses) {
+            std::map<feedback::Encoding, std::pair<Words, Words>> bins;
+            for (auto w : targets) bins[fMap[w][guess]].first.push_back(w);
+            for (auto w : fillers) bins[fMap[w][guess]].second.push_back(w);
+
+            solver::Cost cost{static_cast<uint32_t>(n), 1};
+            bool feasible = true;
+            for (const auto& [fb, bin] : bins) {
+                if (fb == solver::SOLVED || bin.first.empty()) continue;
+                const auto sub = bin.first.size() == n ? std::nullopt : bruteForce<HardMode>(fMap, bin.first, bin.second, budget == solver::UNLIMITED ? budget : budget - 1);
+                if (!sub) {
+                    feasible = false;
+                    break;
+                }
+                cost.addBin(*sub);
+            }
+            if (feasible && (!best || solver::better(cost, *best))) best = cost;
+        }
+        return best;
+    }
+
+    // Plays every target of the state along the recorded strategy, as "stats exact" does
+    solver::Cost replay(const book::OpeningBook& strategy, const feedback::FeedbackMatrixView& fMap, const Words& targets) {
+        solver::Cost played{};
+        for (auto solutionIndex : targets) {
+            book::Cursor cursor{&strategy};
+            uint32_t guesses = 1;
+            for (const auto* node = cursor.current(); node->guess != solutionIndex; ++guesses) {
+                cursor.advance(node->guess, fMap[solutionIndex][node->guess]);
+                node = cursor.current();
+                REQUIRE(node != nullptr);
+            }
+            played.totalGuesses += guesses;
+            played.worstCase = std::max(played.worstCase, guesses);
+        }
+        return played;
+    }
+}
+
+TEST_CASE("Solver: bounds and costs", "[solver]") {
+    REQUIRE(solver::lowerBound(0) == solver::Cost{0, 0});
+    REQUIRE(solver::lowerBound(1) == solver::Cost{1, 1});
+    REQUIRE(solver::lowerBound(2) == solver::Cost{3, 2});
+    REQUIRE(solver::lowerBound(feedback::NUM_FEEDBACKS) == solver::Cost{1 + 2 * (feedback::NUM_FEEDBACKS - 1), 2});
+    REQUIRE(solver::lowerBound(feedback::NUM_FEEDBACKS + 1) == solver::Cost{1 + 2 * (feedback::NUM_FEEDBACKS - 1) + 3, 3});
+
+    REQUIRE(solver::better({10, 4}, {11, 3}));
+    REQUIRE(solver::better({10, 3}, {10, 4}));
+    REQUIRE_FALSE(solver::better({10, 3}, {10, 3}));
+
+    REQUIRE(solver::Options::forMode(book::Mode::EASY).objective == solver::Objective::EXPECTED);
+    REQUIRE(solver::Options::forMode(book::Mode::HARD).objective == solver::Objective::WORST_CASE);
+    REQUIRE(solver::SOLVED == feedback::encodeFeedbackString("XXXXX"));
+}
+
+TEST_CASE("Solver: searching every guess finds the brute-force optimum", "[solver][slow]") {
+    const auto context = engine::Context::shared();
+    const solver::Options everyGuess{solver::Objective::EXPECTED, solver::ALL_CANDIDATES};
+
+    SECTION("Hard mode") {
+        solver::Solver<true> exact{context, everyGuess, 1};
+        for (auto [min, max] : {std::pair{4ul, 6ul}, std::pair{7ul, 9ul}}) {
+            const auto [targets, fillers] = stateAfter(*context, "slate", min, max);
+            const auto expected = bruteForce<true>(context->view(), targets, fillers, solver::UNLIMITED);
+            REQUIRE(exact.solve(targets, fillers).cost == *expected);
+
+            // Budgets are exact too, including the ones nothing fits in
+            for (uint32_t budget : {2u, 3u}) {
+                const auto bounded = bruteForce<true>(context->view(), targets, fillers, budget);
+                const auto entry = exact.solveWithin(targets, fillers, budget);
+                REQUIRE(entry.isSolved() == bounded.has_value());
+                if (bounded) REQUIRE(entry.cost == *bounded);
+            }
+        }
+    }
+
+    SECTION("Easy mode") {
+        solver::Solver<false> exact{context, everyGuess, 1};
+        const auto [targets, fillers] = stateAfter(*context, "slate", 3, 4);
+        const auto expected = bruteForce<false>(context->view(), targets, {}, solver::UNLIMITED);
+        REQUIRE(exact.solve(targets).cost == *expected);
+    }
+}
+
+TEST_CASE("Solver: strategies play exactly as solved", "[solver][slow]") {
+    const auto context = engine::Context::shared();
+
+    SECTION("Hard mode, worst case first") {
+        const auto [targets, fillers] = stateAfter(*context, "crane", 60, 150);
+        solver::Solver<true> worstCase{context, solver::Options::forMode(book::Mode::HARD), 2};
+        solver::Solver<true> expected{context, {solver::Objective::EXPECTED, solver::DEFAULT_CANDIDATE_LIMIT}, 2};
+
+        const auto entry = worstCase.solve(targets, fillers);
+        REQUIRE(replay(worstCase.strategy(targets, fillers), context->view(), targets) == entry.cost);
+
+        // Each objective wins on its own terms
+        const auto other = expected.solve(targets, fillers);
+        REQUIRE(replay(expected.strategy(targets, fillers), context->view(), targets) == other.cost);
+        REQUIRE(entry.cost.worstCase <= other.cost.worstCase);
+        REQUIRE(other.cost.totalGuesses <= entry.cost.totalGuesses);
+    }
+
+    SECTION("Easy mode") {
+        const auto [targets, fillers] = stateAfter(*context, "crane", 60, 150);
+        solver::Solver<false> exact{context, solver::Options::forMode(book::Mode::EASY), 2};
+        const auto entry = exact.solve(targets);
+        const auto strategy = exact.strategy(targets);
+        REQUIRE(strategy.beamCandidates() == book::SOLVER_BEAM);
+        REQUIRE(strategy.mode() == book::Mode::EASY);
+        REQUIRE(replay(strategy, context->view(), targets) == entry.cost);
+    }
+}
+
+TEST_CASE("Solver: results don't depend on threads or a persisted memo", "[solver][slow]") {
+    const auto context = engine::Context::shared();
+    const auto [targets, fillers] = stateAfter(*context, "crane", 60, 150);
+    const auto options = solver::Options::forMode(book::Mode::HARD);
+    const std::string path = "test_solver_memo.bin";
+
+    solver::Solver<true> serial{context, options, 1};
+    solver::Solver<true> parallel{context, options, 4};
+    const auto entry = serial.solve(targets, fillers);
+    const auto other = parallel.solve(targets, fillers);
+    REQUIRE(other.cost == entry.cost);
+    REQUIRE(other.guess == entry.guess);
+
+    REQUIRE(serial.save(path));
+    solver::Solver<true> restored{context, options, 1};
+    REQUIRE(restored.load(path));
+    REQUIRE(restored.memoSize() == serial.memoSize());
+
+    // Everything the strategy needs was persisted, so nothing is searched again
+    const auto reloaded = restored.solve(targets, fillers);
+    REQUIRE(reloaded.cost == entry.cost);
+    REQUIRE(reloaded.guess == entry.guess);
+    REQUIRE(replay(restored.strategy(targets, fillers), context->view(), targets) == entry.cost);
+    REQUIRE(restored.getStats().states == 0);
+
+    // Memos only load into solvers of the configuration that wrote them
+    solver::Solver<true> otherLimit{context, {options.objective, options.candidateLimit + 1}, 1};
+    REQUIRE_FALSE(otherLimit.load(path));
+    solver::Solver<false> otherMode{context, {options.objective, options.candidateLimit}, 1};
+    REQUIRE_FALSE(otherMode.load(path));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include "../src/fingerprint.hpp"
+#include "../src/suggestionCache.hpp"
+
+using namespace wordle;
+
+TEST_CASE("Fingerprint: equal sets share a fingerprint regardless of history", "[cache][fingerprint]") {
+    std::vector<size_t> words(config::NUM_WORDS);
+    std::iota(words.begin(), words.end(), 0);
+    REQUIRE(fingerprint::of(words.begin(), words.end()) == fingerprint::ALL_WORDS);
+    REQUIRE(fingerprint::of(words.begin(), words.begin() + config::NUM_TARGETS) == fingerprint::ALL_TARGETS);
+
+    // Remove the same words in two different orders, one XOR at a time
+    std::vector<size_t> removed(words.begin() + 100, words.begin() + 600);
+    fingerprint::Fingerprint first = fingerprint::ALL_WORDS;
+    fingerprint::Fingerprint second = fingerprint::ALL_WORDS;
+    for (size_t word : removed) first ^= fingerprint::KEYS[word];
+    std::shuffle(removed.begin(), removed.end(), std::mt19937{3});
+    for (size_t word : removed) second ^= fingerprint::KEYS[word];
+
+    words.erase(words.begin() + 100, words.begin() + 600);
+    REQUIRE(first == second);
+    REQUIRE(first == fingerprint::of(words.begin(), words.end()));
+    REQUIRE(fingerprint::salted(first, 1) != fingerprint::salted(first, 2));
+}
+
+TEST_CASE("Suggestion Cache: LRU eviction and counters", "[cache]") {
+    cache::SuggestionCache suggestionCache{2};
+
+    REQUIRE_FALSE(suggestionCache.find(1, 10).has_value());
+    suggestionCache.insert(1, {1.5, 7, 10});
+    suggestionCache.insert(2, {2.5, 8, 10});
+
+    auto hit = suggestionCache.find(1, 10);
+    REQUIRE(hit.has_value());
+    REQUIRE(hit->guessIndex == 7);
+    REQUIRE(hit->entropy == 1.5);
+
+    // Mismatched alive count is treated as a collision
+    REQUIRE_FALSE(suggestionCache.find(1, 11).has_value());
+
+    // Key 2 is now least recently used
+    suggestionCache.insert(3, {3.5, 9, 10});
+    REQUIRE(suggestionCache.size() == 2);
+    REQUIRE_FALSE(suggestionCache.find(2, 10).has_value());
+    REQUIRE(suggestionCache.find(1, 10).has_value());
+    REQUIRE(suggestionCache.find(3, 10).has_value());
+
+    REQUIRE(suggestionCache.hits() == 3);
+    REQUIRE(suggestionCache.misses() == 3);
+
+    suggestionCache.clear();
+    REQUIRE(suggestionCache.size() == 0);
+    REQUIRE(suggestionCache.hits() == 0);
+}
+
+TEST_CASE("Suggestion Cache: concurrent use stays bounded", "[cache]") {
+    cache::SuggestionCache suggestionCache{64};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&suggestionCache, t] {
+            for (uint32_t i = 0; i < 1000; ++i) {
+                const fingerprint::Fingerprint key = (t * 1000 + i) % 100;
+                if (!suggestionCache.find(key, 1)) suggestionCache.insert(key, {0.0, i, 1});
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(suggestionCache.size() <= suggestionCache.maxSize());
+    REQUIRE(suggestionCache.hits() + suggestionCache.misses() == 4000);
+}
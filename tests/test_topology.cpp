@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <pthread.h>
+
+#include "../src/engineContext.hpp"
+#include "../src/hardBot.hpp"
+#include "../src/topology.hpp"
+
+using namespace wordle;
+
+TEST_CASE("Topology: kernel CPU lists", "[topology]") {
+    REQUIRE(topology::parseCpuList("0-3,8,10-11\n") == topology::CpuSet{0, 1, 2, 3, 8, 10, 11});
+    REQUIRE(topology::parseCpuList("5") == topology::CpuSet{5});
+    REQUIRE(topology::parseCpuList("4,1-2,2") == topology::CpuSet{1, 2, 4});
+    REQUIRE(topology::parseCpuList("").empty());
+    REQUIRE(topology::parseCpuList("3-1").empty());
+    REQUIRE(topology::parseCpuList("a-b").empty());
+}
+
+TEST_CASE("Topology: nodes from sysfs keep only allowed CPUs", "[topology]") {
+    const auto root = std::filesystem::temp_directory_path() / "wordle_test_topology";
+    std::filesystem::remove_all(root);
+    for (const auto& [name, cpus] : {std::pair{"node1", "4-7"}, {"node0", "0-3"}, {"node2", "8-9"}}) {
+        std::filesystem::create_directories(root / name);
+        std::ofstream{root / name / "cpulist"} << cpus << '\n';
+    }
+    std::filesystem::create_directories(root / "power");
+
+    const auto topology = topology::Topology::fromSysfs(root.string(), {1, 2, 5, 6, 7});
+    std::filesystem::remove_all(root);
+
+    // node2 has no allowed CPU left
+    REQUIRE(topology.numNodes() == 2);
+    REQUIRE(topology.numCpus() == 5);
+    REQUIRE(topology.node(0).id == 0);
+    REQUIRE(topology.node(0).cpus == topology::CpuSet{1, 2});
+    REQUIRE(topology.node(1).cpus == topology::CpuSet{5, 6, 7});
+    REQUIRE(topology.nodeOfCpu(6) == 1);
+    REQUIRE_FALSE(topology.nodeOfCpu(0).has_value());
+    REQUIRE(topology.spread().size() == 2);
+}
+
+TEST_CASE("Topology: this machine", "[topology]") {
+    const auto& system = topology::Topology::system();
+    REQUIRE(system.numNodes() >= 1);
+    REQUIRE(system.numCpus() == topology::hardwareConcurrency());
+
+#ifdef __linux__
+    REQUIRE(topology::currentNode().has_value());
+
+    // Pinning to an allowed CPU works, an empty set is refused
+    std::thread worker([&] {
+        REQUIRE(topology::pinThread(::pthread_self(), {system.node(0).cpus.front()}));
+        REQUIRE(topology::currentCpu() == system.node(0).cpus.front());
+        REQUIRE(topology::currentNode() == 0);
+        REQUIRE_FALSE(topology::pinThread(::pthread_self(), {}));
+    });
+    worker.join();
+
+    parallel::ThreadPool pool{2};
+    REQUIRE(pool.pin(system.spread()));
+#else
+    // One node of every CPU, without affinity
+    REQUIRE(system.numNodes() == 1);
+    REQUIRE_FALSE(topology::currentCpu().has_value());
+    REQUIRE_FALSE(topology::pinThread(::pthread_self(), {system.node(0).cpus.front()}));
+#endif
+}
+
+TEST_CASE("Topology: bots placed on a node read the same feedbacks", "[topology]") {
+    const auto context = engine::Context::shared();
+    const auto& system = topology::Topology::system();
+    REQUIRE_THROWS_AS(context->view(system.numNodes()), std::invalid_argument);
+
+    for (size_t node = 0; node < system.numNodes(); ++node) {
+        const auto& local = context->view(node);
+        if (system.numNodes() == 1) REQUIRE(&local == &context->view());
+        for (size_t i = 0; i < config::NUM_WORDS; i += 101) REQUIRE(local[i][i % config::NUM_TARGETS] == context->view()[i][i % config::NUM_TARGETS]);
+    }
+    REQUIRE(context->numReplicas() == (system.numNodes() > 1 ? system.numNodes() : 0));
+
+    bot::HardBot placed{context, 1, 4};
+    bot::HardBot unplaced{context, 1, 4};
+    placed.placeOnNode(0);
+    REQUIRE(placed.suggest().guessIndex == unplaced.suggest().guessIndex);
+}
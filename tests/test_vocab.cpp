@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
 #include "../src/util.hpp"
 #include "../src/vocab.hpp"
 
@@ -26,4 +30,42 @@ TEST_CASE("Vocab: validate constructVocab() output", "[vocab]") {
     REQUIRE(vocab.size() == (targets.size() + fillers.size()));
     REQUIRE(std::equal(targets.begin(), targets.end(), vocab.begin()));
     REQUIRE(std::equal(fillers.begin(), fillers.end(), vocab.begin() + wordle::config::NUM_TARGETS));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Vocab: words are stored back to back", "[vocab]") {
+    const wordle::vocab::Vocab vocab{"crane", "slate", "speed"};
+    REQUIRE(vocab.size() == 3);
+    REQUIRE(vocab[1] == "slate");
+    REQUIRE(vocab[1].data() == vocab[0].data() + wordle::config::WORD_LENGTH);
+    REQUIRE(std::string_view{vocab.letters().data(), vocab.letters().size()} == "craneslatespeed");
+    REQUIRE(wordle::vocab::Vocab::fromLetters(vocab.letters()) == vocab);
+    REQUIRE(std::find(vocab.begin(), vocab.end(), "speed") - vocab.begin() == 2);
+    REQUIRE_THROWS_AS(wordle::vocab::Vocab({"crane", "slates"}), std::invalid_argument);
+}
+
+TEST_CASE("Vocab: processFile() trims, lowercases and rejects malformed words", "[vocab]") {
+    constexpr auto path = "test_vocab.csv";
+    auto write = [path](std::string_view contents) {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file << contents;
+    };
+
+    SECTION("Whitespace, blank lines, CRLF and no final newline") {
+        write("  CRANE\r\n\n\tSlAtE \r\n   \nspeed");
+        const auto words = wordle::vocab::__impl::processFile(path, 3);
+        REQUIRE(words == wordle::vocab::Vocab{"crane", "slate", "speed"});
+    }
+
+    SECTION("Empty file") {
+        write("");
+        REQUIRE(wordle::vocab::__impl::processFile(path, 0).empty());
+    }
+
+    SECTION("Wrong length") {
+        write("crane\nslates\n");
+        REQUIRE_THROWS_AS(wordle::vocab::__impl::processFile(path, 2), std::runtime_error);
+    }
+
+    std::remove(path);
+    REQUIRE_THROWS_AS(wordle::vocab::__impl::processFile(path, 0), std::runtime_error);
+}
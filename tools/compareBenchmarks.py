@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+Compares two Google Benchmark JSON exports (--benchmark_out=<file> --benchmark_out_format=json).
+
+Prints every benchmark found in both files with its change in real time, then the geometric mean change per label
+(the game phase of the bot benchmarks). Runs with repetitions are compared by their medians.
+Exits with status 1 when any benchmark slowed down by more than the threshold.
+
+Usage: compareBenchmarks.py <baseline.json> <contender.json> [--threshold PERCENT] [--filter REGEX]
+"""
+import argparse
+import json
+import math
+import re
+import statistics
+import sys
+from collections import defaultdict
+
+TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    """Maps each benchmark name to (real time in ns, label)."""
+    with open(path) as file:
+        runs = json.load(file)["benchmarks"]
+
+    medians = {run["run_name"]: run for run in runs if run.get("aggregate_name") == "median"}
+    times = defaultdict(list)
+    labels = {}
+    for run in runs:
+        name = run.get("run_name", run["name"])
+        if name in medians and run is not medians[name]:
+            continue
+        if run.get("run_type") == "aggregate" and run.get("aggregate_name") != "median":
+            continue
+        times[name].append(run["real_time"] * TO_NS[run.get("time_unit", "ns")])
+        labels[name] = run.get("label", "")
+    return {name: (statistics.median(values), labels[name]) for name, values in times.items()}
+
+
+def format_time(ns):
+    for unit in ("s", "ms", "us"):
+        if ns >= TO_NS[unit]:
+            return f"{ns / TO_NS[unit]:.3f} {unit}"
+    return f"{ns:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two Google Benchmark JSON exports")
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=5.0, help="slowdown in percent counted as a regression")
+    parser.add_argument("--filter", default="", help="only compare benchmarks whose name matches this regex")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+    pattern = re.compile(args.filter)
+    names = [name for name in baseline if name in contender and pattern.search(name)]
+    if not names:
+        print("No benchmarks in common")
+        return 1
+
+    width = max(len(name) for name in names)
+    print(f"{'Benchmark':<{width}}  {'Label':<8}  {'Baseline':>12}  {'Contender':>12}  {'Change':>8}")
+    regressions = 0
+    ratios = defaultdict(list)
+    for name in names:
+        (before, label), (after, _) = baseline[name], contender[name]
+        ratio = after / before if before > 0 else 1.0
+        ratios[label or "-"].append(ratio)
+        change = (ratio - 1.0) * 100.0
+        is_regression = change > args.threshold
+        regressions += is_regression
+        flag = "  REGRESSION" if is_regression else ""
+        print(f"{name:<{width}}  {label:<8}  {format_time(before):>12}  {format_time(after):>12}  {change:>+7.1f}%{flag}")
+
+    print("\nGeometric mean change by label:")
+    for label, values in sorted(ratios.items()):
+        mean = math.exp(sum(math.log(value) for value in values) / len(values))
+        print(f"  {label:<8}  {(mean - 1.0) * 100.0:>+7.1f}%  ({len(values)} benchmarks)")
+
+    missing = sorted(set(baseline) ^ set(contender))
+    if missing:
+        print(f"\n{len(missing)} benchmarks appear in only one file")
+    print(f"\n{regressions} regressions above {args.threshold}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,43 @@
+#include <fstream>
+#include <iostream>
+
+#include "../src/feedback.hpp"
+#include "../src/feedbackCache.hpp"
+#include "../src/parallelTaskQueue.hpp"
+#include "../src/vocab.hpp"
+
+/*
+Build-time generator for the WORDLE_EMBED_MATRIX option (see embeddedMatrix.hpp).
+Reads the word lists from the working directory and writes the packed vocab and the feedback cache image.
+
+Usage: wordle_embed_gen <vocab output> <matrix output>
+*/
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <vocab output> <matrix output>" << std::endl;
+        return 1;
+    }
+
+    // Step 1: Write the packed vocab, which must have exactly the configured size
+    const auto vocab = wordle::vocab::constructVocab();
+    if (vocab.size() != wordle::config::NUM_WORDS) {
+        std::cerr << "word lists don't match config.hpp (" << vocab.size() << " words)" << std::endl;
+        return 1;
+    }
+
+    std::ofstream vocabFile{argv[1], std::ios::binary | std::ios::trunc};
+    vocabFile.write(vocab.letters().data(), static_cast<std::streamsize>(vocab.letters().size()));
+    if (!vocabFile.flush()) {
+        std::cerr << "failed to write " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Step 2: Build the matrix exactly as a cold start would, in cache file format
+    wordle::parallel::TaskQueue queue{wordle::config::HARDWARE_CONCURRENCY};
+    const auto flatMap = wordle::feedback::constructFlatFeedbackMap(vocab, queue, wordle::config::HARDWARE_CONCURRENCY);
+    if (!wordle::feedback::cache::writeFeedbackCache(argv[2], vocab, flatMap)) {
+        std::cerr << "failed to write " << argv[2] << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../src/engineContext.hpp"
+#include "../src/feedback.hpp"
+#include "../src/guard.hpp"
+
+/*
+Load generator for "wordle_bot serve <socket>" (see server.hpp).
+
+Opens many sessions on one connection and plays a game in each, every target chosen as a solution in turn. Rounds
+send one request per unfinished game (a suggest, then a filter with the feedback the solution gives), at most
+WINDOW requests in flight at a time. Reports throughput and the latencies the server measured.
+
+Usage: wordle_loadgen <socket> [sessions] [hard|easy]
+*/
+namespace {
+    constexpr size_t WINDOW = 256;        // Requests written before their responses are read
+    constexpr size_t MAX_GUESSES = 100;   // Games still unsolved after this many guesses are abandoned
+
+    class Connection {
+        int fd = -1;
+        std::string buffer;
+
+    public:
+        explicit Connection(const std::string& path) {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            wordle::guard::runtimeGuard(path.size() < sizeof(address.sun_path), "socket path {} is too long", path);
+            std::memcpy(address.sun_path, path.data(), path.size());
+
+            fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            const bool isConnected = fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+            wordle::guard::runtimeGuard(isConnected, "failed to connect to {}", path);
+        }
+
+        ~Connection() { if (fd >= 0) ::close(fd); }
+
+        void send(std::string_view bytes) {
+            while (!bytes.empty()) {
+                const ssize_t written = ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+                if (written < 0 && errno == EINTR) continue;
+                wordle::guard::runtimeGuard(written > 0, "connection closed while sending");
+                bytes.remove_prefix(static_cast<size_t>(written));
+            }
+        }
+
+        std::string readLine() {
+            size_t newline;
+            while ((newline = buffer.find('\n')) == std::string::npos) {
+                char chunk[1 << 16];
+                const ssize_t n = ::read(fd, chunk, sizeof(chunk));
+                if (n < 0 && errno == EINTR) continue;
+                wordle::guard::runtimeGuard(n > 0, "connection closed while reading");
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            return line;
+        }
+
+        // Sends requests WINDOW at a time and returns the responses in order
+        std::vector<std::string> exchange(const std::vector<std::string>& requests) {
+            std::vector<std::string> responses;
+            responses.reserve(requests.size());
+            for (size_t first = 0; first < requests.size(); first += WINDOW) {
+                const size_t last = std::min(requests.size(), first + WINDOW);
+                std::string batch;
+                for (size_t i = first; i < last; ++i) batch += requests[i] + '\n';
+                send(batch);
+                for (size_t i = first; i < last; ++i) responses.push_back(readLine());
+            }
+            return responses;
+        }
+    };
+
+    struct Game {
+        std::string session;
+        size_t solutionIndex;
+        size_t guesses = 0;
+        bool isOver = false;
+    };
+
+    std::vector<std::string_view> split(std::string_view line) {
+        std::vector<std::string_view> tokens;
+        for (size_t start = 0; start < line.size();) {
+            const size_t stop = std::min(line.find(' ', start), line.size());
+            if (stop > start) tokens.push_back(line.substr(start, stop - start));
+            start = stop + 1;
+        }
+        return tokens;
+    }
+
+    // Latency the server reported at the end of response
+    uint64_t serverMicros(std::string_view response) {
+        const size_t at = response.rfind(" us=");
+        uint64_t micros = 0;
+        if (at != std::string_view::npos) std::from_chars(response.data() + at + 4, response.data() + response.size(), micros);
+        return micros;
+    }
+
+    uint64_t percentile(std::vector<uint64_t>& values, double p) {
+        if (values.empty()) return 0;
+        const size_t rank = std::min(values.size() - 1, static_cast<size_t>(p / 100.0 * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "usage: " << argv[0] << " <socket> [sessions] [hard|easy]" << std::endl;
+        return 1;
+    }
+    const size_t numSessions = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    const std::string mode = argc == 4 ? argv[3] : "hard";
+    if (numSessions == 0 || (mode != "hard" && mode != "easy")) {
+        std::cerr << "Argument error: sessions must be positive and mode \"hard\" or \"easy\"" << std::endl;
+        return 1;
+    }
+
+    // Feedbacks are computed locally, as fMap[solution][guess] like the games in simulation.hpp
+    const auto context = wordle::engine::Context::shared();
+    const auto& vocab = context->vocab();
+    const auto& fMap = context->view();
+    std::unordered_map<std::string_view, size_t> wordIndices;
+    for (size_t i = 0; i < vocab.size(); ++i) wordIndices.emplace(vocab[i], i);
+
+    Connection connection{argv[1]};
+    std::vector<uint64_t> micros;
+    size_t errors = 0;
+    auto record = [&](const std::string& response) {
+        micros.push_back(serverMicros(response));
+        errors += response.starts_with("err");
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Step 1: Open the sessions, spreading the solutions over the targets
+    std::vector<Game> games(numSessions);
+    const auto opened = connection.exchange(std::vector<std::string>(numSessions, "new " + mode));
+    for (size_t i = 0; i < numSessions; ++i) {
+        record(opened[i]);
+        const auto tokens = split(opened[i]);
+        wordle::guard::runtimeGuard(tokens.size() >= 2 && tokens[0] == "ok", "failed to open a session: {}", opened[i]);
+        games[i] = {std::string{tokens[1]}, (i * 7919) % wordle::config::NUM_TARGETS};
+    }
+
+    // Step 2: Play every game to the end, one guess per round
+    size_t rounds = 0;
+    for (std::vector<Game*> playing; ; ++rounds) {
+        playing.clear();
+        for (auto& game : games) if (!game.isOver) playing.push_back(&game);
+        if (playing.empty()) break;
+
+        std::vector<std::string> requests;
+        for (const Game* game : playing) requests.push_back("suggest " + game->session);
+        const auto suggestions = connection.exchange(requests);
+
+        requests.clear();
+        for (size_t i = 0; i < playing.size(); ++i) {
+            record(suggestions[i]);
+            Game& game = *playing[i];
+            const auto tokens = split(suggestions[i]);
+            const auto it = tokens.size() >= 2 && tokens[0] == "ok" ? wordIndices.find(tokens[1]) : wordIndices.end();
+            ++game.guesses;
+            if (it == wordIndices.end() || it->second == game.solutionIndex || game.guesses >= MAX_GUESSES) {
+                game.isOver = true;
+                continue;
+            }
+            const auto fbString = wordle::feedback::decodeFeedbackString(fMap[game.solutionIndex][it->second]);
+            requests.push_back(std::format("filter {} {} {}", game.session, tokens[1], fbString));
+        }
+        for (const auto& response : connection.exchange(requests)) record(response);
+    }
+
+    // Step 3: Close the sessions
+    std::vector<std::string> closes;
+    for (const auto& game : games) closes.push_back("close " + game.session);
+    for (const auto& response : connection.exchange(closes)) record(response);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const size_t totalGuesses = std::accumulate(games.begin(), games.end(), size_t{0}, [](size_t sum, const Game& game) { return sum + game.guesses; });
+    const size_t gamesWon = std::count_if(games.begin(), games.end(), [](const Game& game) { return game.guesses <= 6; });
+
+    std::cout << "Sessions: " << numSessions << " (" << mode << "), " << rounds << " rounds\n";
+    std::cout << "Mean guesses: " << static_cast<double>(totalGuesses) / static_cast<double>(numSessions) << ", games lost: " << numSessions - gamesWon << "\n";
+    std::cout << "Requests: " << micros.size() << " in " << seconds * 1000.0 << " ms (" << static_cast<double>(micros.size()) / seconds << " requests/s), " << errors << " errors\n";
+    std::cout << "Server latency: p50 " << percentile(micros, 50) << " us, p99 " << percentile(micros, 99) << " us, max " << *std::max_element(micros.begin(), micros.end()) << " us\n";
+    return errors == 0 ? 0 : 1;
+}